@@ -46,9 +46,16 @@
 *
 *     - Parser Architecture:
 *         - Each recipe site has a dedicated parser function.
-*         - Node.js scripts are used for sites requiring Playwright or Cheerio.
+*         - Node.js scripts are used for sites requiring Playwright.
+*         - Static search pages are read in-process with a small CSS selector
+*           matcher over the Gumbo tree (no Node.js).
 *         - Fallback URLs are provided if parsing fails.
-*         - Temporary JS script files are generated and executed as needed.
+*         - Site scripts run inside one persistent Node.js worker process
+*           that keeps a warm Playwright Chromium between searches. Each
+*           script is registered with the worker once (no temporary .js
+*           files); a search only sends a short "run" message.
+*         - C-side HTTP requests share one curl multi engine that reuses
+*           connections, DNS results and TLS sessions (HTTP/2 when offered).
 *
 *     - Memory Safety and Cleanup:
 *         - Careful allocation and freeing of buffers, JSON objects, and GTK
@@ -103,15 +110,20 @@
 *
 * 3. The user selects a recipe site from a dropdown list of 20 food websites,
 *    then clicks the "Search for Recipes" button.
+*    The last dropdown entry, "All Sites", searches every website at once
+*    through a small pool of worker threads; each site's recipes are added
+*    to the list as soon as that site finishes.
 *
 * 4. The app constructs a URL query based on the search term.
 *
 *    - For JavaScript-heavy sites:
-*        • A temporary Node.js script file is generated and executed.
-*        • The script uses Playwright and Cheerio to scrape structured data.
+*        • The site's embedded script is sent to the persistent Node.js
+*          scraper worker (started once after the splash screen).
+*        • The script uses Playwright to scrape structured data.
 *    - For simpler (static HTML) sites:
 *        • The app downloads the HTML using libcurl.
-*        • The content is parsed using the Gumbo HTML5 parser.
+*        • Link-only parsers scan the page for <a> tags while it streams
+*          in; other content is parsed using the Gumbo HTML5 parser.
 *
 * 5. Search results are displayed as a clickable list of GTK widgets.
 *
@@ -239,7 +251,7 @@
 *         After installation, the C compiler will be available as 'gcc-13'.
 *
 *     - Install global npm packages and browsers:
-*         npm install -g playwright cheerio axios
+*         npm install -g playwright
 *         npx playwright install
 *
 *     - macOS Compile command:
@@ -320,8 +332,8 @@
 *           to a particular recipe website source.
 *         - Function pointers are used to select the appropriate parser based
 *           on the chosen website, ensuring flexibility and easy extensibility.
-*         - For sites requiring JavaScript rendering, Node.js scripts are
-*           dynamically generated and executed.
+*         - For sites requiring JavaScript rendering, embedded Node.js
+*           scripts are executed in memory by the scraper worker.
 *         - Fallback logic ensures resilience by returning a default link if
 *           recipe parsing fails.
 *
@@ -405,12 +417,13 @@
 *     - Automated file paths may require updates.
 *     - Important Note on Antivirus Alerts:
 *         Some antivirus programs may flag components of this project due to
-*         heuristic detection of dynamically generated scripts or network
+*         heuristic detection of dynamically loaded scripts or network
 *         activity.
-*         Specifically, the app generates temporary Node.js scripts at runtime
-*         for certain recipe parsers. This behavior may be detected as a false-
-*         positive threat to some antivirus engines, even though the scripts are
-*         safe and created locally based on your input.
+*         Specifically, the app runs a background Node.js worker process that
+*         executes embedded scraper scripts for certain recipe parsers (in
+*         memory; no script files are written to disk). This
+*         behavior may be detected as a false-positive threat to some antivirus
+*         engines, even though the scripts are safe and shipped with the app.
 *         Recommended Actions:
 *             - Review the source code to verify safety, and always compile
 *               the app yourself from source to ensure safety.
@@ -428,7 +441,6 @@
 *     - Implement a single search operation that aggregates recipe results
 *       from all 20 parsers.
 *       Add even more food websites to the current list of 20 recipe parsers.
-*     - Use in-memory Node.js execution to avoid temporary files.
 *     - Enhanced error logging and reporting.
 *     - Improve recipe parser maintainability by automating failure detection
 *       and streamlining parser updates.
@@ -486,6 +498,7 @@
 // Third-Party Libraries:
 #include <gtk/gtk.h>           // GTK top-level toolkit (GUI, widgets, windows)
 #include <glib.h>              // GTK core utilities (data structures, memory)
+#include <glib/gstdio.h>       // UTF-8 safe file helpers (g_remove)
 #include <gdk/gdk.h>           // Drawing/cursor layer (graphics backend)
 #include <curl/curl.h>         // libcurl networking
 #include <gumbo.h>             // Gumbo HTML parser
@@ -510,15 +523,20 @@
 // Global Variables
 // ===========================================================================
 
-// Limits the number of returned recipe-link results
-#define MAX_RESULTS 50
+// Soft limit on the recipe links gathered from one site; the limit actually
+// used is also capped by the result memory budget (result_limit_for_memory).
+// Gathered links are ranking candidates: the list shows only the best
+// RESULT_TOP_K of them (see ResultRanker).
+#define MAX_RESULTS 250
 
-// Counter to control maximum number of recipe links created
-static int recipe_result_total = 0;
+// Soft limit on the combined recipe-link results of an "All Sites" search
+#define MAX_ALL_SITES_RESULTS (MAX_RESULTS * 8)
 
-// Holds the current recipe site being searched
-// Used in curl_write_callback terminal status messages
-char *g_current_website_name = NULL;
+// Memory budget of the links one search gathers (its ranking candidates)
+#define RESULT_MEMORY_BUDGET_BYTES    (8 * 1024 * 1024)  // At most 8 MB of results
+#define RESULT_MEMORY_FREE_RAM_SHARE  64                 // ... and at most 1/64 of free RAM
+#define RESULT_ESTIMATED_BYTES        512                // Typical cost of one result
+#define RESULT_MIN_LIMIT              50                 // Never cap a search below this
 
 // Active-search switch
 static gboolean search_in_progress = FALSE;
@@ -543,10 +561,89 @@ typedef enum {
 } QuoteStatus;
 
 
+// ----------------------------------------------------------------------------
+// SiteFetchMode
+// Capability descriptor for each recipe site parser.
+// Tells search_thread_func() whether the parser actually walks the Gumbo DOM
+// of the search page, or whether it fetches its own data (Node.js/Playwright,
+// its own libcurl request) or only ever adds a static fallback link.
+// Only SITE_NEEDS_PREFETCHED_DOM parsers cost a download_html() + gumbo_parse().
+// SITE_JSON_ENDPOINT sites have no parsing code of their own: their search
+// API is fetched and projected natively from the site's JsonEndpoint.
+typedef enum {
+    SITE_NEEDS_PREFETCHED_DOM,  // Parser walks the prefetched search page DOM
+    SITE_FETCHES_ITSELF,        // Parser downloads/scrapes on its own (root unused)
+    SITE_STATIC_FALLBACK_ONLY,  // Parser only adds a fixed link (no network needed)
+    SITE_JSON_ENDPOINT          // JSON search API read in C; parser only adds a fallback
+} SiteFetchMode;
+
+
+// ----------------------------------------------------------------------------
+// FetchTier
+// Escalation tiers of a site with a SiteEscalation, cheapest first (see
+// run_site_escalation). Each site remembers the tier that last produced
+// links, so searches only reach the browser when the page tiers fail.
+typedef enum {
+    FETCH_TIER_STATIC,    // Search page via libcurl + Gumbo, CSS selector
+    FETCH_TIER_EMBEDDED,  // Same page, JSON-LD or Next.js __NEXT_DATA__ results
+    FETCH_TIER_BROWSER,   // The site's Playwright script in the scraper worker
+    FETCH_TIER_COUNT
+} FetchTier;
+
+
+// ----------------------------------------------------------------------------
+// SiteTaskState
+// Lifecycle of one site's search inside an "All Sites" search.
+// A site that overruns its time budget is marked SITE_TASK_TIMED_OUT by the
+// coordinating search thread; whatever it returns afterwards is discarded.
+typedef enum {
+    SITE_TASK_QUEUED,     // Waiting for a free worker-pool thread
+    SITE_TASK_RUNNING,    // Parser is running on a pool thread
+    SITE_TASK_DONE,       // Parser finished; results were sent to the UI
+    SITE_TASK_TIMED_OUT   // Parser overran its budget and was abandoned
+} SiteTaskState;
+
+
+// ----------------------------------------------------------------------------
+// ResultCacheState
+// Outcome of a lookup in the on-disk search result cache.
+// Stale entries are still shown right away, while a background refresh
+// re-runs the site parser and rewrites the entry (stale-while-revalidate).
+typedef enum {
+    RESULT_CACHE_MISS,    // No usable entry; run the site parser
+    RESULT_CACHE_FRESH,   // Entry younger than RESULT_CACHE_TTL_SECONDS
+    RESULT_CACHE_STALE    // Older than the TTL but within RESULT_CACHE_MAX_STALE_SECONDS
+} ResultCacheState;
+
+
+// ----------------------------------------------------------------------------
+// AnchorScanState
+// Tokenizer state of the streaming anchor scanner (see anchor_scanner_feed).
+typedef enum {
+    SCAN_TEXT,      // Character data between tags
+    SCAN_TAG,       // Inside "<...>" (start tag, end tag or declaration)
+    SCAN_COMMENT,   // Inside "<!-- ... -->"
+    SCAN_RAWTEXT    // Inside script/style/textarea/title, until its end tag
+} AnchorScanState;
+
+
 // ===========================================================================
 // Typedef and Struct Definitions
 // ===========================================================================
 
+// Per-search state and cancellation token (defined below RecipeSiteInfo)
+typedef struct SearchContext SearchContext;
+
+// Producer/consumer channel carrying links to the UI (defined below SearchContext)
+typedef struct ResultChannel ResultChannel;
+
+// Per-search storage of result records (defined below TitleIndex)
+typedef struct StringArena StringArena;
+
+// Offset of a result record in a StringArena (0 = none)
+typedef guint32 ResultRef;
+
+
 // ---------------------------------------------------------------------------
 // AppWidgets
 // Holds references to GTK widgets that make up the primary UI.
@@ -560,22 +657,39 @@ typedef struct {
     GtkWidget *progress_bar;    // Shows search progress (pulse/fill)
     guint pulse_timer_id;       // Timer ID for progress bar pulsing
     QuoteStatus quote_status;   // Tracks search input quoting state
+    SearchContext *active_search; // Cancellation token of the running search (NULL when idle)
 } AppWidgets;
 
 
+// ---------------------------------------------------------------------------
+// SearchRequest
+// Everything a search thread needs, captured in the main thread when the
+// search starts, so the thread never reads GTK widgets and a newer search
+// cannot change the query underneath it.
+// ---------------------------------------------------------------------------
+typedef struct {
+    AppWidgets *w;              // Widget references (only used via g_idle_add)
+    SearchContext *search;      // Cancellation token of this search (owned ref)
+    char *query;                // Search term (copied from the entry)
+    int site_index;             // Combo box index (n_sites means "All Sites")
+    QuoteStatus quote_status;   // Quoting state of the search term
+} SearchRequest;
+
+
 // ---------------------------------------------------------------------------
 // SearchResultData
 // Bundles data passed between the search thread and the main thread.
-// Contains raw HTML, parsed results, and metadata about search success.
+// Contains parsed results and metadata about search success.
 // ---------------------------------------------------------------------------
 typedef struct {
     AppWidgets *w;        // Widget references
-    GList *results;       // List of RecipeInfo* structures representing matched recipes
+    GList *results;       // ResultRefs (GUINT_TO_POINTER) of the links found, in the search's arena
     char *status_message; // Human-readable status message (e.g., "No results")
     gboolean success;     // TRUE if search completed successfully and results were found
     char *url;            // Final search URL used
-    char *html;           // Raw HTML of the search results
-    GumboOutput *output;  // Parsed DOM output from Gumbo parser
+    char *query;          // Search term the results belong to
+    QuoteStatus quote_status; // Quoting state of that search term
+    SearchContext *search; // Cancellation token; superseded results are dropped
 } SearchResultData;
 
 
@@ -591,37 +705,170 @@ typedef struct {
     gboolean partial_match;  // TRUE if title partially matches the search
     int matched_tokens;  // Number of tokens (words) matched in the title
     int total_tokens;  // Total tokens found in the input recipe search term
+    int match_span;  // Bytes of title spanned by the matched tokens (proximity; 0 if none)
+    double score;  // Relevance computed by the ResultRanker (higher is better)
+    guint site_rank;  // Position of the link in its site's own results (0 = first)
+    guint sequence;  // Arrival order within the search (ranking tie-break)
 } RecipeInfo;
 
 
 // ---------------------------------------------------------------------------
-// InsertAnimationData
-// Manages insertion/removal animations for recipe listbox items.
+// TokenMatcher
+// The filtered tokens of a search, compiled once per search into an
+// Aho-Corasick automaton (a full DFA over the bytes that occur in the
+// tokens), so every recipe title is matched in one case-folding pass with
+// no allocation. Each token is compiled together with its singular form.
+// See token_matcher_new() for the matching rules.
+// ---------------------------------------------------------------------------
+typedef struct {
+    guint8 byte_class[256];     // Byte -> alphabet class (0 = byte in no token)
+    guint n_classes;            // Alphabet size (distinct token bytes + 1)
+    guint n_states;             // Automaton states (state 0 is the root)
+    gint *next;                 // Transitions, n_classes per state
+    gint *output;               // Token ending in each state, or -1
+    gint *dict_link;            // Nearest suffix state with an output, or -1
+    gint *depth;                // Length of the text spelled by each state
+    GPtrArray *tokens;          // Distinct filtered tokens, lowercase, in query order (owned)
+} TokenMatcher;
+
+// One token occurrence found by token_matcher_scan()
+typedef struct {
+    guint token;                // Index into TokenMatcher.tokens
+    guint offset;               // Byte offset of the occurrence in the text
+    guint length;               // Bytes matched (the token or its singular form)
+} TokenMatch;
+
+// Token matcher limits
+#define TOKEN_MATCHER_MAX_TOKENS  64   // Tokens beyond this are ignored (one bit each)
+
+
+// ---------------------------------------------------------------------------
+// RankedLink
+// One link queued on a ResultChannel: its record in the search's arena
+// plus the position its site listed it at, which the ranking uses.
+// Freed with g_free().
+// ---------------------------------------------------------------------------
+typedef struct {
+    guint site_rank;            // Position in its site's own results (0 = first)
+    ResultRef record;           // Title and URL in the search's StringArena
+} RankedLink;
+
+
+// ---------------------------------------------------------------------------
+// ResultRanker
+// Scores every result of one search (see result_ranker_score) and keeps
+// only the best RESULT_TOP_K in a bounded min-heap, so the list shows the
+// best results across all sites rather than the first ones to arrive.
+// Main thread only; owned by the search's ResultChannel.
 // ---------------------------------------------------------------------------
 typedef struct {
-    GtkListBox *listbox;       // Target listbox
-    GQueue *recipe_queue;      // Queue of RecipeInfo* to insert
-    GQueue *partial_buttons;   // Queue of listbox buttons for partial matches
+    TokenMatcher *matcher;      // Search tokens (NULL: nothing to match on)
+    GPtrArray *heap;            // Kept results, worst on top (RecipeResult, owned refs)
+    guint capacity;             // Results kept (RESULT_TOP_K)
+    guint sequence;             // Results scored so far
+    guint dropped;              // Results that ranked below the kept ones
+    GArray *hits;               // Scratch TokenMatch array reused for every title
+} ResultRanker;
+
+// Results kept (and shown) per search
+#define RESULT_TOP_K  50
+
+// Relevance score weights (see result_ranker_score)
+#define RANK_WEIGHT_COVERAGE    4.0   // Share of the search tokens found in the title
+#define RANK_WEIGHT_ADJACENCY   2.0   // Share of consecutive search tokens found side by side
+#define RANK_WEIGHT_CONCISENESS 1.0   // Share of the title's words that are search tokens
+#define RANK_WEIGHT_SITE        1.0   // Position in the source site's own ranking
+#define RANK_SITE_RANK_HALFLIFE 10.0  // Site position at which the site weight halves
+
+
+// ---------------------------------------------------------------------------
+// RecipeResult
+// One entry of the result store: a RecipeInfo wrapped in a GObject so it
+// can live in a GListStore (the GListModel behind the result view).
+// ---------------------------------------------------------------------------
+#define RECIPE_TYPE_RESULT (recipe_result_get_type())
+G_DECLARE_FINAL_TYPE(RecipeResult, recipe_result, RECIPE, RESULT, GObject)
 
-} InsertAnimationData;
+struct _RecipeResult {
+    GObject parent_instance;   // GObject base
+    RecipeInfo info;           // Title, URL and match details
+    StringArena *arena;        // Arena holding title and URL (NULL: strings owned)
+};
+
+
+// ---------------------------------------------------------------------------
+// ResultView
+// Recycled-row view of the result store. The listbox holds only as many
+// row buttons as fit in the visible part of the scrolled window (plus a
+// few rows of overscan); scrolling rebinds those buttons to other store
+// items, and two spacers stand in for the rows above and below, so the
+// scrollbar still reflects the full list. Attached to the listbox as
+// object data.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GtkListBox *listbox;        // Holds the recycled row buttons
+    GtkWidget *top_spacer;      // Stands in for the rows above the window
+    GtkWidget *bottom_spacer;   // Stands in for the rows below the window
+    GtkAdjustment *vadjustment; // Scroll position of the scrolled window
+    GListStore *store;          // All results of the current search (RecipeResult)
+    GPtrArray *rows;            // Recycled row buttons (GtkWidget*)
+    guint first;                // Store index shown by rows[0]
+    int row_height;             // Row height in pixels (measured once laid out)
+    guint tick_id;              // Pending frame-clock rebind (0 if none)
+} ResultView;
+
+// Result view geometry
+#define RESULT_VIEW_ROW_HEIGHT_ESTIMATE  40   // Row height used until a row is laid out
+#define RESULT_VIEW_OVERSCAN_ROWS        4    // Extra rows bound above and below the viewport
+#define RESULT_VIEW_MIN_ROWS             16   // Rows bound before the viewport has a size
 
 
 // ---------------------------------------------------------------------------
 // SiteParserFunc
 // Function type for parsing HTML pages from a recipe site.
 // Populates 'out' with extracted recipe results, and
-// uses 'link_set' to avoid duplicates, and uses 'search_term' for context.
+// uses 'search' (its canonical-URL link_set and result budget) to avoid duplicates and
+// stop at the result limit, and uses 'search_term' for context.
 
 
 // ---------------------------------------------------------------------------
 typedef void (*SiteParserFunc)(
     GumboNode *root,
     GList **out,
-    GHashTable *link_set,
+    SearchContext *search,
     const char *search_term
 );
 
 
+// ---------------------------------------------------------------------------
+// JsonEndpoint
+// A site search API that answers with JSON: where to send the query and
+// which members of the reply hold the result list and each result's title
+// and link (see run_json_endpoint). Used by SITE_JSON_ENDPOINT sites.
+// ---------------------------------------------------------------------------
+typedef struct {
+    const char *url_pattern;    // API URL with %s for the URL-encoded query
+    const char *results_key;    // Top-level member holding the results array
+    const char *title_key;      // Title member of each result
+    const char *url_key;        // Link member of each result
+    const char *base_url;       // Prefix for relative links ("" if absolute)
+} JsonEndpoint;
+
+
+// ---------------------------------------------------------------------------
+// SiteEscalation
+// The cheap tiers tried before a site's browser script: where its
+// server-rendered search page is and which links on it are results (see
+// run_site_escalation). Sites without one always run their parser.
+// ---------------------------------------------------------------------------
+typedef struct {
+    const char *search_url;     // Search page URL with %s for the URL-encoded query
+    const char *link_selector;  // CSS selector of the result links on that page
+    const char *base_url;       // Prefix for relative links
+    const char *url_match;      // Substring every result link must contain (NULL: any)
+} SiteEscalation;
+
+
 // ---------------------------------------------------------------------------
 // RecipeSiteInfo
 // Metadata for supported recipe sites (name, parser, URL pattern, etc.).
@@ -631,9 +878,146 @@ typedef struct {
     SiteParserFunc parse_site;  // Parser function for this site
     const char *url_pattern;    // Base URL with placeholder
     const char *query_param;    // Query parameter key (e.g., "q")
+    SiteFetchMode fetch_mode;   // Whether the parser needs the prefetched DOM
+    const JsonEndpoint *json_endpoint;  // Search API (SITE_JSON_ENDPOINT only, else NULL)
+    const SiteEscalation *escalation;   // Page tiers tried before the parser (else NULL)
 } RecipeSiteInfo;
 
 
+// ---------------------------------------------------------------------------
+// FingerprintSet
+// Compact open-addressing hash table of 64-bit fingerprints (FNV-1a of a
+// canonical string), each with a 32-bit value. Used for duplicate
+// filtering instead of GHashTables keyed by g_strdup'd strings: 12 bytes
+// per slot, no key copies, O(1) amortized insert (linear probing, doubles
+// when 3/4 full). Fingerprint 0 marks an empty slot.
+// ---------------------------------------------------------------------------
+typedef struct {
+    guint64 *keys;              // Fingerprints (0 = empty slot)
+    guint32 *values;            // Value stored with each fingerprint
+    guint capacity;             // Slots (a power of two)
+    guint size;                 // Occupied slots
+} FingerprintSet;
+
+#define FINGERPRINT_SET_MIN_CAPACITY  64
+
+
+// ---------------------------------------------------------------------------
+// TitleIndex
+// Near-duplicate detection for recipe titles. Each title becomes a MinHash
+// signature of its hashed character n-gram shingles, filed under
+// TITLE_LSH_BANDS band keys (locality-sensitive hashing), so a lookup
+// costs a few probes no matter how many titles are indexed. A title is a
+// near duplicate of an indexed one from another site that shares a band
+// key and agrees on at least TITLE_NEAR_DUP_MIN_AGREE signature values.
+// ---------------------------------------------------------------------------
+typedef struct {
+    FingerprintSet *bands;      // Band key -> index of the first signature filed under it
+    GArray *signatures;         // TitleSignature per indexed title
+} TitleIndex;
+
+// Title shingling and MinHash parameters
+#define TITLE_SHINGLE_SIZE        3    // Characters per shingle
+#define TITLE_MINHASH_SIZE        16   // Values per signature
+#define TITLE_LSH_BANDS           4    // Bands of TITLE_MINHASH_SIZE / TITLE_LSH_BANDS rows
+#define TITLE_NEAR_DUP_MIN_AGREE  14   // Equal values (of 16) for a near duplicate (~0.9 Jaccard)
+
+// One indexed title: its MinHash signature and the site that published it
+typedef struct {
+    guint32 values[TITLE_MINHASH_SIZE];
+    const RecipeSiteInfo *site;
+} TitleSignature;
+
+
+// ---------------------------------------------------------------------------
+// StringArena
+// Append-only storage for the result records of one search. A record is a
+// title and a URL, each length-prefixed and NUL-terminated, referenced by
+// a 32-bit offset (ResultRef: chunk index and offset within the chunk).
+// Parser output lists, the duplicate filters, the result channel and the
+// result store all refer to these same bytes, and identical records are
+// interned. Chunks never move, so a record stays valid while the arena
+// lives; the whole search's records are released in one free when the
+// last reference goes. Appends are serialized by a mutex; reads need no
+// lock. Reference counted (search contexts, the channel, results).
+// ---------------------------------------------------------------------------
+typedef struct {
+    guint32 title_len;          // Bytes of the title (without its NUL)
+    guint32 url_len;            // Bytes of the URL (without its NUL)
+    char text[];                // Title, NUL, URL, NUL
+} ResultRecord;
+
+// String arena geometry
+#define STRING_ARENA_CHUNK_BITS   16                                 // Offset bits of a ResultRef
+#define STRING_ARENA_CHUNK_SIZE   (1u << STRING_ARENA_CHUNK_BITS)    // 64 KB chunks
+#define STRING_ARENA_MAX_CHUNKS   1024                               // At most 64 MB per search
+#define STRING_ARENA_MAX_URL      2048                               // Longer URLs are not stored
+
+struct StringArena {
+    gint ref_count;             // Owners (atomic)
+    GMutex lock;                // Serializes appends
+    char *chunks[STRING_ARENA_MAX_CHUNKS];  // Record chunks (never moved)
+    guint n_chunks;             // Chunks allocated
+    guint32 used;               // Bytes used in the last chunk
+    FingerprintSet *interned;   // Fingerprint of title and URL -> record
+    guint records;              // Records stored
+};
+
+
+// ---------------------------------------------------------------------------
+// SearchContext
+// Everything one site search needs besides its query: the site, the result
+// budget, the duplicate filter and the cancellation state. Created by
+// whoever starts the search (search thread, "All Sites" task, background
+// cache refresh) and passed to run_site_search(), the site parser,
+// add_link() and run_site_script(), so searches never share globals and
+// can run in parallel.
+// An "All Sites" search has one parent context (the combined budget) and
+// one child per site; a link counts against the child and all its parents.
+// Reference counted; a child holds a reference on its parent.
+// ---------------------------------------------------------------------------
+struct SearchContext {
+    gint ref_count;              // Owners (atomic)
+    SearchContext *parent;       // Context sharing its budget with this one, or NULL
+    const RecipeSiteInfo *site;  // Site being searched (NULL for a fan-out parent)
+    const char *site_name;       // Site name for log messages
+    gint result_limit;           // Maximum links this context may add
+    gint result_total;           // Links added so far (atomic)
+    gint fallback_links;         // Links added by add_fallback_link() (atomic)
+    gint cancelled;              // Nonzero once cancelled (atomic)
+    gint64 deadline;             // Monotonic time limit for site scripts (0 = none)
+    StringArena *arena;          // Result records of the whole search (the root's, shared)
+    FingerprintSet *link_set;    // Canonical URL -> record added so far (duplicate filter, owned)
+    ResultChannel *channel;      // Where accepted links are published (inherited from the parent, or NULL)
+    GMutex publish_lock;         // Guards the two filters below (used on the root context)
+    FingerprintSet *published;   // Canonical URLs published by the whole search (root only, lazy)
+    TitleIndex *titles;          // Titles published by the whole search (root only, lazy)
+};
+
+
+// ---------------------------------------------------------------------------
+// ResultChannel
+// Carries links from the threads that find them to the listbox while the
+// search is still running. Producers (add_link() and cache hits, on any
+// thread) push RankedLinks onto the queue; a main-loop source drains it
+// and ranks the links into the list. Attached to the search
+// token by initialize_on_search() and shared by all of its child contexts.
+// Reference counted: owned by the token and by a pending drain source.
+// ---------------------------------------------------------------------------
+struct ResultChannel {
+    gint ref_count;             // Owners (atomic)
+    GAsyncQueue *queue;         // Pending RankedLinks (g_free'd)
+    gint drain_scheduled;       // Nonzero while a drain source is pending (atomic)
+    gint closed;                // Nonzero once superseded; queued links are dropped (atomic)
+    AppWidgets *w;              // Widget references (main thread only)
+    char *query;                // Search term used for match highlighting
+    QuoteStatus quote_status;   // Quoting state of the search term
+    guint published;            // Links handed to the listbox so far (main thread only)
+    ResultRanker *ranker;       // Scores results and keeps the best (main thread only)
+    StringArena *arena;         // Records the queued links refer to (owned ref)
+};
+
+
 // ---------------------------------------------------------------------------
 // DependencyCheckFunc
 // Function type for checking runtime dependencies during the splash screen phase.
@@ -653,6 +1037,245 @@ typedef struct {
 } SplashScreenCheckContext;
 
 
+// ---------------------------------------------------------------------------
+// ScrapeJob
+// One outstanding request to the Node.js scraper worker.
+// Lives on the stack of the search thread waiting in run_site_script().
+// ---------------------------------------------------------------------------
+typedef struct {
+    gboolean done;   // TRUE once the worker replied (or exited)
+    char *output;    // Captured stdout of the site script (g_malloc'd)
+    int exit_code;   // Script exit code reported by the worker (-1 if unknown)
+    GString *streamed; // Streamed stdout not yet parsed (NULL unless streaming)
+} ScrapeJob;
+
+
+// ---------------------------------------------------------------------------
+// JsonRecordStream
+// Incremental JSON reader for script output. Bytes are fed as they arrive
+// (worker chunks, pipe reads) and every complete record is handed to a
+// callback right away: each element of a top-level array, or each value of
+// newline-delimited JSON (NDJSON). Only the record being parsed is held in
+// memory, so there is no upper bound on the size of the whole output.
+// ---------------------------------------------------------------------------
+
+// Called for each complete record; the stream drops its reference afterwards.
+typedef void (*JsonRecordFunc)(struct json_object *record, gpointer user_data);
+
+typedef struct {
+    struct json_tokener *tok;   // Tokener of the record being parsed
+    JsonRecordFunc on_record;   // Called for every complete record
+    gpointer user_data;         // Passed to on_record
+    gboolean in_record;         // TRUE while the tokener holds a partial record
+    gboolean in_array;          // TRUE inside the top-level "[ ... ]"
+    gboolean failed;            // TRUE after a syntax error (rest is ignored)
+    guint records;              // Records delivered so far
+    size_t bytes_fed;           // Bytes fed so far
+} JsonRecordStream;
+
+
+// ---------------------------------------------------------------------------
+// SiteRecordContext
+// State of the shared record callback (site_record_add_link) used by the
+// JavaScript parsers whose scripts print {"title", "url"} records.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GList **out;                  // Parser output list
+    SearchContext *search;        // Search state for add_link()
+    const char *base_url;         // Prefix for relative URLs ("" if absolute)
+    gboolean split_title_digits;  // Run titles through split_title_and_digits()
+    guint records;                // Records received (with or without a link)
+} SiteRecordContext;
+
+
+// ---------------------------------------------------------------------------
+// CssSelector
+// A compiled selector of the CSS subset the native HTML parsers use (see
+// css_selector_new): compound selectors of a tag (or *), .classes, #id and
+// [attr], [attr=value], [attr*=value], [attr^=value] or [attr$=value] tests (each
+// possibly negated with :not()), joined by descendant combinators
+// (whitespace), e.g. ".post-list article h2.entry-title a".
+// ---------------------------------------------------------------------------
+typedef enum {
+    CSS_ATTR_EXISTS,            // [attr]
+    CSS_ATTR_EQUALS,            // [attr=value]
+    CSS_ATTR_CONTAINS,          // [attr*=value]
+    CSS_ATTR_PREFIX,            // [attr^=value]
+    CSS_ATTR_SUFFIX             // [attr$=value]
+} CssAttrOp;
+
+typedef struct {
+    char *name;                 // Attribute name, lowercase
+    char *value;                // Value to compare with (NULL for CSS_ATTR_EXISTS)
+    CssAttrOp op;               // Comparison
+    gboolean negate;            // :not([...]): the element must fail the test
+} CssAttrTest;
+
+typedef struct {
+    GumboTag tag;               // Tag to match (GUMBO_TAG_UNKNOWN: see tag_name)
+    char *tag_name;             // Lowercase tag name (NULL: any element)
+    GPtrArray *classes;         // Classes the element must have (char*, owned)
+    GArray *attrs;              // CssAttrTest the element must pass (strings owned)
+} CssCompound;
+
+typedef struct {
+    GPtrArray *steps;           // CssCompound*, outermost ancestor first (owned)
+} CssSelector;
+
+
+// ---------------------------------------------------------------------------
+// ScrapeWorker
+// State of the long-lived Node.js + Playwright scraper worker process.
+// The worker keeps a warm Chromium and serves site scripts over a
+// JSON-lines protocol on its stdin/stdout (see scrape_worker_js_code).
+// ---------------------------------------------------------------------------
+typedef struct {
+    GMutex lock;                // Guards every field below
+    GCond cond;                 // Signaled when a job finishes or the worker exits
+    GSubprocess *process;       // Running "node -e" worker (NULL if not running)
+    GOutputStream *requests;    // Worker stdin: one JSON request per line
+    GDataInputStream *replies;  // Worker stdout: one JSON reply per line
+    GThread *reader_thread;     // Dispatches replies to waiting jobs
+    GHashTable *pending;        // Job id -> ScrapeJob* awaiting a reply
+    guint next_job_id;          // Last request id handed out
+    gint64 last_start_attempt;  // Monotonic time of last spawn (restart throttle)
+    guint active_jobs;          // Site scripts currently running in the worker
+    guint max_active_jobs;      // Cap on concurrent browser jobs (0 = not read yet)
+    GHashTable *scripts;        // Site key -> script registered with the running worker
+    GHashTable *diagnostics;    // Site keys (or "all") in diagnostics mode; NULL if off
+} ScrapeWorker;
+
+// Scraper worker limits
+#define SCRAPE_JOB_TIMEOUT_MS           90000                  // Worker-side limit for one site script
+#define SCRAPE_JOB_WAIT_SLACK_MS        5000                   // Extra C-side wait before giving up on a reply
+#define SCRAPE_WORKER_RESTART_DELAY_US  (10 * G_USEC_PER_SEC)  // Minimum time between worker spawn attempts
+#define SCRAPE_WORKER_MAX_BROWSER_JOBS  3                      // Default cap on concurrent Chromium jobs
+#define SCRAPE_WORKER_MAX_BROWSER_JOBS_LIMIT 16                // Upper bound for the environment override
+#define SCRAPE_WORKER_MAX_BROWSERS_ENV  "RECIPE_FINDER_MAX_BROWSERS"  // Overrides the default cap
+
+// Scraper diagnostics mode (page artifacts saved per job; off by default)
+#define SCRAPE_DIAGNOSTICS_ENV   "RECIPE_FINDER_DIAGNOSTICS"  // Site keys or "all", comma separated
+#define SCRAPE_DIAGNOSTICS_FILE  "diagnostics.json"           // {"sites": [...]} in the config folder
+
+// Global scraper worker instance (zero-initialized mutex/cond are valid in GLib)
+static ScrapeWorker g_scrape_worker;
+
+
+// ---------------------------------------------------------------------------
+// RuntimeEnv
+// Where the JavaScript runtime lives: resolved once at startup (see
+// runtime_env_init), cached next to the dependency marker file, and read-only
+// afterwards. The scraper worker and the NYT scraper get it through the
+// process environment (NODE_PATH, PLAYWRIGHT_BROWSERS_PATH).
+// ---------------------------------------------------------------------------
+typedef struct {
+    char *node_binary;          // Absolute path of the node executable (NULL: use PATH)
+    char *node_version;         // "node -v" output, e.g. "v20.11.1" (NULL if unknown)
+    char *npm_root;             // Global module root ("npm root -g", NULL if unknown)
+    char *browsers_path;        // Playwright browser install folder (NULL if not found)
+} RuntimeEnv;
+
+// Runtime environment cache
+#define RUNTIME_ENV_CACHE_FILE     "runtime_env.json"  // Stored next to the dependency marker
+#define RUNTIME_ENV_CACHE_VERSION  1                   // Bump when the stored fields change
+#define RUNTIME_ENV_NPM_ROOT_ENV   "RECIPE_FINDER_NPM_ROOT"  // Global module root handed to the worker
+
+// Resolved runtime environment (set in main() before any search thread starts)
+static RuntimeEnv g_runtime_env;
+
+
+
+// ---------------------------------------------------------------------------
+// AllSitesSearch
+// Shared state of one "All Sites" search.
+// Reference counted: owned by the coordinating search thread and by every
+// queued site task, because an abandoned (timed-out) site may only finish
+// after the coordinator has already reported the search as complete.
+// ---------------------------------------------------------------------------
+typedef struct {
+    gint ref_count;             // Coordinator + one per pushed site task
+    AppWidgets *w;              // Widget references
+    SearchContext *token;       // Cancellation token of the whole search
+    char *query;                // Search term (copied from the entry)
+    QuoteStatus quote_status;   // Quoting state of the search term
+    GMutex lock;                // Guards every field below
+    GCond cond;                 // Signaled whenever a site finishes
+    SearchContext *context;     // Combined result budget of all sites
+    SearchContext **site_contexts; // Per-site search contexts, indexed like g_recipe_site_table
+    SiteTaskState *states;      // Per-site state, indexed like g_recipe_site_table
+    gint64 *started_at;         // Per-site monotonic start time (0 while queued)
+    guint n_sites;              // Number of sites searched
+    guint remaining;            // Sites neither finished nor abandoned
+    guint sites_with_results;   // Sites that returned at least one link
+    guint timed_out;            // Sites abandoned after their time budget
+    guint total_results;        // Links sent to the UI so far
+} AllSitesSearch;
+
+
+// ---------------------------------------------------------------------------
+// SiteBatchResult
+// One progress update of an "All Sites" search, handed to the main thread.
+// Reports either one finished site, or (final == TRUE) the closing summary
+// that re-enables the UI. The links themselves travel through the search's
+// ResultChannel as they are found.
+// ---------------------------------------------------------------------------
+typedef struct {
+    AppWidgets *w;              // Widget references
+    char *message;              // Status label text
+    guint finished;             // Sites finished (or abandoned) so far
+    guint n_sites;              // Number of sites searched
+    gboolean final;             // TRUE for the closing summary
+    SearchContext *search;      // Cancellation token; superseded updates are dropped
+} SiteBatchResult;
+
+// "All Sites" search limits
+#define ALL_SITES_MAX_CONCURRENT_SEARCHES  6      // Worker-pool threads running site parsers
+#define ALL_SITES_SITE_TIMEOUT_MS          45000  // Time budget of one site once it starts
+
+
+// ---------------------------------------------------------------------------
+// ResultCacheRefresh
+// A background re-run of one site parser for a stale cache entry.
+// ---------------------------------------------------------------------------
+typedef struct {
+    const RecipeSiteInfo *site;  // Site to refresh
+    char *query;                 // Original search term
+    char *url;                   // Site search URL for the query
+    char *path;                  // Cache file to rewrite
+} ResultCacheRefresh;
+
+// Search result cache settings
+#define RESULT_CACHE_TTL_SECONDS        (6 * 60 * 60)       // Entries are fresh for 6 hours
+#define RESULT_CACHE_MAX_STALE_SECONDS  (7 * 24 * 60 * 60)  // Stale entries are served for 7 days
+#define RESULT_CACHE_FORMAT_VERSION     1                   // Bump when the file layout changes
+
+// Cache files with a refresh in flight (guarded by g_result_cache_lock)
+static GHashTable *g_result_cache_refreshing = NULL;
+static GMutex g_result_cache_lock;
+
+
+// ---------------------------------------------------------------------------
+// FetchTierRecord
+// What one site has learned about its fetch tiers (see run_site_escalation).
+// ---------------------------------------------------------------------------
+typedef struct {
+    FetchTier tier;             // Tier that produced links last time
+    guint browser_runs;         // Browser searches since the page tiers were last tried
+} FetchTierRecord;
+
+// Learned fetch tier settings
+#define FETCH_TIER_FILE             "fetch_tiers.json"  // In the recipe_finder user cache folder
+#define FETCH_TIER_RETRY_INTERVAL   10                  // Browser searches before the page tiers are retried
+#define FETCH_TIER_STATIC_MIN_LINKS 3                   // Selector links a search page needs to count as results
+#define JSON_LD_MAX_DEPTH           8                   // Nesting followed inside one JSON-LD block
+#define NEXT_DATA_MAX_DEPTH         32                  // Nesting followed inside __NEXT_DATA__ page state
+
+// Learned tiers by site name (FetchTierRecord *), loaded from FETCH_TIER_FILE
+// on first use (guarded by g_fetch_tier_lock)
+static GHashTable *g_fetch_tiers = NULL;
+static GMutex g_fetch_tier_lock;
+
+
 // ===========================================================================
 // Parser Memory Management
 // ===========================================================================
@@ -674,8 +1297,196 @@ typedef struct {
     size_t capacity;  // Total allocated size
 } MemoryBlock;
 
-// Global parser buffer instance
-MemoryBlock parser_buffer = { NULL, 0, DEFAULT_MEMORY_PARSER_SIZE };
+// Starting capacity of each thread's download arena. main() replaces the
+// default with the RAM tier chosen by detect_initial_capacity().
+static size_t g_download_arena_capacity = DEFAULT_MEMORY_PARSER_SIZE;
+
+
+// Download buffer pool settings
+#define DOWNLOAD_BUFFER_POOL_SLOTS      4                   // Idle buffers kept for reuse
+#define DOWNLOAD_BUFFER_MAX_POOLED      (4 * 1024 * 1024)   // Larger buffers are freed, not pooled
+#define FREE_MEMORY_SAMPLE_INTERVAL_US  (2 * G_USEC_PER_SEC) // Free-RAM reading refresh interval
+
+
+// ---------------------------------------------------------------------------
+// DownloadBufferPool
+// Small pool of idle download buffers. HTTP response bodies take a buffer
+// from here (sized from Content-Length when the server sends one) and give
+// it back when the body is no longer needed, so consecutive requests reuse
+// already-grown memory instead of starting from zero and reallocating.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GMutex lock;                                   // Guards all fields below
+    MemoryBlock idle[DOWNLOAD_BUFFER_POOL_SLOTS];  // Idle buffers (size is always 0)
+    guint n_idle;                                  // Number of valid entries in idle[]
+    guint reused;                                  // Acquisitions served from the pool
+    guint allocated;                               // Acquisitions that had to malloc
+} DownloadBufferPool;
+
+static DownloadBufferPool g_download_pool;
+
+
+// ---------------------------------------------------------------------------
+// FreeMemorySampler
+// Cached free-RAM reading used as a memory-pressure check when a download
+// buffer grows. get_free_memory() is a system call (sysinfo, host_statistics,
+// GlobalMemoryStatusEx), so it is only repeated once the cached reading is
+// older than FREE_MEMORY_SAMPLE_INTERVAL_US.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GMutex lock;         // Guards the fields below
+    size_t free_bytes;   // Last reading of get_free_memory()
+    gint64 sampled_at;   // g_get_monotonic_time() of that reading (0 = never)
+} FreeMemorySampler;
+
+static FreeMemorySampler g_free_memory_sampler;
+
+
+// ---------------------------------------------------------------------------
+// DownloadArena
+// Per-thread download buffer used by download_html(). Each search thread
+// (and each "All Sites" pool thread) gets one on its first download,
+// seeded at g_download_arena_capacity. Between requests it is reset, not
+// freed, so it keeps the capacity earlier pages grew it to. The buffer goes
+// back to the download buffer pool when the thread exits.
+// ---------------------------------------------------------------------------
+typedef struct {
+    MemoryBlock block;    // Page storage (block.size = bytes of the last page)
+    size_t high_water;    // Largest page this arena has held
+    guint fetches;        // Pages downloaded into this arena
+} DownloadArena;
+
+// Process-wide download arena metrics (see download_arena_reset)
+typedef struct {
+    GMutex lock;          // Guards the fields below
+    size_t high_water;    // Largest page any arena has held
+    guint arenas;         // Arenas created so far
+    guint fetches;        // Pages downloaded into arenas
+    guint grown;          // Fetches that had to grow their arena
+} DownloadArenaStats;
+
+static void download_arena_free(gpointer data);
+static GPrivate g_download_arena = G_PRIVATE_INIT(download_arena_free);
+static DownloadArenaStats g_download_arena_stats;
+
+
+// ===========================================================================
+// Shared HTTP Engine
+// ===========================================================================
+
+// HTTP engine settings
+#define HTTP_USER_AGENT  "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 Chrome/124.0.0.0 Safari/537.36"
+#define HTTP_MAX_HOST_CONNECTIONS  6     // Parallel connections per host (HTTP/1.1 fallback)
+#define HTTP_POLL_TIMEOUT_MS       1000  // Engine thread wake-up interval when idle
+
+
+// ---------------------------------------------------------------------------
+// HttpRequest
+// One HTTP GET transfer run by the shared HTTP engine.
+// Created with http_request_new(), handed to http_engine_submit(), and
+// passed back to its completion function once the transfer has finished.
+// ---------------------------------------------------------------------------
+typedef struct HttpRequest HttpRequest;
+
+// Called on the engine thread when a transfer finishes; keep it short.
+// The completion function owns the request (free with http_request_free).
+typedef void (*HttpCompletionFunc)(HttpRequest *request, gpointer user_data);
+
+struct HttpRequest {
+    CURL *easy;                     // Easy handle configured for this transfer
+    char *url;                      // Requested URL
+    MemoryBlock body;               // Response body (filled by memory_write_callback)
+    SearchContext *search;          // Search that aborts the transfer when cancelled (may be NULL)
+    gboolean body_sized;            // TRUE once body was sized from Content-Length
+    CURLcode result;                // Transfer result (CURLE_OK on success)
+    long response_code;             // Final HTTP status code
+    gboolean done;                  // TRUE once completed (for http_perform_blocking waiters)
+    HttpCompletionFunc on_complete; // Completion callback (engine thread)
+    gpointer user_data;             // Passed to on_complete
+};
+
+
+// ---------------------------------------------------------------------------
+// HttpEngine
+// Process-wide HTTP engine: one curl multi handle driven by one thread.
+// A CURLSH share object keeps connections, DNS results and TLS sessions
+// between requests, and HTTP/2 multiplexing lets transfers to the same host
+// share a single connection, so repeated searches skip the handshakes.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GMutex lock;                    // Guards incoming, running, stopping, done flags
+    GCond cond;                     // Signaled when a transfer completes
+    CURLM *multi;                   // Multi handle driving every transfer
+    CURLSH *share;                  // Shared connection/DNS/TLS-session cache
+    GMutex share_locks[CURL_LOCK_DATA_LAST];  // One lock per shared data kind
+    GThread *thread;                // Engine thread (runs curl_multi_poll loop)
+    GQueue incoming;                // Submitted requests not yet added to multi
+    gboolean running;               // TRUE between start and stop
+    gboolean stopping;              // Set by http_engine_stop()
+} HttpEngine;
+
+// Global HTTP engine instance
+static HttpEngine g_http_engine;
+
+
+// ---------------------------------------------------------------------------
+// AnchorLink
+// One <a> element reported by the streaming anchor scanner.
+// The strings are owned by the scanner and only valid during the callback.
+// ---------------------------------------------------------------------------
+typedef struct {
+    const char *href;         // Decoded href attribute value
+    const char *first_text;   // First non-whitespace text inside the anchor (or NULL)
+    const char *direct_text;  // Text if it is the anchor's first child node (or NULL)
+    const char *text;         // All text inside the anchor, trimmed (may be "")
+} AnchorLink;
+
+// Called for every anchor found while a page streams in.
+typedef void (*AnchorFunc)(const AnchorLink *link, gpointer user_data);
+
+
+// ---------------------------------------------------------------------------
+// AnchorScanner
+// Tokenizer-level HTML scanner fed straight from the libcurl write
+// callback. Keeps only the current tag and the current anchor's text, so
+// its memory use does not depend on the page size.
+// ---------------------------------------------------------------------------
+typedef struct {
+    AnchorScanState state;      // Tokenizer state
+    GString *tag;               // Current tag text between '<' and '>'
+    char quote;                 // Open attribute-value quote inside a tag (0 = none)
+    gboolean tag_overflow;      // Current tag exceeded ANCHOR_SCANNER_MAX_TAG
+    char raw_end[24];           // End tag that closes the raw-text element ("</script")
+    guint raw_match;            // Characters of raw_end matched so far
+    guint comment_dashes;       // Consecutive '-' seen inside a comment
+    GString *run;               // Text since the last tag (inside anchors only)
+    gboolean in_anchor;         // Inside an open <a> element
+    gboolean seen_child;        // The open anchor already has a child node
+    char *href;                 // href of the open anchor
+    char *first_text;           // First non-whitespace text of the open anchor
+    char *direct_text;          // Text that is the open anchor's first child
+    GString *text;              // All text of the open anchor
+    AnchorFunc on_anchor;       // Called for each completed anchor
+    gpointer user_data;         // Passed to on_anchor
+    size_t bytes_scanned;       // Bytes fed so far
+    guint anchors_found;        // Anchors with an href reported so far
+} AnchorScanner;
+
+
+// ---------------------------------------------------------------------------
+// AnchorParseContext
+// State shared by a streaming parser and its AnchorFunc callback.
+// ---------------------------------------------------------------------------
+typedef struct {
+    GList **out;                // Parser output list
+    SearchContext *search;      // Search state for add_link()
+    const char *search_term;    // User's search term
+    gboolean found_any;         // TRUE once a recipe link was added
+} AnchorParseContext;
+
+// Streaming anchor scanner limits
+#define ANCHOR_SCANNER_MAX_TAG   (8 * 1024)  // Longest tag kept (longer tags are skipped)
+#define ANCHOR_SCANNER_MAX_TEXT  2048        // Longest anchor text kept
 
 
 // ===========================================================================
@@ -697,9 +1508,30 @@ int main(int argc, char *argv[]);
 // Returns amount of free memory available in the run-time system
 static size_t get_free_memory(void);
 
+// Returns a cached free memory reading, refreshed every couple of seconds
+static size_t get_free_memory_cached(void);
+
 // libcurl write callback storing data in memory buffer
 static size_t memory_write_callback(void *contents, size_t sz, size_t nm, void *mem_block_ptr);
 
+// Gives an empty MemoryBlock a buffer of at least min_capacity bytes
+static gboolean download_buffer_acquire(MemoryBlock *m, size_t min_capacity);
+
+// Grows a MemoryBlock's buffer to at least min_capacity bytes
+static gboolean download_buffer_reserve(MemoryBlock *m, size_t min_capacity);
+
+// Returns a MemoryBlock's buffer to the download buffer pool
+static void download_buffer_release(MemoryBlock *m);
+
+// Returns the calling thread's download arena, creating it on first use
+static DownloadArena *download_arena_get(void);
+
+// Marks the calling thread's arena as free again and records its usage
+static void download_arena_reset(void);
+
+// Logs the download arena metrics (called at exit)
+static void download_arena_log_stats(void);
+
 // Returns initial buffer capacity based on system RAM
 static size_t detect_initial_capacity(void);
 
@@ -742,69 +1574,465 @@ static gboolean check_npm_package_installed_gtk(GtkWindow *parent, const char *p
 // Gets the path to the runtime dependency marker file
 static char* get_dependency_marker_path(void);
 
+// Resolves node, the global module root and the Playwright browsers once
+// (from the cache unless 'refresh'), and exports them to child processes
+static void runtime_env_init(gboolean refresh);
 
-// ---------------------------------------------------------------------------
-// GTK UI Callbacks and Helpers
-// ---------------------------------------------------------------------------
+// Probes the runtime environment by running node and npm
+static void runtime_env_probe(RuntimeEnv *env);
 
-// Called after memory setup and dependency checks; sets up GTK window, widgets, and callbacks
+// Loads/saves the runtime environment cache; load fails if it is stale
+static gboolean runtime_env_load(RuntimeEnv *env, const char *path);
+static void runtime_env_save(const RuntimeEnv *env, const char *path);
 
-// Loads CSS styles into the app
-static void load_app_css_styles(void);
+// Node executable to launch ("node" if it was not resolved)
+static const char *runtime_env_node(void);
 
-// Registers CSS data
-static void register_css_styles(const gchar *css_data);
+// ---------------------------------------------------------------------------
+// Scraper Worker (persistent Node.js + Playwright process)
+// ---------------------------------------------------------------------------
 
-// Callback when search button is clicked
-static void initialize_on_search(GtkButton *btn, gpointer ud);
+// Started once in main() after the dependency check; shared by all JS parsers.
 
-// Thread function for performing search
-static gpointer search_thread_func(gpointer data);
+// Starts the scraper worker if it is not running
+static gboolean scrape_worker_start(void);
 
-// Updates progress bar periodically
-static gboolean pulse_progress_bar(gpointer data);
+// Reads the sites in diagnostics mode (NULL if off) and the artifact folder
+static GHashTable *scrape_diagnostics_load(void);
+static char *scrape_diagnostics_folder(void);
 
-// Called when search completes
-static gboolean search_complete_cb(gpointer data);
+// Shuts down the scraper worker at app exit
+static void scrape_worker_stop(void);
 
-// Clears current recipe results from listbox
-static void clear_recipe_results(GtkWidget *listbox);
+// Reads worker replies and wakes up waiting jobs
+static gpointer scrape_worker_reader_thread(gpointer data);
 
-// Blocks scroll event if needed
-static gboolean block_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer user_data);
+// Hands one worker reply to the job waiting for it
+static void scrape_worker_dispatch_reply(const char *line);
 
-// Enables or disables UI widgets
-static void set_ui_enabled(const AppWidgets *w, gboolean enabled);
+// Runs a site's embedded JS in the worker and returns its stdout
+static char *run_site_script(SearchContext *search, const char *site_key, const char *js_code, const char *search_term, int *exit_code);
 
-// Sets mouse cursor for widget
-static void set_cursor(GtkWidget *widget, GdkCursorType cursor_type);
+// Runs a site's embedded JS, streaming its JSON records to a callback
+static gboolean run_site_script_records(SearchContext *search, const char *site_key, const char *js_code, const char *search_term,
+                                        JsonRecordFunc on_record, gpointer user_data, int *exit_code);
 
-// Callback for when a recipe item is clicked
-static void on_recipe_clicked(GtkWidget *btn, gpointer user_data G_GNUC_UNUSED);
+// Shared worker job runner behind run_site_script()/run_site_script_records()
+static char *scrape_worker_run(SearchContext *search, const char *site_key, const char *js_code, const char *search_term,
+                               JsonRecordStream *stream, int *exit_code);
 
-// Focuses entry field in idle loop
-static gboolean focus_entry_idle(gpointer user_data);
+// Creates/frees an incremental JSON record reader
+static JsonRecordStream *json_record_stream_new(JsonRecordFunc on_record, gpointer user_data);
+static void json_record_stream_free(JsonRecordStream *stream);
 
-// Displays search results in listbox
-static void show_results(GtkWidget *listbox_widget, GList *links, const char *search_term, QuoteStatus quote_status);
+// Feeds bytes to a record reader, delivering every completed record
+static void json_record_stream_feed(JsonRecordStream *stream, const char *data, size_t len);
 
-// Inserts "Next" button in listbox
-static gboolean insert_next_button(gpointer user_data);
+// Ends a record reader; returns FALSE on a syntax error or truncated record
+static gboolean json_record_stream_finish(JsonRecordStream *stream);
 
-// Adds "visible" CSS class to widget
-static gboolean add_visible_class(gpointer widget);
+// Record callback adding {"title", "url"} records with add_link()
+static void site_record_add_link(struct json_object *record, gpointer user_data);
 
-// Callback when window is realized
-static void on_window_realize(GtkWidget *widget, gpointer user_data);
+// TRUE if a script marked a record as its fallback link ("fallback": true)
+static gboolean json_record_is_fallback(struct json_object *record);
 
 // ---------------------------------------------------------------------------
-// Networking and Download Helpers
+// Native HTML extraction (CSS selector subset over the Gumbo tree)
 // ---------------------------------------------------------------------------
 
-// Called by parser and UI routines to fetch HTML content
-static char* download_html(const char *url);
+// Compiles/frees a CSS selector; NULL (with a warning) on unsupported syntax
+static CssSelector *css_selector_new(const char *selector);
+static void css_selector_free(CssSelector *selector);
 
-// ---------------------------------------------------------------------------
+// TRUE if an element matches a compiled selector
+static gboolean css_selector_matches(const CssSelector *selector, const GumboNode *node);
+
+// Appends the elements below 'scope' matching the selector (document order)
+static void css_select(GumboNode *scope, const CssSelector *selector, GPtrArray *matches);
+
+// First element below 'scope' matching the selector, or NULL
+static GumboNode *css_select_first(GumboNode *scope, const CssSelector *selector);
+
+// Text content of a node, whitespace collapsed and trimmed (caller frees)
+static char *html_node_text(const GumboNode *node);
+
+// TRUE if a result link, resolved against base_url, contains url_match (NULL: any)
+static gboolean html_link_matches(const char *base_url, const char *url, const char *url_match);
+
+// Adds the first link_selector link inside every item_selector element,
+// if at least min_links of them qualify; returns links found
+static guint html_scrape_links(GumboNode *root, const char *item_selector, const char *link_selector,
+                               const char *base_url, const char *url_match, guint min_links,
+                               GList **out, SearchContext *search);
+
+// Raw contents of a <script> element, or NULL
+static const char *html_script_text(const GumboNode *script);
+
+// Adds the ItemList entries and Recipe objects of the page's JSON-LD blocks; returns links found
+static guint html_extract_json_ld_links(GumboNode *root, const char *base_url, const char *url_match,
+                                        GList **out, SearchContext *search);
+
+// Adds the result-like objects of the page's Next.js __NEXT_DATA__ state; returns links found
+static guint html_extract_next_data_links(GumboNode *root, const char *base_url, const char *url_match,
+                                          GList **out, SearchContext *search);
+
+// ---------------------------------------------------------------------------
+// Search Context (per-search limits, duplicate filter and cancellation)
+// ---------------------------------------------------------------------------
+
+// Creates a search context for a site (or a fan-out parent when site is NULL)
+static SearchContext *search_context_new(SearchContext *parent, const RecipeSiteInfo *site, gint result_limit);
+
+// Adds/releases a reference to a search context
+static SearchContext *search_context_ref(SearchContext *search);
+static void search_context_unref(SearchContext *search);
+
+// Reserves one result slot in a context and all its parents
+static gboolean search_context_claim_result(SearchContext *search);
+
+// Cancels a search context (and its children) and wakes blocked transfers
+static void search_context_cancel(SearchContext *search);
+
+// TRUE if the context or any parent was cancelled
+static gboolean search_context_is_cancelled(SearchContext *search);
+
+// Earliest deadline of the context and its parents (0 if none)
+static gint64 search_context_deadline(SearchContext *search);
+
+// TRUE if the context added links other than fallback links
+static gboolean search_context_found_results(SearchContext *search);
+
+// Publishes a link (or a cached list of links) to the context's result channel (no-op without one)
+static void search_context_publish(SearchContext *search, ResultRef record, guint site_rank);
+static void search_context_publish_list(SearchContext *search, GList *links);
+
+// Cross-site filter: FALSE if the search already published this link or a near-duplicate title
+static gboolean search_context_admit_published(SearchContext *search, ResultRef record);
+
+// TRUE if the context is one site of a search over several sites
+static gboolean search_context_spans_sites(SearchContext *search);
+
+// TRUE if the context already added a link with this canonical URL
+static gboolean search_context_has_link(SearchContext *search, const char *url);
+
+// ---------------------------------------------------------------------------
+// Duplicate detection (canonical URLs, fingerprints, title shingles)
+// ---------------------------------------------------------------------------
+
+// Canonical form of a recipe URL, for duplicate detection only
+static char *canonicalize_url(const char *url);
+
+// TRUE if a canonical URL keeps this query parameter
+static gboolean url_query_param_is_kept(const char *host, const char *name, size_t name_len);
+static gint url_query_param_compare(gconstpointer a, gconstpointer b);
+
+// 64-bit FNV-1a fingerprint (never 0) and a bit mixer
+static guint64 fingerprint_hash(const char *data, size_t len);
+static guint64 fingerprint_mix(guint64 x);
+
+// Creates/frees a fingerprint set
+static FingerprintSet *fingerprint_set_new(void);
+static void fingerprint_set_free(FingerprintSet *set);
+
+// Looks up a fingerprint (and its value)
+static gboolean fingerprint_set_lookup(const FingerprintSet *set, guint64 key, guint32 *value);
+
+// Inserts a fingerprint; FALSE if it was already there
+static gboolean fingerprint_set_insert(FingerprintSet *set, guint64 key, guint32 value);
+
+// Creates/frees a near-duplicate title index
+static TitleIndex *title_index_new(void);
+static void title_index_free(TitleIndex *index);
+
+// MinHash signature of a title's shingles; FALSE if the title is too short
+static gboolean title_signature(const char *title, guint32 *signature);
+
+// Indexes a site's title; FALSE if it is a near duplicate of another site's
+static gboolean title_index_add(TitleIndex *index, const char *title, const RecipeSiteInfo *site);
+
+// ---------------------------------------------------------------------------
+// String arena (per-search result records)
+// ---------------------------------------------------------------------------
+
+// Creates/references/releases a string arena
+static StringArena *string_arena_new(void);
+static StringArena *string_arena_ref(StringArena *arena);
+static void string_arena_unref(StringArena *arena);
+
+// Stores (or finds the interned copy of) a title/URL record; 0 if it does not fit
+static ResultRef string_arena_add(StringArena *arena, const char *title, size_t title_len, const char *url, size_t url_len);
+
+// Resolves a record reference
+static const ResultRecord *string_arena_record(const StringArena *arena, ResultRef ref);
+
+// Title and URL of a record
+static const char *result_record_title(const ResultRecord *record);
+static const char *result_record_url(const ResultRecord *record);
+
+// ---------------------------------------------------------------------------
+// "All Sites" Search (bounded fan-out over every recipe site)
+// ---------------------------------------------------------------------------
+
+// Called from search_thread_func() when the "All Sites" entry is selected.
+
+// Builds the search URL of one site for the query
+static char *build_site_search_url(const RecipeSiteInfo *site, const char *query);
+
+// Runs one site's parser (with prefetch when it needs the DOM)
+static gboolean run_site_search(SearchContext *search, const char *query, const char *url, GList **out, char **status_message);
+
+// Fans the query out to every site through a fixed-size thread pool
+static void run_all_sites_search(SearchRequest *request);
+
+// Thread-pool task: searches one site and streams its results to the UI
+static void all_sites_task_func(gpointer task_data, gpointer pool_data);
+
+// Releases one reference to an "All Sites" search
+static void all_sites_search_unref(AllSitesSearch *search);
+
+// Posts a progress update or the closing summary to the main thread
+static void all_sites_post_update(AllSitesSearch *search, const char *message, gboolean final);
+
+// Applies an "All Sites" progress update in the main thread
+static gboolean all_sites_update_cb(gpointer data);
+
+// ---------------------------------------------------------------------------
+// Search Result Cache (on-disk, keyed by site and normalized query)
+// ---------------------------------------------------------------------------
+
+// Consulted by run_site_search() before any parser, JS or C, is started.
+
+// Runs one site's parser without consulting the cache
+static gboolean run_site_parser(SearchContext *search, const char *query, const char *url, GList **out, char **status_message);
+
+// Queries a site's JSON search API and adds the projected links; FALSE on failure
+static gboolean run_json_endpoint(SearchContext *search, const JsonEndpoint *endpoint, const char *query, GList **out);
+
+// ---------------------------------------------------------------------------
+// Fetch Tiers (search page, embedded JSON-LD/__NEXT_DATA__, then the browser script)
+// ---------------------------------------------------------------------------
+
+// Runs an escalating site: page tiers first, the browser script only if they find nothing
+static gboolean run_site_escalation(SearchContext *search, const char *query, GList **out);
+
+// Tier to start a site's search at (counts browser runs towards a retry)
+static FetchTier fetch_tier_start(const RecipeSiteInfo *site);
+
+// Remembers the tier that produced a site's links (saved when it changes)
+static void fetch_tier_learn(const RecipeSiteInfo *site, FetchTier tier);
+
+// Loads/saves the learned tiers (caller holds g_fetch_tier_lock)
+static void fetch_tier_load_locked(void);
+static void fetch_tier_save_locked(void);
+
+// Builds the normalized cache key of a query (NULL if it has no keywords)
+static char *result_cache_normalize_query(const char *query);
+
+// Gets the cache file path for a site and query
+static char *result_cache_path(const RecipeSiteInfo *site, const char *query);
+
+// Loads cached links for a site and query
+static ResultCacheState result_cache_lookup(const char *path, StringArena *arena, GList **out);
+
+// Writes a site's links to the cache
+static void result_cache_store(const char *path, const RecipeSiteInfo *site, const char *query, StringArena *arena, GList *links);
+
+// Starts a background refresh of a stale cache entry
+static void result_cache_refresh_async(const RecipeSiteInfo *site, const char *query, const char *url, const char *path);
+
+// Background thread re-running a site parser for a stale entry
+static gpointer result_cache_refresh_thread(gpointer data);
+
+
+// ---------------------------------------------------------------------------
+// GTK UI Callbacks and Helpers
+// ---------------------------------------------------------------------------
+
+// Called after memory setup and dependency checks; sets up GTK window, widgets, and callbacks
+
+// Loads CSS styles into the app
+static void load_app_css_styles(void);
+
+// Registers CSS data
+static void register_css_styles(const gchar *css_data);
+
+// Callback when search button is clicked
+static void initialize_on_search(GtkButton *btn, gpointer ud);
+
+// Thread function for performing search
+static gpointer search_thread_func(gpointer data);
+
+// Frees a SearchRequest
+static void search_request_free(SearchRequest *request);
+
+// Cancels the running search (if any) so a new one can replace it
+static void supersede_active_search(AppWidgets *w);
+
+// Clears the running search once its final result reached the UI
+static void finish_active_search(AppWidgets *w, SearchContext *search);
+
+// Updates progress bar periodically
+static gboolean pulse_progress_bar(gpointer data);
+
+// Called when search completes
+static gboolean search_complete_cb(gpointer data);
+
+// Creates/references/releases the channel that streams links to the listbox
+static ResultChannel *result_channel_new(AppWidgets *w, const char *query, QuoteStatus quote_status, StringArena *arena);
+static ResultChannel *result_channel_ref(ResultChannel *channel);
+static void result_channel_unref(ResultChannel *channel);
+
+// Queues one link record and its site position for the listbox (any thread)
+static void result_channel_publish(ResultChannel *channel, ResultRef record, guint site_rank);
+
+// Drops everything a superseded search still publishes (main thread)
+static void result_channel_close(ResultChannel *channel);
+
+// Moves queued links into the listbox; returns how many were queued (main thread)
+static guint result_channel_flush(ResultChannel *channel);
+
+// Main-loop source that drains the channel
+static gboolean result_channel_drain_cb(gpointer data);
+
+// Clears current recipe results from listbox
+static void clear_recipe_results(GtkWidget *listbox);
+
+// Blocks scroll event if needed
+static gboolean block_scroll(GtkWidget *widget, GdkEventScroll *event, gpointer user_data);
+
+// Enables or disables UI widgets
+static void set_ui_enabled(const AppWidgets *w, gboolean enabled);
+
+// Sets mouse cursor for widget
+static void set_cursor(GtkWidget *widget, GdkCursorType cursor_type);
+
+// Callback for when a recipe item is clicked
+static void on_recipe_clicked(GtkWidget *btn, gpointer user_data G_GNUC_UNUSED);
+
+// Focuses entry field in idle loop
+static gboolean focus_entry_idle(gpointer user_data);
+
+// Ranks search results into the listbox without clearing it
+static void append_results(GtkWidget *listbox_widget, StringArena *arena, GList *links, ResultRanker *ranker, QuoteStatus quote_status);
+
+// Creates a result store entry (title and URL are copied)
+static RecipeResult *recipe_result_new(const char *title, const char *url);
+
+// Creates a result store entry sharing a record's bytes (keeps the arena alive)
+static RecipeResult *recipe_result_new_from_record(StringArena *arena, ResultRef record);
+
+// Builds the recycled-row result view around the listbox
+static ResultView *result_view_attach(GtkScrolledWindow *scrolled, GtkListBox *listbox);
+
+// Returns the result view of a listbox
+static ResultView *result_view_get(GtkWidget *listbox);
+
+// Appends results to the store (takes the RecipeResult references)
+static void result_view_append(GtkWidget *listbox, GPtrArray *results);
+
+// Replaces the store contents with results (references are added)
+static void result_view_replace(GtkWidget *listbox, GPtrArray *results);
+
+// Empties the store and scrolls back to the top
+static void result_view_clear(GtkWidget *listbox);
+
+// Schedules a rebind of the visible rows on the next frame
+static void result_view_queue_rebind(ResultView *view);
+
+// Frame clock tick running the scheduled rebind
+static gboolean result_view_tick(GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data);
+
+// Binds the recycled rows to the store items in the viewport
+static void result_view_rebind(ResultView *view);
+
+// Shows one store item in a recycled row button
+static void result_view_bind_row(GtkWidget *btn, const RecipeInfo *ri);
+
+// Frees a result view when its listbox goes away
+static void result_view_free(gpointer data);
+
+// Caps a wanted result limit by the result memory budget
+static gint result_limit_for_memory(gint wanted);
+
+// Callback when window is realized
+static void on_window_realize(GtkWidget *widget, gpointer user_data);
+
+// ---------------------------------------------------------------------------
+// Networking and Download Helpers
+// ---------------------------------------------------------------------------
+
+// Called by parser and UI routines to fetch HTML content into the thread's arena
+static gboolean download_html(const char *url, SearchContext *search, MemoryBlock *page);
+
+// Starts the shared HTTP engine (called once from main)
+static gboolean http_engine_start(void);
+
+// Stops the shared HTTP engine and aborts unfinished transfers
+static void http_engine_stop(void);
+
+// Engine thread: drives all transfers through curl_multi
+static gpointer http_engine_thread(gpointer data);
+
+// Creates an HTTP GET request with the app's common options
+static HttpRequest *http_request_new(const char *url, long timeout_s, SearchContext *search);
+
+// Frees a request and its easy handle and body
+static void http_request_free(HttpRequest *request);
+
+// Queues a request; on_complete runs on the engine thread
+static gboolean http_engine_submit(HttpRequest *request, HttpCompletionFunc on_complete, gpointer user_data);
+
+// Hands a finished transfer to its completion function
+static void http_request_complete(HttpRequest *request, CURLcode result);
+
+// Write callback of engine requests; sizes the body from Content-Length
+static size_t http_body_write_callback(void *contents, size_t sz, size_t nm, void *request_ptr);
+
+// Progress callback of engine requests; aborts transfers of cancelled searches
+static int http_xferinfo_callback(void *request_ptr, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
+
+// Completion function of blocking requests (wakes the waiting thread)
+static void http_fetch_done(HttpRequest *request, gpointer user_data);
+
+// Locks/unlocks shared curl data (CURLSH callbacks)
+static void http_share_lock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+static void http_share_unlock(CURL *handle, curl_lock_data data, void *userptr);
+
+// Runs a request on the engine and waits for it to finish
+static gboolean http_perform_blocking(HttpRequest *request);
+
+// Streams a page through the anchor scanner; returns FALSE on HTTP failure
+static gboolean http_stream_anchors(const char *url, long timeout_s, SearchContext *search, AnchorFunc on_anchor, gpointer user_data);
+
+// ---------------------------------------------------------------------------
+// Streaming Anchor Scanner (pure-C parsers)
+// ---------------------------------------------------------------------------
+
+// Decodes HTML character references in place
+static void decode_html_entities(GString *s);
+
+// Creates/frees a streaming anchor scanner
+static AnchorScanner *anchor_scanner_new(AnchorFunc on_anchor, gpointer user_data);
+static void anchor_scanner_free(AnchorScanner *scanner);
+
+// Feeds a chunk of HTML into the scanner
+static void anchor_scanner_feed(AnchorScanner *scanner, const char *data, size_t len);
+
+// Flushes the scanner at end of page
+static void anchor_scanner_finish(AnchorScanner *scanner);
+
+// Scanner internals: text runs, anchors, attributes and tags
+static void anchor_scanner_end_run(AnchorScanner *scanner);
+static void anchor_scanner_close_anchor(AnchorScanner *scanner);
+static char *anchor_scanner_get_attribute(const char *tag, const char *name);
+static gboolean anchor_scanner_after_equals(const GString *tag);
+static void anchor_scanner_handle_tag(AnchorScanner *scanner);
+
+// libcurl write callback that scans instead of buffering
+static size_t anchor_scanner_write_callback(void *contents, size_t sz, size_t nm, void *scanner_ptr);
+
+// ---------------------------------------------------------------------------
 // Parser Helper Utilities
 // ---------------------------------------------------------------------------
 
@@ -817,16 +2045,22 @@ static void trim_whitespace(const char *src, char *dest, size_t dest_size);
 static char *url_encode(const char *str);
 
 // Adds a new link to output list if not already present
-static void add_link(GList **out, const char* title, const char* base_url, const char* href, GHashTable *link_set);
+static void add_link(GList **out, const char* title, const char* base_url, const char* href, SearchContext *search);
+
+// Adds a site's fallback link (search or index page shown when nothing was found)
+static void add_fallback_link(GList **out, const char *title, const char *url, SearchContext *search);
 
 // Converts plural to singular
 static void singularize(const char *src, char *dst, size_t dstlen);
 
+// Singular stem of a lowercase word, for title matching (no protected words)
+static void stem_recipe_word(const char *src, char *dst, size_t dstlen);
+
 // Capitalizes each word in a string
 static void capitalize_each_word(char *str);
 
-// Sanitizes string for safe display
-static char *sanitize_string(const char *str);
+// Copies a string for safe display into dst; FALSE if it had to be truncated
+static gboolean sanitize_string(char *dst, size_t dst_size, const char *src);
 
 // Splits title and digits
 static char *split_title_and_digits(const char *title);
@@ -846,6 +2080,38 @@ static gboolean is_stop_word(const char *word);
 // Tokenizes phrase and filters out stop words
 GList *tokenize_and_filter_stop_words(const char *phrase);
 
+// Compiles the filtered tokens of a quoted search into a matcher (NULL if none)
+static TokenMatcher *token_matcher_new_for_quoted_search(const char *search_term);
+
+// Compiles a list of tokens into a matcher
+static TokenMatcher *token_matcher_new(GList *tokens);
+static void token_matcher_free(TokenMatcher *matcher);
+
+// Finds every word-start token occurrence in one pass over the text
+static guint token_matcher_scan(const TokenMatcher *matcher, const char *text, GArray *matches);
+
+// Smallest span of text covering one occurrence of each matched token
+static guint token_matches_span(const GArray *matches);
+
+// Consecutive search tokens found next to each other in the text
+static guint token_matches_adjacent_pairs(const TokenMatcher *matcher, const char *text, const GArray *matches);
+
+// Creates/frees the relevance ranker of one search
+static ResultRanker *result_ranker_new(const char *query, QuoteStatus quote_status);
+static void result_ranker_free(ResultRanker *ranker);
+
+// Matches a title against the search tokens and scores it
+static void result_ranker_score(ResultRanker *ranker, const char *title, guint site_rank, RecipeInfo *info);
+
+// TRUE if a result with this score would make the kept results
+static gboolean result_ranker_would_keep(const ResultRanker *ranker, double score);
+
+// Offers a result to the bounded heap; returns TRUE if it was kept
+static gboolean result_ranker_offer(ResultRanker *ranker, RecipeResult *result);
+
+// Kept results, best first (container only)
+static GPtrArray *result_ranker_sorted(const ResultRanker *ranker);
+
 // Detects whether the search term has quotes
 static QuoteStatus detect_quote_status(const char *search_term);
 
@@ -855,17 +2121,11 @@ static bool contains_word_case_insensitive(const char *haystack, const char *nee
 // Converts slug to human-readable title
 static void slug_to_title(const char *slug, char *out, size_t out_size);
 
-// Extracts anchor text from Gumbo node
-static const char* extract_anchor_text(GumboNode *node);
-
-// Extracts text content from a Gumbo node (on the saveur.com website)
-static void extract_saveur_text(GumboNode *node, GString *out);
-
-// Another libcurl-compatible write callback (saveur)
-static size_t write_saveur_callback(void *contents, size_t size, size_t nmemb, void *userp);
-
-// Searches for links in a Gumbo node (saveur)
-static void search_for_saveur_links(GumboNode *node, GList **out, GHashTable *link_set);
+// Streamed-anchor handlers of the pure-C parsers
+static void epicurious_anchor_cb(const AnchorLink *link, gpointer user_data);
+static void saveur_anchor_cb(const AnchorLink *link, gpointer user_data);
+static void simplyrecipes_anchor_cb(const AnchorLink *link, gpointer user_data);
+static void yummly_anchor_cb(const AnchorLink *link, gpointer user_data);
 
 
 // ---------------------------------------------------------------------------
@@ -878,27 +2138,26 @@ static void search_for_saveur_links(GumboNode *node, GList **out, GHashTable *li
 // missing data or errors.
 // ---------------------------------------------------------------------------
 
-static void parse_allrecipes(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_bbcgoodfood(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_bonappetit(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_budgetbytes(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_chowhound(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_cooksillustrated(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_delish(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_eatingwell(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_epicurious_wrapper(GumboNode *root, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_epicurious(GumboNode *node, GList **out, GHashTable *link_set, const char *search_term, bool *found_any);
-static void parse_food52(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_nyt(GumboNode *root, GList **links, GHashTable *link_set, const char *search_term);
-static void parse_saveur(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_simplyrecipes(GumboNode *n, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_smittenkitchen(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_spruceeats(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_tasteofhome(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term);
-static void parse_yummlyrecipes(GumboNode *n, GList **out, GHashTable *link_set, const char *search_term);
+static void parse_allrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_bbcgoodfood(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_bonappetit(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_budgetbytes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_chowhound(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_cooksillustrated(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_delish(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_eatingwell(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_epicurious_wrapper(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_food52(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_foodnetwork(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_thekitchn(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_nyt(GumboNode *root, GList **links, SearchContext *search, const char *search_term);
+static void parse_saveur(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_seriouseats(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_simplyrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_smittenkitchen(GumboNode *root, GList **out, SearchContext *search, const char *search_term);
+static void parse_spruceeats(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
+static void parse_tasteofhome(GumboNode *root, GList **out, SearchContext *search, const char *search_term);
+static void parse_yummlyrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term);
 
 // Generic fallback link
 static void insert_fallback_link(GtkWidget *listbox, const char *url, const char *description);
@@ -914,29 +2173,67 @@ static void insert_fallback_link(GtkWidget *listbox, const char *url, const char
 //   2. Parser function name
 //   3. URL string (e.g., https://www.allrecipes.com/search/results/?wt=%s")
 //   4. Query parameter placeholder (e.g., ?wt=)
+//   5. Fetch mode (does the parser consume the prefetched search page DOM?)
+//   6. JSON search API (SITE_JSON_ENDPOINT sites only, otherwise NULL)
+//   7. Fetch escalation (page tiers tried before the parser, otherwise NULL)
 // ---------------------------------------------------------------------------
 
+// Budget Bytes search runs on Slickstream, which answers with
+// {"results": [{"title": ..., "url": ...}, ...]}
+static const JsonEndpoint budgetbytes_json_endpoint = {
+    "https://search.slickstream.com/search?site=budgetbytes.com&q=%s", "results", "title", "url", ""
+};
+
+// Search pages that are server-rendered often enough to try before Chromium.
+// The selectors are the ones the sites' Playwright scripts query, and the
+// scripts' URL filters live in the selector (:not) or in url_match.
+static const SiteEscalation allrecipes_escalation = {
+    "https://www.allrecipes.com/search?q=%s", "a[href*=\"/recipe/\"]:not([href*=\"/video/\"])",
+    "https://www.allrecipes.com", "/recipe/"
+};
+static const SiteEscalation bonappetit_escalation = {
+    "https://www.bonappetit.com/search?q=%s", "a[href*=\"/recipe/\"]", "https://www.bonappetit.com",
+    "https://www.bonappetit.com/recipe/"
+};
+static const SiteEscalation delish_escalation = {
+    "https://www.delish.com/search/?s=%s", "a.card__link[href*=\"/recipe/\"]", "https://www.delish.com", "/recipe/"
+};
+static const SiteEscalation eatingwell_escalation = {
+    "https://www.eatingwell.com/search/?q=%s", "a.comp.mntl-card-list-items__link[href*=\"/recipe/\"]", "https://www.eatingwell.com", "/recipe/"
+};
+static const SiteEscalation food52_escalation = {
+    "https://food52.com/recipes/search?q=%s", "a[href^=\"/recipes/\"]:not([href^=\"/recipes/search\"])",
+    "https://food52.com", "/recipes/"
+};
+static const SiteEscalation seriouseats_escalation = {
+    "https://www.seriouseats.com/search?q=%s", "a[href$=\"-recipe\"]", "https://www.seriouseats.com",
+    "https://www.seriouseats.com/"
+};
+static const SiteEscalation spruceeats_escalation = {
+    "https://www.thespruceeats.com/search?q=%s", "a.card__title-link", "https://www.thespruceeats.com", "/recipes/"
+};
+
 const RecipeSiteInfo g_recipe_site_table[] = {
-    { "AllRecipes", parse_allrecipes, "https://www.allrecipes.com/search/results/?wt=%s", "?wt=" },
-    { "BBC Good Food", parse_bbcgoodfood, "https://www.bbcgoodfood.com/search?q=%s", "?q=" },
-    { "Bon Appetit", parse_bonappetit, "https://www.bonappetit.com/search/%s", "%s" },
-    { "Budget Bytes", parse_budgetbytes, "https://www.budgetbytes.com/?s=%s", "?s=" },
-    { "Chowhound", parse_chowhound, "https://www.chowhound.com/search?query=%s", "?query=" },
-    { "Cooks Illustrated / America's Test Kitchen", parse_cooksillustrated, "https://www.cooksillustrated.com/search?q=%s", "?q=" },
-    { "Delish", parse_delish, "https://www.delish.com/search/%s/", "%s" },
-    { "EatingWell", parse_eatingwell, "https://www.eatingwell.com/search/?q=%s", "?q=" },
-    { "Epicurious", parse_epicurious_wrapper, "https://www.epicurious.com/search/%s", "%s" },
-    { "Food52", parse_food52, "https://food52.com/search?q=%s", "?q=" },
-    { "Food Network", parse_foodnetwork, "https://www.foodnetwork.com/search/%s-", "%s-" },
-    { "NY Times Cooking", parse_nyt, "https://cooking.nytimes.com/search?q=%s", "?q=" },
-    { "The Kitchn", parse_thekitchn, "https://www.thekitchn.com/search?q=%s", "?q=" },
-    { "Saveur", parse_saveur, "https://www.saveur.com/search/%s/", "%s" },
-    { "Serious Eats", parse_seriouseats, "https://www.seriouseats.com/search?q=%s", "?q=" },
-    { "Simply Recipes", parse_simplyrecipes, "https://www.simplyrecipes.com/search?q=%s", "?q=" },
-    { "Smitten Kitchen", parse_smittenkitchen, "https://smittenkitchen.com/?s=%s", "?s=" },
-    { "The Spruce Eats", parse_spruceeats, "https://www.thespruceeats.com/search?q=%s", "?q=" },
-    { "Taste of Home", parse_tasteofhome, "https://www.tasteofhome.com/search/index?search=%s", "?search=" },
-    { "Yummly", parse_yummlyrecipes, "https://www.yummlyrecipes.com/?q=%s", "?q=" }
+    { "AllRecipes", parse_allrecipes, "https://www.allrecipes.com/search/results/?wt=%s", "?wt=", SITE_FETCHES_ITSELF, NULL, &allrecipes_escalation },
+    { "BBC Good Food", parse_bbcgoodfood, "https://www.bbcgoodfood.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Bon Appetit", parse_bonappetit, "https://www.bonappetit.com/search/%s", "%s", SITE_FETCHES_ITSELF, NULL, &bonappetit_escalation },
+    { "Budget Bytes", parse_budgetbytes, "https://www.budgetbytes.com/?s=%s", "?s=", SITE_JSON_ENDPOINT, &budgetbytes_json_endpoint, NULL },
+    { "Chowhound", parse_chowhound, "https://www.chowhound.com/search?query=%s", "?query=", SITE_STATIC_FALLBACK_ONLY, NULL, NULL },
+    { "Cooks Illustrated / America's Test Kitchen", parse_cooksillustrated, "https://www.cooksillustrated.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Delish", parse_delish, "https://www.delish.com/search/%s/", "%s", SITE_FETCHES_ITSELF, NULL, &delish_escalation },
+    { "EatingWell", parse_eatingwell, "https://www.eatingwell.com/search/?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, &eatingwell_escalation },
+    { "Epicurious", parse_epicurious_wrapper, "https://www.epicurious.com/search/%s", "%s", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Food52", parse_food52, "https://food52.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, &food52_escalation },
+    { "Food Network", parse_foodnetwork, "https://www.foodnetwork.com/search/%s-", "%s-", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "NY Times Cooking", parse_nyt, "https://cooking.nytimes.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "The Kitchn", parse_thekitchn, "https://www.thekitchn.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Saveur", parse_saveur, "https://www.saveur.com/search/%s/", "%s", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Serious Eats", parse_seriouseats, "https://www.seriouseats.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, &seriouseats_escalation },
+    { "Simply Recipes", parse_simplyrecipes, "https://www.simplyrecipes.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL },
+    { "Smitten Kitchen", parse_smittenkitchen, "https://smittenkitchen.com/?s=%s", "?s=", SITE_NEEDS_PREFETCHED_DOM, NULL, NULL },
+    { "The Spruce Eats", parse_spruceeats, "https://www.thespruceeats.com/search?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, &spruceeats_escalation },
+    { "Taste of Home", parse_tasteofhome, "https://www.tasteofhome.com/?s=%s", "?s=", SITE_NEEDS_PREFETCHED_DOM, NULL, NULL },
+    { "Yummly", parse_yummlyrecipes, "https://www.yummlyrecipes.com/?q=%s", "?q=", SITE_FETCHES_ITSELF, NULL, NULL }
 };
 
 
@@ -969,6 +2266,7 @@ int main(int argc, char *argv[]) {
     }
 
     // Check software dependencies only if not already done successfully
+    gboolean dependencies_checked = FALSE;
     if (!software_package_dependencies_OK()) {
         printf("RUNNING APP SOFTWARE DEPENDENCY CHECK ...\n");
         if (!create_splash_window_with_software_checks(check_js_dependencies_gtk)) {
@@ -976,19 +2274,40 @@ int main(int argc, char *argv[]) {
             return 1; // Dependency checks failed
         }
         write_runtime_software_dependency_marker();
-    }
-
-    // Setup parser buffer memory
-    parser_buffer.capacity = detect_initial_capacity();
-    printf("INITIAL RECIPE PARSER MEMORY BUFFER CAPACITY SET TO: %zu bytes\n", parser_buffer.capacity);
-    parser_buffer.data = malloc(parser_buffer.capacity);
-    if (!parser_buffer.data) {
-        fprintf(stderr, "Failed to allocate parser buffer of size %zu\n", parser_buffer.capacity);
+        dependencies_checked = TRUE;
+    }
+
+    // Resolve node, the global npm module root and the Playwright browsers
+    // once (re-probed after a dependency check, otherwise from the cache)
+    runtime_env_init(dependencies_checked);
+
+    // Setup parser buffer memory: every download arena starts at the RAM
+    // tier's size, and the first buffer is allocated now and parked in the
+    // download buffer pool for the first search thread to pick up
+    // (before the engine and worker threads start, so a failure has none
+    // to stop)
+    g_download_arena_capacity = detect_initial_capacity();
+    printf("INITIAL RECIPE PARSER MEMORY BUFFER CAPACITY SET TO: %zu bytes\n", g_download_arena_capacity);
+    MemoryBlock parser_buffer = { NULL, 0, 0 };
+    if (!download_buffer_acquire(&parser_buffer, g_download_arena_capacity)) {
+        fprintf(stderr, "Failed to allocate parser buffer of size %zu\n", g_download_arena_capacity);
+        curl_global_cleanup();
         return 1;
     }
-    parser_buffer.size = 0;
     fprintf(stdout, "PARSER BUFFER ALLOCATED AT: %p, SIZE:  %zu bytes\n",
             (void *)parser_buffer.data, parser_buffer.capacity);
+    download_buffer_release(&parser_buffer);
+
+    // Start the shared HTTP engine (connection, DNS and TLS-session reuse)
+    if (!http_engine_start()) {
+        fprintf(stderr, "Error: failed to start the HTTP engine\n");
+        curl_global_cleanup();
+        return 1;
+    }
+
+    // Start the persistent Node.js scraper worker now, so Chromium is already
+    // warm by the time the user runs the first search
+    scrape_worker_start();
 
     // Load GTK CSS Styling
     load_app_css_styles();
@@ -1021,6 +2340,9 @@ int main(int argc, char *argv[]) {
         gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), g_recipe_site_table[i].name);
     }
 
+    // The last entry searches every site at once (index == n_sites)
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo), "All Sites");
+
     // Set the first website link as the default selection
     gtk_combo_box_set_active(GTK_COMBO_BOX(combo), 0);
 
@@ -1057,7 +2379,7 @@ int main(int argc, char *argv[]) {
     GtkWidget *scr = gtk_scrolled_window_new(NULL, NULL);
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scr), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
     GtkWidget *listbox = gtk_list_box_new();
-    gtk_container_add(GTK_CONTAINER(scr), listbox);
+    result_view_attach(GTK_SCROLLED_WINDOW(scr), GTK_LIST_BOX(listbox));  // Recycled rows over the result store
     gtk_box_pack_start(GTK_BOX(vbox), scr, TRUE, TRUE, 0);
 
     // AppWidgets struct
@@ -1069,6 +2391,8 @@ int main(int argc, char *argv[]) {
     w->search_button = btn;
     w->progress_bar = progress;
     w->pulse_timer_id = 0;
+    w->quote_status = QUOTE_NONE;
+    w->active_search = NULL;
 
     // Connect GTK widget signals to their respective callback functions
     g_signal_connect(combo, "scroll-event", G_CALLBACK(block_scroll), NULL);
@@ -1083,12 +2407,13 @@ int main(int argc, char *argv[]) {
     gtk_main();
 
     // Final cleanup to release all allocated resources before exit
+    // A search still running is cancelled so its threads finish promptly
+    supersede_active_search(w);
+    scrape_worker_stop();
+    http_engine_stop();
     curl_global_cleanup();
     g_free(w);
-    free(parser_buffer.data);
-    parser_buffer.data = NULL;
-    parser_buffer.size = 0;
-    parser_buffer.capacity = 0;
+    download_arena_log_stats();
 
     printf("\n[INFO]: recipe_finder app is exiting normally.\n\n");
 
@@ -1169,6 +2494,51 @@ static size_t get_free_memory(void) {
 // ---------------------------------------------------------------------------
 
 
+// Returns the free memory reading of get_free_memory(), cached for
+// FREE_MEMORY_SAMPLE_INTERVAL_US so that download threads growing their
+// buffers at the same time do not each make a system call.
+// Free RAM changes slowly compared to a page download, so a reading that
+// is a second or two old is just as useful as a fresh one.
+
+static size_t get_free_memory_cached(void) {
+    gint64 now = g_get_monotonic_time();
+
+    g_mutex_lock(&g_free_memory_sampler.lock);
+    if (g_free_memory_sampler.sampled_at == 0 ||
+        now - g_free_memory_sampler.sampled_at >= FREE_MEMORY_SAMPLE_INTERVAL_US) {
+        g_free_memory_sampler.free_bytes = get_free_memory();
+        g_free_memory_sampler.sampled_at = now;
+    }
+    size_t free_bytes = g_free_memory_sampler.free_bytes;
+    g_mutex_unlock(&g_free_memory_sampler.lock);
+
+    return free_bytes;
+}
+
+
+// --------------------------------
+
+
+// Turns a soft result limit (MAX_RESULTS, MAX_ALL_SITES_RESULTS) into the
+// limit a search actually uses: no more results than fit in the result
+// memory budget, which is itself capped by a share of the free RAM.
+// Never returns less than RESULT_MIN_LIMIT (or 'wanted', if smaller).
+
+static gint result_limit_for_memory(gint wanted) {
+    size_t budget = RESULT_MEMORY_BUDGET_BYTES;
+    size_t free_bytes = get_free_memory_cached();
+    if (free_bytes > 0) {
+        budget = MIN(budget, free_bytes / RESULT_MEMORY_FREE_RAM_SHARE);
+    }
+
+    size_t cap = MAX(budget / RESULT_ESTIMATED_BYTES, (size_t)RESULT_MIN_LIMIT);
+    return (gint)MIN((size_t)wanted, cap);
+}
+
+
+// ---------------------------------------------------------------------------
+
+
 /* Memory Helper for Recipe Parsers ------------------------------------------
  * Callback used by libcurl to write downloaded data chunks into a dynamically
  * growing memory buffer. Doubles capacity as needed, checking memory safety.
@@ -1184,8 +2554,12 @@ static size_t get_free_memory(void) {
  *   unnecessary. After each write, the buffer is explicitly null-terminated
  *   at the end of valid data, ensuring string safety without the overhead
  *   of zeroing unused buffer space, especially important as the buffer grows.
- * - The buffer address (m->data) may change after realloc, which is tracked
- *   and reported for debugging and performance insights.
+ * - An empty MemoryBlock first takes a recycled buffer from the download
+ *   buffer pool (see download_buffer_acquire), so most downloads never
+ *   reallocate at all.
+ * - The free memory check uses get_free_memory_cached(), not a system call
+ *   on every growth, and growth is no longer reported on stdout (it ran
+ *   several times per page on every concurrent download thread).
  * - This approach simplifies memory management by combining allocation and
  *   resizing in one step, with safety checks for max sizes and memory limits.
  */
@@ -1219,16 +2593,15 @@ static size_t memory_write_callback(void *contents, size_t sz, size_t nm, void *
         return 0;
     }
 
+    // First chunk of an empty block: take a buffer from the pool
+    if (!m->data && !download_buffer_acquire(m, required_size)) {
+        return 0;
+    }
+
     // Resize if needed
     if (required_size > m->capacity) {
-        size_t old_capacity = m->capacity;
         size_t new_capacity = (m->capacity > 0) ? m->capacity : DEFAULT_MEMORY_PARSER_SIZE;
 
-        if (new_capacity == 0) {
-            fprintf(stderr, "memory_write_callback: initial_parser_ram_capacity not set!\n");
-            return 0;
-        }
-
         while (new_capacity < required_size) {
             if (new_capacity > MAX_DOWNLOAD_SIZE / 2) {
                 new_capacity = MAX_DOWNLOAD_SIZE;
@@ -1237,7 +2610,7 @@ static size_t memory_write_callback(void *contents, size_t sz, size_t nm, void *
             new_capacity *= 2;
         }
 
-        size_t free_mem = get_free_memory();
+        size_t free_mem = get_free_memory_cached();
 
         if (free_mem < new_capacity) {
             fprintf(stderr, "memory_write_callback: Insufficient free memory to expand buffer to %zu bytes (free memory: %zu bytes)\n",
@@ -1253,43 +2626,6 @@ static size_t memory_write_callback(void *contents, size_t sz, size_t nm, void *
 
         m->data = new_data;
         m->capacity = new_capacity;
-
-        /*
-         * Display Memory Allocation Growth Status
-         *   Note on memory reporting:
-         * - Small reallocations may not visibly reduce system memory due to
-         *   OS caching.
-         * - The OS virtualizes memory and reuses internal allocator pools, so
-         *   realloc / malloc calls may not noticeably affect system-level free
-         *   memory readings, especially for small (KB-scale) allocations used
-         *   by the recipe parsers.
-         * - The free memory value logged here is coarse-grained and may appear
-         *   unchanged even though memory is actively being allocated and used.
-         * - Cumulative Bytes Needed represents the total buffer size required to
-         *   hold all downloaded data so far, including the current chunk. This is
-         *   not just the size of the current chunk but the entire memory footprint
-         *   accumulated at this point.
-         * - Buffer Address is the actual memory address of the dynamically allocated
-         *   buffer (m->data) used to store the downloaded recipe content. If realloc
-         *   moves the buffer during resizing (because in-place growth isn't
-         *   possible), the address will change. This allows tracking of buffer
-         *   relocation and helps with debugging and performance tuning.
-         */
-
-        printf("\nRECIPE PARSER DYNAMIC MEMORY ALLOCATION STATUS:\n\n"
-               " >>> WEBSITE:                 %s\n"
-               "     Capacity Before Resize:    %.1f KB\n"
-               "     Cumulative Bytes Needed:   %.1f KB\n"
-               "     Capacity After Resize:     %.1f KB\n"
-               "     Buffer Address:            %p\n"
-               "     Detected Free Memory:      %.2f MB\n",
-               g_current_website_name ? g_current_website_name : "(unknown)",
-               (double)old_capacity / 1024.0,
-               (double)required_size / 1024.0,
-               (double)new_capacity / 1024.0,
-               (void *)m->data,
-               (double)free_mem / (1024.0 * 1024.0));
-        printf("\n------------------------------------------------\n");
     }
 
     memcpy(m->data + m->size, contents, realsize);
@@ -1300,37 +2636,300 @@ static size_t memory_write_callback(void *contents, size_t sz, size_t nm, void *
 }
 
 
-// ==============
-// ==================
-// ===============
-
+// ---------------------------------------------------------------------------
 
-/* ---------------------------------------------------------------------------
-* Playwright / Software Package Installation Status
-* ---------------------------------------------------------------------------
-*
-* Verifies at startup via a GTK splash screen if required runtime software
-* dependencies are installed. 
-* If all dependencies are verified, a marker file is written, allowing
-* future launches to bypass this check for faster app startup. 
-* If any dependency is missing or invalid, the user is alerted via
-* GTK dialogs, and the splash remains open until manually dismissed.
-*
-* Specific software dependencies checked:
-*   - Node.js (must be in the system PATH so the app can invoke Node and npm)
-*   - Global npm packages: playwright, cheerio, axios
-*   - Playwright browser install (via 'npx playwright install', includes Chromium)
-*
-*   Note: Global npm packages and Playwright browsers do not need PATH
-*   entries; they are accessed via Node scripts.
-*
-* For implementation details, see:
-*   - check_node_installed_gtk()
-*   - check_npm_package_installed_gtk()
-*   - check_playwright_browsers_gtk()
-*
-* ---------------------------------------------------------------------------
-*/
+
+/*
+ * DOWNLOAD BUFFER POOL NOTES:
+ *
+ * HTTP response bodies are collected in MemoryBlocks whose storage comes
+ * from a small process-wide pool rather than from realloc(NULL, ...):
+ * - download_buffer_acquire() hands an empty MemoryBlock the smallest idle
+ *   buffer that is big enough, or the biggest idle one (which will then
+ *   only need a few doublings), and only mallocs when the pool is empty.
+ * - http_body_write_callback() passes the response's Content-Length as the
+ *   minimum size, so a page whose length is known is received into one
+ *   buffer without any reallocation. Compressed responses report the
+ *   encoded length, so for those it is a lower bound and the buffer may
+ *   still grow once or twice.
+ * - download_buffer_release() keeps up to DOWNLOAD_BUFFER_POOL_SLOTS buffers
+ *   of at most DOWNLOAD_BUFFER_MAX_POOLED bytes; anything else is freed so
+ *   one huge page does not stay resident for the life of the app.
+ */
+
+
+// Gives an empty MemoryBlock a buffer of at least min_capacity bytes,
+// reusing an idle pooled buffer when one is available.
+// Returns FALSE if no buffer could be allocated.
+
+static gboolean download_buffer_acquire(MemoryBlock *m, size_t min_capacity) {
+    g_mutex_lock(&g_download_pool.lock);
+
+    // Smallest idle buffer that fits, else the biggest one we have
+    int best = -1;
+    for (guint i = 0; i < g_download_pool.n_idle; i++) {
+        size_t cap = g_download_pool.idle[i].capacity;
+        if (best < 0) {
+            best = (int)i;
+            continue;
+        }
+        size_t best_cap = g_download_pool.idle[best].capacity;
+        gboolean fits = cap >= min_capacity;
+        gboolean best_fits = best_cap >= min_capacity;
+        if ((fits && (!best_fits || cap < best_cap)) || (!fits && !best_fits && cap > best_cap)) {
+            best = (int)i;
+        }
+    }
+
+    if (best >= 0) {
+        *m = g_download_pool.idle[best];
+        g_download_pool.idle[best] = g_download_pool.idle[--g_download_pool.n_idle];
+        g_download_pool.reused++;
+        g_mutex_unlock(&g_download_pool.lock);
+
+        m->size = 0;
+        m->data[0] = '\0';
+        return TRUE;
+    }
+
+    g_download_pool.allocated++;
+    g_mutex_unlock(&g_download_pool.lock);
+
+    size_t capacity = MAX(min_capacity, (size_t)DEFAULT_MEMORY_PARSER_SIZE);
+    if (capacity > MAX_DOWNLOAD_SIZE) {
+        capacity = MAX_DOWNLOAD_SIZE;
+    }
+
+    size_t free_mem = get_free_memory_cached();
+    if (free_mem < capacity) {
+        fprintf(stderr, "[WARNING]: Not enough free memory for a %zu byte download buffer (free memory: %zu bytes)\n",
+                capacity, free_mem);
+        return FALSE;
+    }
+
+    m->data = malloc(capacity);
+    if (!m->data) {
+        fprintf(stderr, "[ERROR]: Failed to allocate a %zu byte download buffer\n", capacity);
+        m->capacity = 0;
+        m->size = 0;
+        return FALSE;
+    }
+    m->capacity = capacity;
+    m->size = 0;
+    m->data[0] = '\0';
+    return TRUE;
+}
+
+
+// --------------------------------
+
+
+// Returns a MemoryBlock's buffer to the download buffer pool (or frees it
+// if the pool is full or the buffer is too big to keep) and empties the
+// block. Safe to call on an empty block.
+
+static void download_buffer_release(MemoryBlock *m) {
+    if (!m || !m->data) return;
+
+    gboolean pooled = FALSE;
+    if (m->capacity <= DOWNLOAD_BUFFER_MAX_POOLED) {
+        g_mutex_lock(&g_download_pool.lock);
+        if (g_download_pool.n_idle < DOWNLOAD_BUFFER_POOL_SLOTS) {
+            g_download_pool.idle[g_download_pool.n_idle].data = m->data;
+            g_download_pool.idle[g_download_pool.n_idle].capacity = m->capacity;
+            g_download_pool.idle[g_download_pool.n_idle].size = 0;
+            g_download_pool.n_idle++;
+            pooled = TRUE;
+        }
+        g_mutex_unlock(&g_download_pool.lock);
+    }
+
+    if (!pooled) {
+        free(m->data);
+    }
+
+    m->data = NULL;
+    m->size = 0;
+    m->capacity = 0;
+}
+
+
+// --------------------------------
+
+
+// Grows a MemoryBlock's buffer up front to at least min_capacity bytes
+// (used when Content-Length says the page will not fit). The contents
+// are kept. Returns FALSE if memory is short or realloc fails.
+
+static gboolean download_buffer_reserve(MemoryBlock *m, size_t min_capacity) {
+    if (m->capacity >= min_capacity) return TRUE;
+
+    size_t free_mem = get_free_memory_cached();
+    if (free_mem < min_capacity) {
+        fprintf(stderr, "[WARNING]: Not enough free memory to grow a download buffer to %zu bytes (free memory: %zu bytes)\n",
+                min_capacity, free_mem);
+        return FALSE;
+    }
+
+    char *new_data = realloc(m->data, min_capacity);
+    if (!new_data) {
+        fprintf(stderr, "[ERROR]: Failed to grow a download buffer to %zu bytes\n", min_capacity);
+        return FALSE;
+    }
+    m->data = new_data;
+    m->capacity = min_capacity;
+    return TRUE;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+/*
+ * DOWNLOAD ARENA NOTES:
+ *
+ * download_html() does not hand out a new buffer per page. Each thread that
+ * downloads pages owns one DownloadArena (kept in a GPrivate):
+ * - The arena is created on the thread's first download with a pooled
+ *   buffer of g_download_arena_capacity bytes, the RAM tier picked by
+ *   detect_initial_capacity() (16 KB / 64 KB / 256 KB).
+ * - The page is received straight into the arena (on the HTTP engine
+ *   thread, while the owning thread waits), and the caller reads it there.
+ * - download_arena_reset() only sets the size back to 0. The capacity stays,
+ *   so once an arena has grown to fit a site's pages, later fetches on that
+ *   thread need no realloc or copy at all.
+ * - Each arena remembers its high-water mark, and the process-wide maximum
+ *   is logged whenever it rises and again at exit, which shows whether the
+ *   RAM tier is a good starting size for the sites in use.
+ * - When the thread exits, download_arena_free() returns the buffer to the
+ *   download buffer pool, so the next search thread starts warm.
+ * - download_html() is the only C fetch that buffers a whole body, so every
+ *   buffered download goes through an arena: the prefetched search pages of
+ *   SITE_NEEDS_PREFETCHED_DOM parsers, the JSON search APIs
+ *   (run_json_endpoint) and the page tiers of run_site_escalation(). The
+ *   streaming parsers (http_stream_anchors) keep no body at all, and the
+ *   Node.js scripts fetch inside the scraper worker.
+ */
+
+
+// Returns the calling thread's download arena, creating it (seeded with
+// g_download_arena_capacity bytes) on first use. Returns NULL only if the
+// seed buffer could not be allocated.
+
+static DownloadArena *download_arena_get(void) {
+    DownloadArena *arena = g_private_get(&g_download_arena);
+    if (arena) return arena;
+
+    arena = g_new0(DownloadArena, 1);
+    if (!download_buffer_acquire(&arena->block, g_download_arena_capacity)) {
+        g_free(arena);
+        return NULL;
+    }
+    g_private_set(&g_download_arena, arena);
+
+    g_mutex_lock(&g_download_arena_stats.lock);
+    g_download_arena_stats.arenas++;
+    g_mutex_unlock(&g_download_arena_stats.lock);
+
+    return arena;
+}
+
+
+// --------------------------------
+
+
+// Marks the calling thread's arena as free again once the caller is done
+// with the page from download_html(). The buffer is kept (not freed); only
+// the high-water metrics are updated.
+
+static void download_arena_reset(void) {
+    DownloadArena *arena = g_private_get(&g_download_arena);
+    if (!arena) return;
+
+    size_t used = arena->block.size;
+    if (used > arena->high_water) {
+        arena->high_water = used;
+    }
+
+    gboolean new_high = FALSE;
+    g_mutex_lock(&g_download_arena_stats.lock);
+    if (used > g_download_arena_stats.high_water) {
+        g_download_arena_stats.high_water = used;
+        new_high = TRUE;
+    }
+    g_mutex_unlock(&g_download_arena_stats.lock);
+
+    if (new_high) {
+        printf("[INFO]: Download arena high-water mark is now %.1f KB (arena capacity %.1f KB).\n",
+               used / 1024.0, arena->block.capacity / 1024.0);
+    }
+
+    arena->block.size = 0;
+    if (arena->block.data) {
+        arena->block.data[0] = '\0';
+    }
+}
+
+
+// --------------------------------
+
+
+// GPrivate destroy notify: gives an exiting thread's arena buffer back to
+// the download buffer pool.
+
+static void download_arena_free(gpointer data) {
+    DownloadArena *arena = data;
+    if (!arena) return;
+    download_buffer_release(&arena->block);
+    g_free(arena);
+}
+
+
+// --------------------------------
+
+
+// Logs the download arena metrics collected during this run.
+
+static void download_arena_log_stats(void) {
+    g_mutex_lock(&g_download_arena_stats.lock);
+    printf("[INFO]: Download arenas: %u created, %u pages, %u needed to grow, high-water mark %.1f KB (seed %.1f KB).\n",
+           g_download_arena_stats.arenas, g_download_arena_stats.fetches, g_download_arena_stats.grown,
+           g_download_arena_stats.high_water / 1024.0, g_download_arena_capacity / 1024.0);
+    g_mutex_unlock(&g_download_arena_stats.lock);
+}
+
+
+// ==============
+// ==================
+// ===============
+
+
+/* ---------------------------------------------------------------------------
+* Playwright / Software Package Installation Status
+* ---------------------------------------------------------------------------
+*
+* Verifies at startup via a GTK splash screen if required runtime software
+* dependencies are installed. 
+* If all dependencies are verified, a marker file is written, allowing
+* future launches to bypass this check for faster app startup. 
+* If any dependency is missing or invalid, the user is alerted via
+* GTK dialogs, and the splash remains open until manually dismissed.
+*
+* Specific software dependencies checked:
+*   - Node.js (must be in the system PATH so the app can invoke Node and npm)
+*   - Global npm package: playwright
+*   - Playwright browser install (via 'npx playwright install', includes Chromium)
+*
+*   Note: Global npm packages and Playwright browsers do not need PATH
+*   entries; they are accessed via Node scripts.
+*
+* For implementation details, see:
+*   - check_node_installed_gtk()
+*   - check_npm_package_installed_gtk()
+*   - check_playwright_browsers_gtk()
+*
+* ---------------------------------------------------------------------------
+*/
 
 // Checks if all software package dependencies are OK
 static bool software_package_dependencies_OK(void) {
@@ -1369,7 +2968,7 @@ GtkWidget* create_splash_window_with_software_checks(DependencyCheckFunc check_f
 
     GtkWidget *dep_list = gtk_label_new(
         "  - Node.js runtime\n"
-        "  - npm packages: playwright, cheerio, axios\n"
+        "  - npm package: playwright\n"
         "  - Playwright browser install: Chromium");
     gtk_widget_set_halign(dep_list, GTK_ALIGN_START);
     gtk_label_set_xalign(GTK_LABEL(dep_list), 0.0f);
@@ -1580,7 +3179,7 @@ static gboolean check_js_dependencies_gtk(GtkWindow *parent) {
         return FALSE;
     }
 
-    const char *deps[] = {"playwright", "cheerio", "axios"};
+    const char *deps[] = {"playwright"};
     for (size_t i = 0; i < G_N_ELEMENTS(deps); i++) {
         if (!check_npm_package_installed_gtk(parent, deps[i], &error_msg)) {
             GtkWidget *dlg = gtk_message_dialog_new(parent,
@@ -1669,6 +3268,205 @@ static char* get_dependency_marker_path(void) {
 }
 
 
+// ---------------------------------------------------------------------------
+
+
+// Resolves the runtime environment used by every JavaScript parser: the node
+// executable, the global npm module root and the Playwright browser folder.
+// Parsers used to spawn "npm root -g" and "node --version" on every search;
+// now this runs once at startup. The result is cached in
+// RUNTIME_ENV_CACHE_FILE next to the dependency marker and only probed again
+// after a dependency check ('refresh') or when the cached paths no longer
+// exist. It is handed to child processes through the environment:
+//   - NODE_PATH gets the global module root prepended, so require() finds
+//     playwright without asking npm
+//   - RUNTIME_ENV_NPM_ROOT_ENV carries the root for the scraper worker
+//   - PLAYWRIGHT_BROWSERS_PATH points at the browser install (unless the
+//     user already set it)
+// Called from main() before the HTTP engine and scraper worker threads are
+// started, since g_setenv() is not thread-safe.
+
+static void runtime_env_init(gboolean refresh) {
+    char *marker_path = get_dependency_marker_path();
+    char *folder_path = g_path_get_dirname(marker_path);
+    char *cache_path = g_build_filename(folder_path, RUNTIME_ENV_CACHE_FILE, NULL);
+
+    if (refresh || !runtime_env_load(&g_runtime_env, cache_path)) {
+        runtime_env_probe(&g_runtime_env);
+        runtime_env_save(&g_runtime_env, cache_path);
+    }
+
+    printf("[INFO]: Runtime: node %s (%s), modules %s, browsers %s\n",
+           g_runtime_env.node_version ? g_runtime_env.node_version : "?",
+           g_runtime_env.node_binary ? g_runtime_env.node_binary : "from PATH",
+           g_runtime_env.npm_root ? g_runtime_env.npm_root : "unknown",
+           g_runtime_env.browsers_path ? g_runtime_env.browsers_path : "default");
+
+    if (g_runtime_env.npm_root) {
+        const char *node_path = g_getenv("NODE_PATH");
+        char *value = (node_path && *node_path)
+            ? g_strconcat(g_runtime_env.npm_root, G_SEARCHPATH_SEPARATOR_S, node_path, NULL)
+            : g_strdup(g_runtime_env.npm_root);
+        g_setenv("NODE_PATH", value, TRUE);
+        g_setenv(RUNTIME_ENV_NPM_ROOT_ENV, g_runtime_env.npm_root, TRUE);
+        g_free(value);
+    }
+    if (g_runtime_env.browsers_path) {
+        g_setenv("PLAYWRIGHT_BROWSERS_PATH", g_runtime_env.browsers_path, FALSE);
+    }
+
+    g_free(cache_path);
+    g_free(folder_path);
+    g_free(marker_path);
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Probes the runtime environment (two short process launches: node -v and
+// npm root -g). Fields that cannot be resolved are left NULL, in which case
+// node is started from the PATH and Playwright uses its own defaults.
+
+static void runtime_env_probe(RuntimeEnv *env) {
+    g_clear_pointer(&env->node_binary, g_free);
+    g_clear_pointer(&env->node_version, g_free);
+    g_clear_pointer(&env->npm_root, g_free);
+    g_clear_pointer(&env->browsers_path, g_free);
+
+    printf("[INFO]: Probing the Node.js runtime environment...\n");
+
+    env->node_binary = g_find_program_in_path("node");
+
+    gchar *output = NULL;
+    const gchar *node_argv[] = { env->node_binary ? env->node_binary : "node", "-v", NULL };
+    if (g_spawn_sync(NULL, (gchar **)node_argv, NULL, G_SPAWN_SEARCH_PATH | G_SPAWN_STDERR_TO_DEV_NULL,
+                     NULL, NULL, &output, NULL, NULL, NULL) && output && output[0] == 'v') {
+        env->node_version = g_strdup(g_strstrip(output));
+    }
+    g_free(output);
+
+    output = NULL;
+    if (g_spawn_command_line_sync("npm root -g", &output, NULL, NULL, NULL) && output) {
+        g_strstrip(output);
+        if (g_file_test(output, G_FILE_TEST_IS_DIR)) {
+            env->npm_root = g_strdup(output);
+        }
+    }
+    g_free(output);
+
+    // Playwright's browser folder: an explicit setting, else its per-user default
+    const char *configured = g_getenv("PLAYWRIGHT_BROWSERS_PATH");
+    char *browsers = NULL;
+    if (configured && *configured) {
+        browsers = g_strdup(configured);
+    } else {
+#if defined(_WIN32)
+        const char *local_app_data = g_getenv("LOCALAPPDATA");
+        browsers = local_app_data ? g_build_filename(local_app_data, "ms-playwright", NULL) : NULL;
+#elif defined(__APPLE__)
+        browsers = g_build_filename(g_get_home_dir(), "Library", "Caches", "ms-playwright", NULL);
+#else
+        browsers = g_build_filename(g_get_user_cache_dir(), "ms-playwright", NULL);
+#endif
+    }
+    if (browsers && g_file_test(browsers, G_FILE_TEST_IS_DIR)) {
+        env->browsers_path = browsers;
+    } else {
+        g_free(browsers);
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Loads the cached runtime environment from 'path'. Returns FALSE (and
+// leaves 'env' untouched) if the cache is missing, from another version, or
+// refers to a node executable or module root that no longer exists.
+
+static gboolean runtime_env_load(RuntimeEnv *env, const char *path) {
+    char *contents = NULL;
+    if (!g_file_get_contents(path, &contents, NULL, NULL))
+        return FALSE;
+
+    struct json_object *root = json_tokener_parse(contents);
+    g_free(contents);
+
+    struct json_object *version = NULL, *node = NULL, *node_version = NULL, *npm_root = NULL, *browsers = NULL;
+    if (!root ||
+        !json_object_object_get_ex(root, "version", &version) ||
+        json_object_get_int(version) != RUNTIME_ENV_CACHE_VERSION ||
+        !json_object_object_get_ex(root, "node", &node) ||
+        !json_object_object_get_ex(root, "npm_root", &npm_root) ||
+        !json_object_is_type(node, json_type_string) ||
+        !json_object_is_type(npm_root, json_type_string) ||
+        !g_file_test(json_object_get_string(node), G_FILE_TEST_IS_EXECUTABLE) ||
+        !g_file_test(json_object_get_string(npm_root), G_FILE_TEST_IS_DIR)) {
+        fprintf(stderr, "[WARNING]: Runtime environment cache %s is missing or stale.\n", path);
+        json_object_put(root);
+        return FALSE;
+    }
+
+    env->node_binary = g_strdup(json_object_get_string(node));
+    env->npm_root = g_strdup(json_object_get_string(npm_root));
+    if (json_object_object_get_ex(root, "node_version", &node_version) &&
+        json_object_is_type(node_version, json_type_string)) {
+        env->node_version = g_strdup(json_object_get_string(node_version));
+    }
+    if (json_object_object_get_ex(root, "browsers_path", &browsers) &&
+        json_object_is_type(browsers, json_type_string) &&
+        g_file_test(json_object_get_string(browsers), G_FILE_TEST_IS_DIR)) {
+        env->browsers_path = g_strdup(json_object_get_string(browsers));
+    }
+
+    json_object_put(root);
+    return TRUE;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Writes the runtime environment cache to 'path'. An environment without a
+// resolved node or module root is not cached, so the next launch probes again.
+
+static void runtime_env_save(const RuntimeEnv *env, const char *path) {
+    if (!env->node_binary || !env->npm_root)
+        return;
+
+    struct json_object *root = json_object_new_object();
+    json_object_object_add(root, "version", json_object_new_int(RUNTIME_ENV_CACHE_VERSION));
+    json_object_object_add(root, "node", json_object_new_string(env->node_binary));
+    json_object_object_add(root, "node_version", json_object_new_string(env->node_version ? env->node_version : ""));
+    json_object_object_add(root, "npm_root", json_object_new_string(env->npm_root));
+    if (env->browsers_path) {
+        json_object_object_add(root, "browsers_path", json_object_new_string(env->browsers_path));
+    }
+    json_object_object_add(root, "probed", json_object_new_int64(g_get_real_time() / G_USEC_PER_SEC));
+
+    GError *error = NULL;
+    if (!g_file_set_contents(path, json_object_to_json_string_ext(root, JSON_C_TO_STRING_PRETTY), -1, &error)) {
+        fprintf(stderr, "[WARNING]: Could not write runtime environment cache %s: %s\n",
+                path, error ? error->message : "unknown error");
+        g_clear_error(&error);
+    }
+
+    json_object_put(root);
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Node executable to launch: the resolved absolute path, or "node" (looked
+// up in the PATH) if the probe could not find it.
+
+static const char *runtime_env_node(void) {
+    return g_runtime_env.node_binary ? g_runtime_env.node_binary : "node";
+}
+
+
 // ==============
 // ==================
 // ===============
@@ -1731,1753 +3529,7198 @@ else return HIGH_CAPACITY_PARSER_RAM_KB;
 // ------------------------------------------------------
 
 
-// Dynamically allocates memory (via realloc inside memory_write_callback)
-// and stores the results in chunk.data.
+// Downloads a page into the calling thread's download arena (grown inside
+// memory_write_callback when needed).
 // The combination of download_html + memory_write_callback fetches the
 // entire HTML document from the web and creates a single, null-terminated
-//  string containing it, no matter how big it is.
+//  string containing it (page->data), no matter how big it is.
+// The transfer runs on the shared HTTP engine, so a warm connection to the
+// site (and its DNS and TLS session) is reused when one is available.
+// On success *page is a view of the arena: it stays valid until the caller
+// calls download_arena_reset() (which it must do when finished) or
+// downloads another page on this thread. Returns FALSE on failure, or if
+// the search was cancelled while the page was downloading.
+
+static gboolean download_html(const char *url, SearchContext *search, MemoryBlock *page) {
+    DownloadArena *arena = download_arena_get();
+    if (!arena) return FALSE;
+
+    HttpRequest *request = http_request_new(url, 15L, search);
+    if (!request) return FALSE;
+
+    // Lend the arena's buffer to the request, then take it back
+    size_t capacity_before = arena->block.capacity;
+    arena->block.size = 0;
+    request->body = arena->block;
+    arena->block = (MemoryBlock){ .data = NULL, .size = 0, .capacity = 0 };
+
+    gboolean ok = http_perform_blocking(request);
+
+    arena->block = request->body;
+    request->body = (MemoryBlock){ .data = NULL, .size = 0, .capacity = 0 };
+    http_request_free(request);
+
+    g_mutex_lock(&g_download_arena_stats.lock);
+    g_download_arena_stats.fetches++;
+    if (arena->block.capacity > capacity_before) {
+        g_download_arena_stats.grown++;
+    }
+    g_mutex_unlock(&g_download_arena_stats.lock);
+    arena->fetches++;
+
+    if (!ok || !arena->block.data) {
+        download_arena_reset();
+        return FALSE;
+    }
 
-static char* download_html(const char *url) {
-    CURL *curl = curl_easy_init();
-    if (!curl) return NULL;
+    *page = arena->block;
+    return TRUE;
+}
 
-    MemoryBlock chunk = {.data = NULL, .size = 0, .capacity = 0};
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT,
-        "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 Chrome/124.0.0.0 Safari/537.36");
-    curl_easy_setopt(curl, CURLOPT_REFERER, url);
-    curl_easy_setopt(curl, CURLOPT_COOKIEFILE, "");
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 15L);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, memory_write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &chunk);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+// ------------------------------------------------------
+// ------------------------------------------------------
 
-    CURLcode rc = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
 
-    if (rc != CURLE_OK) {
-        free(chunk.data);
-        return NULL;
+/*
+ * SHARED HTTP ENGINE NOTES:
+ *
+ * Every HTTP request made from C (download_html, http_stream_anchors) runs
+ * on one process-wide curl multi handle, driven by a single engine thread.
+ * - Search threads never perform transfers themselves: they queue an
+ *   HttpRequest with http_engine_submit() and either get a completion
+ *   callback (async) or block in http_perform_blocking() until it is done (sync).
+ * - Easy handles are attached to a CURLSH share object that keeps open
+ *   connections, DNS lookups and TLS session tickets. A second search on
+ *   the same site therefore skips the DNS, TCP and TLS handshakes.
+ * - HTTP/2 is requested over TLS, and CURLOPT_PIPEWAIT lets concurrent
+ *   requests to one host ("All Sites" searches) multiplex over a single
+ *   connection instead of opening new ones.
+ * - Completion callbacks run on the engine thread, so they must be short
+ *   and must not touch GTK (use g_idle_add for UI work).
+ */
+
+
+// Starts the shared HTTP engine.
+// Creates the share object and multi handle and launches the engine thread.
+// Must be called after curl_global_init(). Returns FALSE on failure.
+
+static gboolean http_engine_start(void) {
+    g_mutex_lock(&g_http_engine.lock);
+
+    if (g_http_engine.running) {
+        g_mutex_unlock(&g_http_engine.lock);
+        return TRUE;
+    }
+
+    g_http_engine.share = curl_share_init();
+    g_http_engine.multi = curl_multi_init();
+    if (!g_http_engine.share || !g_http_engine.multi) {
+        fprintf(stderr, "[ERROR]: Could not create the curl share/multi handles.\n");
+        if (g_http_engine.multi) curl_multi_cleanup(g_http_engine.multi);
+        if (g_http_engine.share) curl_share_cleanup(g_http_engine.share);
+        g_http_engine.multi = NULL;
+        g_http_engine.share = NULL;
+        g_mutex_unlock(&g_http_engine.lock);
+        return FALSE;
     }
 
-    return chunk.data;  // Must be freed by caller
+    // Share connections, DNS results and TLS sessions between all transfers
+    curl_share_setopt(g_http_engine.share, CURLSHOPT_LOCKFUNC, http_share_lock);
+    curl_share_setopt(g_http_engine.share, CURLSHOPT_UNLOCKFUNC, http_share_unlock);
+    curl_share_setopt(g_http_engine.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(g_http_engine.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(g_http_engine.share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+
+    // Multiplex HTTP/2 streams; cap parallel connections per host otherwise
+    curl_multi_setopt(g_http_engine.multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(g_http_engine.multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)HTTP_MAX_HOST_CONNECTIONS);
+
+    g_queue_init(&g_http_engine.incoming);
+    g_http_engine.stopping = FALSE;
+    g_http_engine.running = TRUE;
+    g_http_engine.thread = g_thread_new("http_engine", http_engine_thread, NULL);
+
+    printf("[INFO]: HTTP engine started (%s).\n", curl_version());
+
+    g_mutex_unlock(&g_http_engine.lock);
+    return TRUE;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Adds a safe HTML link to the returned recipes using g_list_append.
-// Uses GHashTable deduplication for unique recipe links.
+// Stops the shared HTTP engine at app exit.
+// Unfinished transfers are completed with CURLE_ABORTED_BY_CALLBACK so no
+// waiting thread is left hanging, then all curl handles are released.
 
-static void add_link(GList **out, const char* title, const char* base_url, const char* href, GHashTable *link_set) {
-    if (recipe_result_total >= MAX_RESULTS) {
-        return;  // Limit reached, skip adding more recipe links
+static void http_engine_stop(void) {
+    g_mutex_lock(&g_http_engine.lock);
+    if (!g_http_engine.running) {
+        g_mutex_unlock(&g_http_engine.lock);
+        return;
     }
+    g_http_engine.stopping = TRUE;
+    GThread *thread = g_http_engine.thread;
+    g_http_engine.thread = NULL;
+    g_mutex_unlock(&g_http_engine.lock);
 
-    // Make a mutable copy of the title so we can format it
-    char temp_title[512];
-    snprintf(temp_title, sizeof(temp_title), "%s", title);
+    curl_multi_wakeup(g_http_engine.multi);
+    g_thread_join(thread);
 
-    // Capitalize each word in the title
-    capitalize_each_word(temp_title);
+    g_mutex_lock(&g_http_engine.lock);
+    curl_multi_cleanup(g_http_engine.multi);
+    curl_share_cleanup(g_http_engine.share);
+    g_http_engine.multi = NULL;
+    g_http_engine.share = NULL;
+    g_http_engine.running = FALSE;
+    g_mutex_unlock(&g_http_engine.lock);
+}
 
-    // Sanitize for HTML safety
-    char *safe_title = sanitize_string(temp_title);
-    char *safe_href = sanitize_string(href);
 
-    // Build the full URL
-    char *full_url = g_strdup_printf("%s%s", base_url, safe_href);
+// --------------------------------
 
-    // Add link if it's not a duplicate
-    if (!g_hash_table_contains(link_set, full_url)) {
-        char *entry = g_strdup_printf("%s\x1f%s", safe_title, full_url);
-        *out = g_list_append(*out, entry);
-        g_hash_table_add(link_set, full_url);
-        recipe_result_total++;  // Count only successful additions
-    } else {
-        g_free(full_url);  // Discard duplicate
+
+// Hands a finished (or aborted) request to its completion function.
+// Runs on the engine thread.
+
+static void http_request_complete(HttpRequest *request, CURLcode result) {
+    request->result = result;
+    curl_easy_getinfo(request->easy, CURLINFO_RESPONSE_CODE, &request->response_code);
+
+    long new_connections = 0;
+    double total_time = 0.0;
+    curl_easy_getinfo(request->easy, CURLINFO_NUM_CONNECTS, &new_connections);
+    curl_easy_getinfo(request->easy, CURLINFO_TOTAL_TIME, &total_time);
+    printf("[INFO]: HTTP %ld for %s (%s connection, %.0f ms)\n",
+           request->response_code, request->url,
+           new_connections == 0 ? "reused" : "new", total_time * 1000.0);
+
+    if (result == CURLE_ABORTED_BY_CALLBACK && search_context_is_cancelled(request->search)) {
+        printf("[INFO]: HTTP request cancelled: %s\n", request->url);
+    } else if (result != CURLE_OK) {
+        fprintf(stderr, "[WARNING]: HTTP request failed for %s: %s\n", request->url, curl_easy_strerror(result));
     }
 
-    // Clean up
-    g_free(safe_title);
-    g_free(safe_href);
+    request->on_complete(request, request->user_data);
 }
 
 
-// ------------------------------
+// --------------------------------
 
 
+// HTTP engine thread.
+// Adds newly submitted requests to the multi handle, drives all transfers,
+// and completes the ones that finished. curl_multi_poll() sleeps until a
+// socket is ready or http_engine_submit()/stop/search_context_cancel()
+// wakes it up.
+
+static gpointer http_engine_thread(gpointer data G_GNUC_UNUSED) {
+    GQueue active = G_QUEUE_INIT;
+
+    while (TRUE) {
+        g_mutex_lock(&g_http_engine.lock);
+        gboolean stopping = g_http_engine.stopping;
+        HttpRequest *request;
+        while ((request = g_queue_pop_head(&g_http_engine.incoming)) != NULL) {
+            if (stopping) {
+                g_mutex_unlock(&g_http_engine.lock);
+                http_request_complete(request, CURLE_ABORTED_BY_CALLBACK);
+                g_mutex_lock(&g_http_engine.lock);
+                continue;
+            }
+            curl_multi_add_handle(g_http_engine.multi, request->easy);
+            g_queue_push_tail(&active, request);
+        }
+        g_mutex_unlock(&g_http_engine.lock);
 
-// Helper: Trim leading and trailing spaces
-// Efficiently trims leading and trailing spaces from the input source, and
-// copies the trimmed result into the destination, adding a null terminator.
-// If the trimmed string is too long, it will be truncated safely.
-//
-// In most cases with typical recipe titles, no trimming is normally
-// needed, and 'src' is copied immediately to the 'dest' output buffer.
-//
-// If trimming is needed, the function uses pointers to scan the input:
-//   - It walks forward through input string 'src' to skip leading whitespace
-//   - It walks backward through 'src' to ignore trailing whitespace
-//
-// Note: This app does not use in-place processing (src == dest), so the
-// original string is not modified here.  This is safe for use in GTK apps
-// because it does not modify 'src', does not perform dynamic memory
-// allocation on the heap, and avoids freeing or interference with
-// GTK-managed string ownership.
+        if (stopping)
+            break;
 
-static void trim_whitespace(const char *src, char *dest, size_t dest_size) {
+        int still_running = 0;
+        curl_multi_perform(g_http_engine.multi, &still_running);
 
-    // Defensive check: ensure valid pointers and non-zero destination size.
-    if (!src || !dest || dest_size == 0) {
-        if (dest_size > 0) {
-            dest[0] = '\0';  // Null-terminate dest if possible.
+        CURLMsg *msg;
+        int msgs_left = 0;
+        while ((msg = curl_multi_info_read(g_http_engine.multi, &msgs_left)) != NULL) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+
+            CURL *easy = msg->easy_handle;
+            CURLcode result = msg->data.result;
+            HttpRequest *done_request = NULL;
+            curl_easy_getinfo(easy, CURLINFO_PRIVATE, (char **)&done_request);
+
+            curl_multi_remove_handle(g_http_engine.multi, easy);
+            g_queue_remove(&active, done_request);
+            http_request_complete(done_request, result);
         }
-        return;
+
+        curl_multi_poll(g_http_engine.multi, NULL, 0, HTTP_POLL_TIMEOUT_MS, NULL);
     }
 
-    // Walk forward from the start of 'src' to skip leading whitespace characters.
-    const char *start = src;
-    while (*start && isspace((unsigned char)*start)) {
-        start++;
+    // Abort whatever is still in flight
+    HttpRequest *request;
+    while ((request = g_queue_pop_head(&active)) != NULL) {
+        curl_multi_remove_handle(g_http_engine.multi, request->easy);
+        http_request_complete(request, CURLE_ABORTED_BY_CALLBACK);
     }
 
-    // Walk backward from the end of 'src' to find the last non-whitespace character.
-    const char *end = src + strlen(src);
-    while (end > start && isspace((unsigned char)*(end - 1))) {
-        end--;
+    return NULL;
+}
+
+
+// --------------------------------
+
+
+// Creates an HTTP GET request with the app's common options:
+// browser user agent, cookie engine, redirects, compression, HTTP/2 and
+// the shared connection cache. The body is collected by
+// http_body_write_callback into request->body.
+// When search is given, the transfer is aborted as soon as that search is
+// cancelled (see http_xferinfo_callback).
+// Returns NULL if curl could not create an easy handle.
+
+static HttpRequest *http_request_new(const char *url, long timeout_s, SearchContext *search) {
+    CURL *curl = curl_easy_init();
+    if (!curl) return NULL;
+
+    HttpRequest *request = g_new0(HttpRequest, 1);
+    request->easy = curl;
+    request->url = g_strdup(url);
+    request->body = (MemoryBlock){ .data = NULL, .size = 0, .capacity = 0 };
+    request->search = search ? search_context_ref(search) : NULL;
+    request->result = CURLE_OK;
+
+    curl_easy_setopt(curl, CURLOPT_URL, url);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, HTTP_USER_AGENT);
+    curl_easy_setopt(curl, CURLOPT_REFERER, url);
+    curl_easy_setopt(curl, CURLOPT_COOKIEFILE, "");
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_s);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, http_body_write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, request);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");  // Any encoding curl supports
+    curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);  // Prefer multiplexing over a new connection
+    curl_easy_setopt(curl, CURLOPT_SHARE, g_http_engine.share);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, request);
+    if (search) {
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, http_xferinfo_callback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, request);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    }
+
+    return request;
+}
+
+
+// --------------------------------
+
+
+// Frees a request and its easy handle, and returns any body it still
+// owns to the download buffer pool.
+
+static void http_request_free(HttpRequest *request) {
+    if (!request) return;
+    if (request->easy) curl_easy_cleanup(request->easy);
+    download_buffer_release(&request->body);
+    search_context_unref(request->search);
+    g_free(request->url);
+    g_free(request);
+}
+
+
+// --------------------------------
+
+
+// Queues a request on the HTTP engine (safe from any thread).
+// on_complete runs on the engine thread once the transfer is finished and
+// takes ownership of the request.
+// Returns FALSE (and leaves the request with the caller) if the engine is
+// not running.
+
+static gboolean http_engine_submit(HttpRequest *request, HttpCompletionFunc on_complete, gpointer user_data) {
+    request->on_complete = on_complete;
+    request->user_data = user_data;
+
+    g_mutex_lock(&g_http_engine.lock);
+    if (!g_http_engine.running || g_http_engine.stopping) {
+        g_mutex_unlock(&g_http_engine.lock);
+        fprintf(stderr, "[WARNING]: HTTP engine is not running; cannot fetch %s\n", request->url);
+        return FALSE;
     }
+    g_queue_push_tail(&g_http_engine.incoming, request);
+    g_mutex_unlock(&g_http_engine.lock);
 
-    size_t trimmed_len = (size_t)(end - start);
+    curl_multi_wakeup(g_http_engine.multi);
+    return TRUE;
+}
 
-    // Fast path: No leading or trailing spaces, and src != dest.
-    // Just copy src directly to dest and return early.
-    if (start == src && *end == '\0') {
-        if (src != dest) {
-            strncpy(dest, src, dest_size - 1);
-            dest[dest_size - 1] = '\0';  // Ensure null termination.
+
+// --------------------------------
+
+
+// Completion function used by http_perform_blocking(): wakes up the
+// waiting thread.
+
+static void http_fetch_done(HttpRequest *request, gpointer user_data G_GNUC_UNUSED) {
+    g_mutex_lock(&g_http_engine.lock);
+    request->done = TRUE;
+    g_cond_broadcast(&g_http_engine.cond);
+    g_mutex_unlock(&g_http_engine.lock);
+}
+
+
+// --------------------------------
+
+
+// libcurl write callback of engine requests.
+// On the first chunk, the response's Content-Length (if the server sent
+// one) is used to take (or grow a lent arena buffer to) a buffer that
+// already fits the whole body; the data itself is stored by
+// memory_write_callback.
+
+static size_t http_body_write_callback(void *contents, size_t sz, size_t nm, void *request_ptr) {
+    HttpRequest *request = (HttpRequest *)request_ptr;
+
+    if (!request->body_sized) {
+        request->body_sized = TRUE;
+
+        curl_off_t content_length = -1;
+        if (curl_easy_getinfo(request->easy, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &content_length) == CURLE_OK &&
+            content_length > 0 && content_length < MAX_DOWNLOAD_SIZE) {
+            size_t needed = request->body.size + (size_t)content_length + 1;
+            gboolean sized = request->body.data
+                ? download_buffer_reserve(&request->body, needed)
+                : download_buffer_acquire(&request->body, needed);
+            if (!sized) return 0;
         }
-        return;
     }
 
-    // Now we know trimming was done, so copy the trimmed substring safely.
+    return memory_write_callback(contents, sz, nm, &request->body);
+}
 
-    // Shorten trimmed_len if it exceeds the destination buffer size.
-    if (trimmed_len >= dest_size) {
-        trimmed_len = dest_size - 1;
-    }
 
-    // Copy the trimmed section of src into dest.
-    memcpy(dest, start, trimmed_len);
+// --------------------------------
 
-    // Null-terminate the destination string.
-    dest[trimmed_len] = '\0';
+
+// libcurl progress callback of requests that belong to a search.
+// Returning nonzero aborts the transfer with CURLE_ABORTED_BY_CALLBACK, so
+// a cancelled search frees its connection slot (and any half-received
+// page) instead of running into its timeout. search_context_cancel()
+// wakes the engine so this runs right away even on a stalled transfer.
+
+static int http_xferinfo_callback(void *request_ptr,
+                                  curl_off_t dltotal G_GNUC_UNUSED, curl_off_t dlnow G_GNUC_UNUSED,
+                                  curl_off_t ultotal G_GNUC_UNUSED, curl_off_t ulnow G_GNUC_UNUSED) {
+    HttpRequest *request = (HttpRequest *)request_ptr;
+    return search_context_is_cancelled(request->search) ? 1 : 0;
 }
 
 
+// --------------------------------
 
-// ------------------------------
 
+// CURLSH lock callbacks. The share object is only used from the engine
+// thread today, but curl requires locking for shared data in any
+// multi-threaded program, and it keeps future direct callers safe.
 
-// Helper to Capitalize Each Word In A String
-static void capitalize_each_word(char *str) {
-    bool capitalize_next = true;
-    for (char *p = str; *p; ++p) {
-        if (capitalize_next && isalpha((unsigned char)*p)) {
-            *p = toupper((unsigned char)*p);
-            capitalize_next = false;
+static void http_share_lock(CURL *handle G_GNUC_UNUSED, curl_lock_data data,
+                            curl_lock_access access G_GNUC_UNUSED, void *userptr G_GNUC_UNUSED) {
+    g_mutex_lock(&g_http_engine.share_locks[data]);
+}
+
+static void http_share_unlock(CURL *handle G_GNUC_UNUSED, curl_lock_data data, void *userptr G_GNUC_UNUSED) {
+    g_mutex_unlock(&g_http_engine.share_locks[data]);
+}
+
+
+// --------------------------------
+
+
+// Submits a request to the HTTP engine and blocks until it completes.
+// The request stays owned by the caller. Returns TRUE on CURLE_OK.
+
+static gboolean http_perform_blocking(HttpRequest *request) {
+    if (!http_engine_submit(request, http_fetch_done, NULL))
+        return FALSE;
+
+    g_mutex_lock(&g_http_engine.lock);
+    while (!request->done)
+        g_cond_wait(&g_http_engine.cond, &g_http_engine.lock);
+    g_mutex_unlock(&g_http_engine.lock);
+
+    return request->result == CURLE_OK;
+}
+
+
+// --------------------------------
+
+
+// Streams a page through the anchor scanner, calling on_anchor for every
+// link as soon as it has been received (on the HTTP engine thread, while
+// the calling search thread waits; see the scanner notes below).
+// Anchors seen before a failure are still reported.
+// Returns FALSE if the transfer failed.
+
+static gboolean http_stream_anchors(const char *url, long timeout_s, SearchContext *search, AnchorFunc on_anchor, gpointer user_data) {
+    HttpRequest *request = http_request_new(url, timeout_s, search);
+    if (!request) return FALSE;
+
+    AnchorScanner *scanner = anchor_scanner_new(on_anchor, user_data);
+    curl_easy_setopt(request->easy, CURLOPT_WRITEFUNCTION, anchor_scanner_write_callback);
+    curl_easy_setopt(request->easy, CURLOPT_WRITEDATA, scanner);
+
+    gboolean ok = http_perform_blocking(request);
+    anchor_scanner_finish(scanner);
+
+    printf("[INFO]: Streamed %.1f KB from %s, %u links found.\n",
+           scanner->bytes_scanned / 1024.0, url, scanner->anchors_found);
+
+    anchor_scanner_free(scanner);
+    http_request_free(request);
+    return ok;
+}
+
+
+// ------------------------------------------------------
+// ------------------------------------------------------
+
+
+/*
+ * STREAMING ANCHOR SCANNER NOTES:
+ *
+ * The pure-C parsers (Epicurious, Simply Recipes, Yummly, Saveur) only
+ * want the <a href="..."> links of a search page and their visible text.
+ * Instead of buffering the whole page (up to MAX_DOWNLOAD_SIZE) and
+ * building a full Gumbo DOM, they stream the page through this scanner:
+ * - libcurl hands each received chunk to anchor_scanner_write_callback(),
+ *   which runs a small tokenizer-level state machine over the bytes.
+ * - Every completed anchor is reported to the parser's AnchorFunc while the
+ *   rest of the page is still downloading.
+ * - Only the current tag (ANCHOR_SCANNER_MAX_TAG) and the current anchor's
+ *   text (ANCHOR_SCANNER_MAX_TEXT) are buffered, so memory use stays small
+ *   no matter how large the page is.
+ * - Comments and raw-text elements (script, style, textarea, title) are
+ *   skipped, and common character references are decoded, so links and
+ *   titles match what the Gumbo-based parsers used to see.
+ */
+
+
+// Decodes HTML character references (&amp; &#39; &#x2019; ...) in place.
+// Only the named references that matter for titles and URLs are handled;
+// unknown ones are left as-is. &nbsp; becomes a plain space.
+
+static void decode_html_entities(GString *s) {
+    static const struct { const char *name; const char *text; } named[] = {
+        { "amp", "&" }, { "lt", "<" }, { "gt", ">" }, { "quot", "\"" },
+        { "apos", "'" }, { "nbsp", " " }, { "rsquo", "\xE2\x80\x99" },
+        { "lsquo", "\xE2\x80\x98" }, { "rdquo", "\xE2\x80\x9D" },
+        { "ldquo", "\xE2\x80\x9C" }, { "ndash", "\xE2\x80\x93" },
+        { "mdash", "\xE2\x80\x94" }, { NULL, NULL }
+    };
+
+    if (!strchr(s->str, '&')) return;
+
+    GString *decoded = g_string_sized_new(s->len);
+    const char *p = s->str;
+
+    while (*p) {
+        if (*p != '&') {
+            g_string_append_c(decoded, *p++);
+            continue;
+        }
+
+        const char *semi = strchr(p, ';');
+        if (!semi || semi - p > 10) {
+            g_string_append_c(decoded, *p++);
+            continue;
+        }
+
+        gboolean replaced = FALSE;
+        if (p[1] == '#') {
+            gboolean hex = (p[2] == 'x' || p[2] == 'X');
+            char *end = NULL;
+            gulong code = strtoul(p + (hex ? 3 : 2), &end, hex ? 16 : 10);
+            if (end == semi && code > 0 && code <= 0x10FFFF) {
+                char utf8[8];
+                gint len = g_unichar_to_utf8(code == 0xA0 ? ' ' : (gunichar)code, utf8);
+                g_string_append_len(decoded, utf8, len);
+                replaced = TRUE;
+            }
         } else {
-            *p = tolower((unsigned char)*p);
+            for (int i = 0; named[i].name; ++i) {
+                size_t len = strlen(named[i].name);
+                if ((size_t)(semi - p - 1) == len && strncmp(p + 1, named[i].name, len) == 0) {
+                    g_string_append(decoded, named[i].text);
+                    replaced = TRUE;
+                    break;
+                }
+            }
         }
 
-        if (*p == ' ') {
-            capitalize_next = true;
+        if (replaced) {
+            p = semi + 1;
+        } else {
+            g_string_append_c(decoded, *p++);
         }
     }
+
+    g_string_assign(s, decoded->str);
+    g_string_free(decoded, TRUE);
 }
 
 
-// ------------------------------
+// --------------------------------
 
 
+// Creates a scanner that reports each anchor to on_anchor(link, user_data).
 
-// Sanitize Input String:
-// Removes control characters (except allowed printable ASCII bytes) to
-// avoid crashes or blank recipe titles.
-// Note: This approach may show two replacement question-mark
-// characters (??) for a single accented character if the input
-// contains invalid or multi-byte UTF-8 sequences.
-// This simple method trades off perfect replacement of accented characters
-// for stability and consistent, non-empty output suitable for UI display.
-// Previous frustrating attempts to implement full UTF-8 normalization and
-// accent-stripping logic were complicated by:
-// - Difficulty reliably converting accented characters to plain ASCII
-// - Invalid or malformed UTF-8 sequences causing normalization failures
-// - Complex Unicode handling with longer execution times, resulting in empty
-//   or blank output strings
+static AnchorScanner *anchor_scanner_new(AnchorFunc on_anchor, gpointer user_data) {
+    AnchorScanner *scanner = g_new0(AnchorScanner, 1);
+    scanner->state = SCAN_TEXT;
+    scanner->tag = g_string_sized_new(256);
+    scanner->run = g_string_sized_new(128);
+    scanner->text = g_string_sized_new(128);
+    scanner->on_anchor = on_anchor;
+    scanner->user_data = user_data;
+    return scanner;
+}
 
 
-static char *sanitize_string(const char *str) {
-    GString *out = g_string_new(NULL);
-    for (const unsigned char *p = (const unsigned char *)str; *p; ++p) {
-        if (*p >= 32 && *p != 127) {
-            g_string_append_c(out, *p);
+// --------------------------------
+
+
+// Frees a scanner and whatever anchor it still holds.
+
+static void anchor_scanner_free(AnchorScanner *scanner) {
+    if (!scanner) return;
+    g_string_free(scanner->tag, TRUE);
+    g_string_free(scanner->run, TRUE);
+    g_string_free(scanner->text, TRUE);
+    g_free(scanner->href);
+    g_free(scanner->first_text);
+    g_free(scanner->direct_text);
+    g_free(scanner);
+}
+
+
+// --------------------------------
+
+
+// Ends the text run collected since the last tag.
+// Inside an anchor, a run counts as a child node; non-whitespace runs are
+// also recorded as the anchor's first text, its direct text (if nothing
+// came before it) and appended to the full text.
+
+static void anchor_scanner_end_run(AnchorScanner *scanner) {
+    if (scanner->run->len == 0) return;
+
+    if (scanner->in_anchor) {
+        decode_html_entities(scanner->run);
+
+        gboolean has_text = FALSE;
+        for (const char *p = scanner->run->str; *p; ++p) {
+            if (!g_ascii_isspace(*p)) {
+                has_text = TRUE;
+                break;
+            }
+        }
+
+        if (has_text) {
+            if (!scanner->first_text)
+                scanner->first_text = g_strdup(scanner->run->str);
+            if (!scanner->seen_child)
+                scanner->direct_text = g_strdup(scanner->run->str);
+            if (scanner->text->len + scanner->run->len < ANCHOR_SCANNER_MAX_TEXT)
+                g_string_append(scanner->text, scanner->run->str);
         }
+        scanner->seen_child = TRUE;
     }
-    return g_string_free(out, FALSE);  // Returns newly allocated string
+
+    g_string_truncate(scanner->run, 0);
 }
 
 
-// ------------------------------
+// --------------------------------
 
 
+// Reports the open anchor (if it has an href) and resets the anchor state.
 
-// Helper function that simplistically singularizes English recipe words and
-// search terms to singular form.
-// Checks against exceptions word list and phrase list which are always
-//   preserved as-is, and applies singularization safely. 
-// Uses trim_whitespace() to clean output.
-// Summary:
-// If src is NULL or dstlen == 0:
-//    Writes an empty string ("") into dst (if space allows).
-// If src matches one of the protected multi-word phrases (e.g., "cream cheese", "olive oil"):
-//    Copies the phrase unchanged into dst.
-// If src matches one of the protected words (e.g., "anchovies", "eggs"):
-//     Copies the word unchanged into dst.
-// If the word ends with "ies":
-//    Converts it to end with "y" (e.g., "berries" → "berry").
-// If the word ends with s (longer than 1 char):
-//    Strips the final "s" (e.g., "cakes" → "cake").
-// Otherwise:
-//    Copies src unchanged into dst.
+static void anchor_scanner_close_anchor(AnchorScanner *scanner) {
+    if (!scanner->in_anchor) return;
 
-static void singularize(const char *src, char *dst, size_t dstlen) {
-    if (!src || dstlen == 0) {
-        if (dstlen > 0) dst[0] = '\0';
-        return;
+    if (scanner->href && *scanner->href) {
+        g_strstrip(scanner->text->str);
+        AnchorLink link = {
+            scanner->href,
+            scanner->first_text,
+            scanner->direct_text,
+            scanner->text->str
+        };
+        scanner->anchors_found++;
+        scanner->on_anchor(&link, scanner->user_data);
     }
 
-    // Exceptions word list: always preserved as-is (plural or not)
-    static const char *protected_recipe_words[] = {
-        "anchovies",
-        "bagels",
-        "beans",
-        "berries",
-        "brownies",
-        "buns",
-        "carrots",
-        "chaffles",
-        "chips",
-        "clams",
-        "cookies",
-        "crackers",
-        "cupcakes",
-        "dumplings",
-        "eggs",
-        "fries",
-        "greens",
-        "grits",
-        "herbs",
-        "lentils",
-        "loaves",
-        "meatballs",
-        "muffins",
-        "mussels",
-        "nachos",
-        "noodles",
-        "nuts",
-        "olives",
-        "pancakes",
-        "peppers",
-        "pickles",
-        "pies",
-        "ribs",
-        "sandwiches",
-        "sausages",
-        "scallops",
-        "seeds",
-        "shrimp",
-        "snacks",
-        "spaghetti",
-        "spices",
-        "sprouts",
-        "sweets",
-        "tacos",
-        "treats",
-        "vegetables",
-        "veggies",
-        "waffles",
-        "wraps",
-        "zoodles",
-        NULL
-    };
+    scanner->in_anchor = FALSE;
+    scanner->seen_child = FALSE;
+    g_clear_pointer(&scanner->href, g_free);
+    g_clear_pointer(&scanner->first_text, g_free);
+    g_clear_pointer(&scanner->direct_text, g_free);
+    g_string_truncate(scanner->text, 0);
+}
 
-    // Protected multi-word recipe phrases where singularizing words
-    // would distort meaning and thus should be preserved as-is.
-    static const char *protected_recipe_phrases[] = {
-        "apple cider",
-        "apple slices",
-        "baking powder",
-        "baking soda",
-        "bread crumbs",
-        "brown rice",
-        "brown sugar",
-        "cocoa powder",
-        "chocolate chips",
-        "cooking oil",
-        "corn flakes",
-        "cream cheese",
-        "cream of tartar",
-        "cream sauce",
-        "dark chocolate",
-        "fried oysters",
-        "french fries",
-        "green beans",
-        "green onions",
-        "green peas",
-        "hot chili",
-        "hot dogs",
-        "hot sauce",
-        "lemon zest",
-        "mixed nuts",
-        "olive oil",
-        "orange juice",
-        "potato chips",
-        "red onions",
-        "red pepper",
-        "soy sauce",
-        "strawberry jam",
-        "sweet chili",
-        "sweet corn",
-        "sweet potatoes",
-        "vanilla extract",
-        "whole wheat",
-        NULL
-    };
 
-    char trimmed_src[256];
-    trim_whitespace(src, trimmed_src, sizeof(trimmed_src));
-    // Check for protected multi-word phrases (case-insensitive)
-    for (int i = 0; protected_recipe_phrases[i]; ++i) {
-        if (strcasecmp(trimmed_src, protected_recipe_phrases[i]) == 0) {
-            snprintf(dst, dstlen, "%s", trimmed_src);
-            return;
+// --------------------------------
+
+
+// Extracts the (decoded) value of attribute 'name' from the inside of a
+// start tag, e.g. 'a class="x" href="/recipes/1"'. Handles double-quoted,
+// single-quoted and unquoted values. Returns a new string or NULL.
+
+static char *anchor_scanner_get_attribute(const char *tag, const char *name) {
+    size_t name_len = strlen(name);
+    const char *p = tag;
+
+    // Skip the tag name
+    while (*p && !g_ascii_isspace(*p) && *p != '/') p++;
+
+    while (*p) {
+        while (*p && (g_ascii_isspace(*p) || *p == '/')) p++;
+        if (!*p) break;
+
+        const char *attr = p;
+        while (*p && !g_ascii_isspace(*p) && *p != '=' && *p != '/') p++;
+        size_t attr_len = (size_t)(p - attr);
+
+        while (*p && g_ascii_isspace(*p)) p++;
+
+        const char *value = NULL;
+        size_t value_len = 0;
+        if (*p == '=') {
+            p++;
+            while (*p && g_ascii_isspace(*p)) p++;
+            if (*p == '"' || *p == '\'') {
+                char quote = *p++;
+                value = p;
+                while (*p && *p != quote) p++;
+                value_len = (size_t)(p - value);
+                if (*p) p++;
+            } else {
+                value = p;
+                while (*p && !g_ascii_isspace(*p)) p++;
+                value_len = (size_t)(p - value);
+            }
         }
-    }
-    // Check exceptions word list
-    for (int i = 0; protected_recipe_words[i]; ++i) {
-        if (strcasecmp(trimmed_src, protected_recipe_words[i]) == 0) {
-            snprintf(dst, dstlen, "%s", trimmed_src);
-            return;
+
+        if (attr_len == name_len && g_ascii_strncasecmp(attr, name, name_len) == 0) {
+            if (!value) return g_strdup("");
+            GString *decoded = g_string_new_len(value, (gssize)value_len);
+            decode_html_entities(decoded);
+            g_strstrip(decoded->str);
+            return g_string_free(decoded, FALSE);
         }
     }
-    size_t len = strlen(trimmed_src);
-    // Rule: convert "ies" to "y"
-    if (len > 3 && strcasecmp(trimmed_src + len - 3, "ies") == 0) {
-        snprintf(dst, dstlen, "%.*sy", (int)(len - 3), trimmed_src);
-        return;
-    }
-    // Rule: remove trailing 's' if longer than 1 char
-    if (len > 1 && (trimmed_src[len - 1] == 's' || trimmed_src[len - 1] == 'S')) {
-        snprintf(dst, dstlen, "%.*s", (int)(len - 1), trimmed_src);
-        return;
+
+    return NULL;
+}
+
+
+// --------------------------------
+
+
+// Returns TRUE if the last non-space character collected for the current
+// tag is '=', i.e. a quote character here opens an attribute value.
+
+static gboolean anchor_scanner_after_equals(const GString *tag) {
+    for (gsize i = tag->len; i > 0; --i) {
+        if (!g_ascii_isspace(tag->str[i - 1]))
+            return tag->str[i - 1] == '=';
     }
-    // Default: copy trimmed input as-is
-    snprintf(dst, dstlen, "%s", trimmed_src);
+    return FALSE;
 }
 
 
-// ------------------------------
+// --------------------------------
 
 
-// Rewrites recipe titles that have a trailing block of digits so they are
-//   more human-friendly and visually separated.
-// Splits a recipe title into two parts: the descriptive name and a trailing
-//   numeric rating block (e.g., 1,234 Ratings).
-// Uused when parsing recipe titles from websites where the site includes
-//   numbers (ratings, votes, or counts) at the end of the title string
-// without clean separation.
-// It makes the recipe titles easier to read in the GTK listbox/buttons by
-//   inserting " - " before the number block.
-// If a number appears at the end of the title (with optional commas),
-// it inserts " - " before the number block for readability.
-// Special handling:
-// - Leaves titles unchanged if numbers are embedded in words (e.g., "Rib1234").
-// - Adds a space before an opening parenthesis if the number block is wrapped
-// Returns a newly allocated string that must be freed by the caller.
-// Examples:
-//   "Delicious Chicken Soup1,234 Ratings" -->"Delicious Chicken Soup - 1,234 Ratings"
-//   "Amazing Ribs(1,234 Ratings)" --> "Amazing Ribs ( - 1,234 Ratings)"
-//   "Best Rib1234" --> "Rib1234"
-//  "Taco Recipes" --> "Taco Recipes"
-// What it does step-by-step:
-//   1. Scan from the end of the string to find the last digit.
-//        If no digits → return the original title unchanged.
-//  2. Identify the whole block of digits (e.g., "1234" or "1,234") by
-//      walking backward.
-//  3. Safety check: If the digits are part of a word (like "Rib1234"),
-//      don’t split ==> return unchanged.
-//  4. Special case: If the digits are immediately after a parenthesis
-//       (e.g., "Ribs(1,234 Ratings)"), insert a space before (.
+// Handles one complete tag (the text between '<' and '>').
+// Opens/closes anchors, and switches to raw-text mode for elements whose
+// contents are not HTML (so "<a" inside a script is never mistaken for
+// a link).
 
-static char *split_title_and_digits(const char *title) {
-    if (!title) return NULL;
+static void anchor_scanner_handle_tag(AnchorScanner *scanner) {
+    const char *tag = scanner->tag->str;
 
-    size_t len = strlen(title);
-    if (len == 0) return strdup("");
+    // Doctype, processing instructions, CDATA and other markup declarations
+    if (tag[0] == '!' || tag[0] == '?') return;
 
-    // Step 1: Find the last digit in the string
-    ssize_t end = -1;
-    for (ssize_t i = len - 1; i >= 0; i--) {
-        if (isdigit((unsigned char)title[i])) {
-            end = i;
-            break;
+    gboolean closing = (tag[0] == '/');
+    const char *name_start = closing ? tag + 1 : tag;
+
+    char name[16];
+    size_t n = 0;
+    while (name_start[n] && n < sizeof(name) - 1 &&
+           !g_ascii_isspace(name_start[n]) && name_start[n] != '/') {
+        name[n] = g_ascii_tolower(name_start[n]);
+        n++;
+    }
+    name[n] = '\0';
+    if (n == 0) return;
+
+    if (strcmp(name, "a") == 0) {
+        if (closing) {
+            anchor_scanner_close_anchor(scanner);
+        } else {
+            // Anchors cannot nest; a new one implicitly closes the old one
+            anchor_scanner_close_anchor(scanner);
+            scanner->in_anchor = TRUE;
+            scanner->href = anchor_scanner_get_attribute(tag, "href");
         }
+        return;
     }
 
-    if (end == -1) return strdup(title);  // No digits found
+    if (scanner->in_anchor)
+        scanner->seen_child = TRUE;  // Any element is a child node of the anchor
 
-    // Step 2: Walk backwards to find the start of the digit block (including commas)
-    ssize_t start = end;
-    while (start > 0 && (isdigit((unsigned char)title[start - 1]) || title[start - 1] == ',')) {
-        start--;
-    }
+    if (!closing && (strcmp(name, "script") == 0 || strcmp(name, "style") == 0 ||
+                     strcmp(name, "textarea") == 0 || strcmp(name, "title") == 0)) {
+        size_t len = strlen(tag);
+        if (len > 0 && tag[len - 1] == '/') return;  // Self-closing, nothing to skip
 
-    // Step 3: Avoid splitting embedded numbers (e.g., Rib1234)
-    if (start > 0 && isalpha((unsigned char)title[start - 1])) {
-        return strdup(title);
+        snprintf(scanner->raw_end, sizeof(scanner->raw_end), "</%s", name);
+        scanner->raw_match = 0;
+        scanner->state = SCAN_RAWTEXT;
     }
+}
 
-    // Step 4: Check for tight parenthesis, e.g. "Ribs(1,234 Ratings)"
-    // Insert a space before '(' if needed
-    int insert_space_before_paren = 0;
-    if (start > 0 && title[start - 1] == '(') {
-        insert_space_before_paren = 1;
-        start--;  // Include the '(' in the part1
-    }
 
-    // Step 5: Find where the tail starts (after the digit block)
-    size_t tail_start = end + 1;
-    size_t tail_len = len - tail_start;
+// --------------------------------
 
-    // Compose output: [part1] + " - " + [digits] + [tail]
-    size_t part1_len = start;
-    size_t digits_len = end - start + 1;
 
-    // +1 extra space if we're inserting before '('
-    size_t out_len = part1_len + insert_space_before_paren + 3 + digits_len + tail_len + 1;
+// Feeds one chunk of HTML into the scanner. Chunks may split tags, text
+// and character references anywhere; all state carries over.
 
-    char *out = malloc(out_len);
-    if (!out) return NULL;
+static void anchor_scanner_feed(AnchorScanner *scanner, const char *data, size_t len) {
+    scanner->bytes_scanned += len;
 
-    char *p = out;
+    for (size_t i = 0; i < len; ++i) {
+        char c = data[i];
 
-    // Copy part1
-    memcpy(p, title, part1_len);
-    p += part1_len;
+        switch (scanner->state) {
+            case SCAN_TEXT:
+                if (c == '<') {
+                    anchor_scanner_end_run(scanner);
+                    g_string_truncate(scanner->tag, 0);
+                    scanner->quote = 0;
+                    scanner->tag_overflow = FALSE;
+                    scanner->state = SCAN_TAG;
+                } else if (scanner->in_anchor && scanner->run->len < ANCHOR_SCANNER_MAX_TEXT) {
+                    g_string_append_c(scanner->run, c);
+                }
+                break;
 
-    if (insert_space_before_paren) {
-        *p++ = ' ';
+            case SCAN_TAG:
+                if (scanner->quote) {
+                    if (c == scanner->quote) scanner->quote = 0;
+                } else if (c == '>') {
+                    if (!scanner->tag_overflow) anchor_scanner_handle_tag(scanner);
+                    if (scanner->state == SCAN_TAG) scanner->state = SCAN_TEXT;
+                    break;
+                } else if ((c == '"' || c == '\'') && anchor_scanner_after_equals(scanner->tag)) {
+                    scanner->quote = c;  // Attribute value: '>' inside it does not end the tag
+                } else if (scanner->tag->len == 0 && !g_ascii_isalpha(c) && c != '/' && c != '!' && c != '?') {
+                    // "<" followed by a non-tag character is plain text ("a < b")
+                    if (scanner->in_anchor && scanner->run->len + 1 < ANCHOR_SCANNER_MAX_TEXT) {
+                        g_string_append_c(scanner->run, '<');
+                        g_string_append_c(scanner->run, c);
+                    }
+                    scanner->state = SCAN_TEXT;
+                    break;
+                }
+
+                if (scanner->tag->len < ANCHOR_SCANNER_MAX_TAG) {
+                    g_string_append_c(scanner->tag, c);
+                } else {
+                    scanner->tag_overflow = TRUE;  // Drop oversized tags, keep scanning
+                }
+
+                if (scanner->tag->len == 3 && strcmp(scanner->tag->str, "!--") == 0) {
+                    scanner->comment_dashes = 0;
+                    scanner->state = SCAN_COMMENT;
+                }
+                break;
+
+            case SCAN_COMMENT:
+                if (c == '>' && scanner->comment_dashes >= 2) {
+                    scanner->state = SCAN_TEXT;
+                } else if (c == '-') {
+                    scanner->comment_dashes++;
+                } else {
+                    scanner->comment_dashes = 0;
+                }
+                break;
+
+            case SCAN_RAWTEXT:
+                if (g_ascii_tolower(c) == scanner->raw_end[scanner->raw_match]) {
+                    scanner->raw_match++;
+                    if (scanner->raw_end[scanner->raw_match] == '\0') {
+                        // Found "</script" (etc.): finish the end tag normally
+                        g_string_assign(scanner->tag, scanner->raw_end + 1);
+                        scanner->quote = 0;
+                        scanner->tag_overflow = FALSE;
+                        scanner->state = SCAN_TAG;
+                    }
+                } else {
+                    scanner->raw_match = (c == '<') ? 1 : 0;
+                }
+                break;
+        }
     }
+}
 
-    // Add " - "
-    memcpy(p, " - ", 3);
-    p += 3;
 
-    // Copy digits
-    memcpy(p, title + start, digits_len);
-    p += digits_len;
+// --------------------------------
 
-    // Copy tail
-    memcpy(p, title + tail_start, tail_len);
-    p += tail_len;
 
-    *p = '\0';
+// Flushes the scanner at the end of the page. Like an HTML parser, an
+// anchor left open at end of file is closed (and reported).
 
-    return out;
+static void anchor_scanner_finish(AnchorScanner *scanner) {
+    if (scanner->state == SCAN_TEXT)
+        anchor_scanner_end_run(scanner);
+    anchor_scanner_close_anchor(scanner);
 }
 
 
-// ------------------------------
-// ------------------------------
-// ------------------------------
+// --------------------------------
+
+
+// libcurl write callback for streamed pages: scans each chunk as it
+// arrives instead of storing it. Enforces the same MAX_DOWNLOAD_SIZE
+// sanity limit as memory_write_callback().
+
+static size_t anchor_scanner_write_callback(void *contents, size_t sz, size_t nm, void *scanner_ptr) {
+    size_t realsize = sz * nm;
+    AnchorScanner *scanner = scanner_ptr;
+
+    if (scanner->bytes_scanned + realsize > MAX_DOWNLOAD_SIZE) {
+        fprintf(stderr, "anchor_scanner_write_callback: Exceeded maximum allowed download size (%d MB)\n",
+                MAX_DOWNLOAD_SIZE / (1024 * 1024));
+        return 0;
+    }
+
+    anchor_scanner_feed(scanner, contents, realsize);
+    return realsize;
+}
+
+
+// ==================
 
 
 /*
- * Extracts quoted phrases from a user’s search string, preserving
- * multi-word terms exactly as typed.
- *
- * JM: This is an experimental function, and prints debug info to the terminal
+ * SEARCH CONTEXT NOTES:
  *
- * Behavior:
- * - Normalize fancy / curly quote marks ==> ASCII).
- * - Extract complete quoted phrases; ignore unmatched quotes.
- * - Preserve punctuation/apostrophes inside phrases.
- * - Lowercase and trim each phrase.
- * - Ignore unquoted words.
- * - Return space-separated phrases (no quotes).
- * - Overall, it preserves meaningful search term grouping and punctuation
- *   within the string, and presents it as an unquoted, flat string to
- *   downstream search systems.
- *
- * Example:
- *   Input:  "Grilled Cheese" and ‘Oyster Po’ Boys’ or 'Tomato Soup'
- *   Output: grilled cheese oyster po' boys tomato soup
+ * A SearchContext replaces the old process-wide result counter, result
+ * limit and "current website" globals, which every search reset and
+ * shared, so two searches could never safely run at once.
+ * - Single-site searches and background cache refreshes each create
+ *   their own context; "All Sites" creates one parent (combined limit)
+ *   plus one child per site (per-site limit and deadline).
+ * - search_context_claim_result() reserves a slot atomically in the child
+ *   and every parent, and backs out if any of them is full, so parallel
+ *   parsers can never overshoot a limit.
+ * - Cancellation is a flag checked by add_link(), the HTTP engine's
+ *   progress callback and run_site_script(); cancelling a parent cancels
+ *   all of its children. Each search started from the UI has a top-level
+ *   "token" context (see supersede_active_search), so a new search cancels
+ *   everything the previous one still has in flight.
+ * - The token also carries the search's ResultChannel, which every child
+ *   inherits, so each link add_link() accepts reaches the listbox right
+ *   away (see search_context_publish).
+ */
+
+
+// Creates a search context with its own duplicate filter.
+//   parent:       context whose budget this one shares, or NULL
+//   site:         site being searched (NULL for a fan-out parent)
+//   result_limit: maximum links this context may add
+
+static SearchContext *search_context_new(SearchContext *parent, const RecipeSiteInfo *site, gint result_limit) {
+    SearchContext *search = g_new0(SearchContext, 1);
+    search->ref_count = 1;
+    search->parent = parent ? search_context_ref(parent) : NULL;
+    search->site = site;
+    search->site_name = site ? site->name : "All Sites";
+    search->result_limit = result_limit;
+    search->arena = parent ? string_arena_ref(parent->arena) : string_arena_new();
+    search->link_set = fingerprint_set_new();
+    g_mutex_init(&search->publish_lock);
+    search->channel = (parent && parent->channel) ? result_channel_ref(parent->channel) : NULL;
+    return search;
+}
+
+
+// --------------------------------
+
+
+// Adds a reference to a search context and returns it.
+
+static SearchContext *search_context_ref(SearchContext *search) {
+    g_atomic_int_inc(&search->ref_count);
+    return search;
+}
+
+
+// --------------------------------
+
+
+// Drops one reference; the last one frees the context (and releases
+// its parent).
+
+static void search_context_unref(SearchContext *search) {
+    if (!search || !g_atomic_int_dec_and_test(&search->ref_count))
+        return;
+
+    fingerprint_set_free(search->link_set);
+    string_arena_unref(search->arena);
+    fingerprint_set_free(search->published);
+    title_index_free(search->titles);
+    g_mutex_clear(&search->publish_lock);
+    result_channel_unref(search->channel);
+    if (search->parent) {
+        search_context_unref(search->parent);
+    }
+    g_free(search);
+}
+
+
+// --------------------------------
+
+
+// Reserves one result slot in the context and every parent.
+// Returns FALSE (and reserves nothing) if any of them is already full.
+
+static gboolean search_context_claim_result(SearchContext *search) {
+    for (SearchContext *c = search; c; c = c->parent) {
+        if (g_atomic_int_add(&c->result_total, 1) >= c->result_limit) {
+            // Full: give back the slots taken so far, including this one
+            for (SearchContext *undo = search; undo != c->parent; undo = undo->parent) {
+                g_atomic_int_add(&undo->result_total, -1);
+            }
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+// --------------------------------
+
+
+// Cancels a search context. Parsers still running for it (or for any
+// child) stop adding links, and site scripts not yet started are skipped.
+// Threads blocked on the search are woken so they notice right away: the
+// HTTP engine aborts its transfers from the progress callback, and
+// run_site_script() tells the worker to cancel the job.
+
+static void search_context_cancel(SearchContext *search) {
+    if (!search || g_atomic_int_get(&search->cancelled))
+        return;
+
+    g_atomic_int_set(&search->cancelled, 1);
+
+    g_mutex_lock(&g_http_engine.lock);
+    if (g_http_engine.running && !g_http_engine.stopping) {
+        curl_multi_wakeup(g_http_engine.multi);
+    }
+    g_mutex_unlock(&g_http_engine.lock);
+
+    g_mutex_lock(&g_scrape_worker.lock);
+    g_cond_broadcast(&g_scrape_worker.cond);
+    g_mutex_unlock(&g_scrape_worker.lock);
+}
+
+
+// --------------------------------
+
+
+// Returns TRUE if the context or any of its parents was cancelled.
+
+static gboolean search_context_is_cancelled(SearchContext *search) {
+    for (SearchContext *c = search; c; c = c->parent) {
+        if (g_atomic_int_get(&c->cancelled))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+
+// --------------------------------
+
+
+// Returns the earliest deadline of the context and its parents, or 0 if
+// none of them has one.
+
+static gint64 search_context_deadline(SearchContext *search) {
+    gint64 deadline = 0;
+    for (SearchContext *c = search; c; c = c->parent) {
+        if (c->deadline > 0 && (deadline == 0 || c->deadline < deadline)) {
+            deadline = c->deadline;
+        }
+    }
+    return deadline;
+}
+
+
+// --------------------------------
+
+
+// Returns TRUE if the context added at least one real result, i.e. a link
+// that did not come from add_fallback_link(). A site that could not be
+// reached, or whose page changed, only produces its fallback link.
+
+static gboolean search_context_found_results(SearchContext *search) {
+    return search->link_set->size > (guint)g_atomic_int_get(&search->fallback_links);
+}
+
+
+// --------------------------------
+
+
+// Hands one accepted link record to the UI through the search's result
+// channel, with its position in the site's results for ranking.
+// Searches without a channel (background cache refreshes) only build
+// their list. Safe from any thread.
+
+static void search_context_publish(SearchContext *search, ResultRef record, guint site_rank) {
+    if (search->channel && !search_context_is_cancelled(search) &&
+        search_context_admit_published(search, record)) {
+        result_channel_publish(search->channel, record, site_rank);
+    }
+}
+
+
+// --------------------------------
+
+
+// Publishes a whole list of links (a cache hit) in its site order.
+// Links another site of the search already published are left out.
+
+static void search_context_publish_list(SearchContext *search, GList *links) {
+    guint site_rank = 0;
+    for (GList *l = links; l; l = l->next) {
+        search_context_publish(search, GPOINTER_TO_UINT(l->data), site_rank++);
+    }
+}
+
+
+// --------------------------------
+
+
+// Cross-site duplicate filter for published links. The root context of a
+// search remembers the canonical URL of every link published so far, and
+// in a search over several sites also its title signature, so a page
+// another site already showed, or a syndicated copy of it under a
+// near-identical title, is collapsed into the row already in the list.
+// Titles are only compared across sites: a site's own results with the
+// same name (variations of one dish) all stay. Safe from any thread.
+// Returns TRUE if the link should be published.
+
+static gboolean search_context_admit_published(SearchContext *search, ResultRef record) {
+    SearchContext *root = search;
+    while (root->parent) root = root->parent;
+
+    const ResultRecord *rec = string_arena_record(search->arena, record);
+    const char *title = result_record_title(rec);
+    char *canonical = canonicalize_url(result_record_url(rec));
+    guint64 key = fingerprint_hash(canonical, strlen(canonical));
+
+    g_mutex_lock(&root->publish_lock);
+    if (!root->published) {
+        root->published = fingerprint_set_new();
+    }
+    if (!root->titles && search->site && search_context_spans_sites(search)) {
+        root->titles = title_index_new();
+    }
+
+    gboolean admit = fingerprint_set_insert(root->published, key, 0);
+    if (admit && root->titles && !title_index_add(root->titles, title, search->site)) {
+        printf("[INFO]: Collapsed near-duplicate recipe from %s: %s\n", search->site_name, title);
+        admit = FALSE;
+    }
+    g_mutex_unlock(&root->publish_lock);
+
+    g_free(canonical);
+    return admit;
+}
+
+
+// --------------------------------
+
+
+// Returns TRUE if the context searches one site of an "All Sites"
+// search, i.e. a fan-out parent (no site) sits between it and the root.
+// A single-site search hangs directly off the root.
+
+static gboolean search_context_spans_sites(SearchContext *search) {
+    for (SearchContext *p = search->parent; p && p->parent; p = p->parent) {
+        if (!p->site) return TRUE;
+    }
+    return FALSE;
+}
+
+
+// --------------------------------
+
+
+// Returns TRUE if the context already added a link whose canonical URL
+// equals that of 'url'.
+
+static gboolean search_context_has_link(SearchContext *search, const char *url) {
+    char *canonical = canonicalize_url(url);
+    gboolean found = fingerprint_set_lookup(search->link_set, fingerprint_hash(canonical, strlen(canonical)), NULL);
+    g_free(canonical);
+    return found;
+}
+
+
+// ==================
+
+
+/*
+ * DUPLICATE DETECTION NOTES:
  *
- * Notes:
- * - Input must be UTF-8; only ASCII quotes are normalized.
- * - Output string must be freed with g_free().
- * - This design follows a similar philosophy to how Google handles quoted
- *   search terms: quoted phrases are treated as exact terms. Unquoted terms
- *   are typically tokenized into individual words by most search engines, but
- *   in this function, we ignore them entirely to focus on strong user intent.
+ * Links used to be deduplicated on the exact string base_url + href, so
+ * one recipe reached the list several times: with and without tracking
+ * parameters, a trailing slash or a fragment, over http and https, as its
+ * AMP variant, and (when fanning out) once per site that syndicates it.
+ * - canonicalize_url() reduces a URL to one form for comparison: https,
+ *   lowercase host without "www."/"m."/"amp." or a default port, a path
+ *   without empty, "." and "amp" segments (".." resolved) or a trailing
+ *   slash, no fragment, and only the query parameters the site needs
+ *   (url_query_param_is_kept), sorted. The link itself keeps its
+ *   original URL.
+ * - Canonical URLs are stored as 64-bit fingerprints in a FingerprintSet
+ *   (open addressing, no string copies), per site in add_link() and per
+ *   search for what gets published.
+ * - Titles are compared by MinHash over character 3-gram shingles, with
+ *   LSH bands so each check is a few hash probes (TitleIndex). Titles
+ *   from two different sites that agree on nearly all of the signature
+ *   are the same recipe. One site's own results are never collapsed by
+ *   title (it may list "Chicken Curry" twice for two different recipes),
+ *   and a single-site search keeps no title index at all.
  */
 
-char *extract_quoted_terms(const char *search_term) {
-    if (!search_term) return NULL;
 
-    // Duplicate input into a mutable buffer so we can modify it
-    char *input = g_strdup(search_term);
-    normalize_quotes_utf8(input);
+// Returns the canonical form of a recipe URL, used only to detect
+// duplicates (g_free). Strings without a scheme are returned unchanged.
+// See DUPLICATE DETECTION NOTES for the rules.
+
+static char *canonicalize_url(const char *url) {
+    while (url && g_ascii_isspace(*url)) url++;
+    const char *scheme_end = url ? strstr(url, "://") : NULL;
+    if (!scheme_end) return g_strdup(url ? url : "");
+
+    GString *out = g_string_new(NULL);
+
+    // Scheme: http and https name the same recipe page
+    char *scheme = g_ascii_strdown(url, scheme_end - url);
+    g_string_append(out, strcmp(scheme, "http") == 0 ? "https" : scheme);
+    g_string_append(out, "://");
+    g_free(scheme);
+
+    // Host: no user info, lowercase, no default port or mobile/AMP prefix
+    const char *authority = scheme_end + 3;
+    const char *authority_end = authority + strcspn(authority, "/?#");
+    const char *at = memchr(authority, '@', authority_end - authority);
+    if (at) authority = at + 1;
+
+    char *host = g_ascii_strdown(authority, authority_end - authority);
+    char *port = strrchr(host, ':');
+    if (port && (strcmp(port, ":80") == 0 || strcmp(port, ":443") == 0)) *port = '\0';
+    size_t host_len = strlen(host);
+    if (host_len > 0 && host[host_len - 1] == '.') host[--host_len] = '\0';
+
+    const char *bare_host = host;
+    static const char *host_prefixes[] = { "www.", "m.", "amp.", NULL };
+    for (int i = 0; host_prefixes[i]; ++i) {
+        if (g_str_has_prefix(bare_host, host_prefixes[i]) && strchr(bare_host + strlen(host_prefixes[i]), '.')) {
+            bare_host += strlen(host_prefixes[i]);
+        }
+    }
+    g_string_append(out, bare_host);
+
+    // Path: normalized segments, no trailing slash
+    const char *path = authority_end;
+    const char *path_end = path + strcspn(path, "?#");
+    char *path_copy = g_strndup(path, path_end - path);
+    char **segments = g_strsplit(path_copy, "/", -1);
+    GPtrArray *kept = g_ptr_array_new();
+
+    for (int i = 0; segments[i]; ++i) {
+        const char *seg = segments[i];
+        if (*seg == '\0' || strcmp(seg, ".") == 0 || g_ascii_strcasecmp(seg, "amp") == 0)
+            continue;
+        if (strcmp(seg, "..") == 0) {
+            if (kept->len > 0) g_ptr_array_remove_index(kept, kept->len - 1);
+            continue;
+        }
+        g_ptr_array_add(kept, (gpointer)seg);
+    }
+    if (kept->len == 0) g_string_append_c(out, '/');
+    for (guint i = 0; i < kept->len; ++i) {
+        g_string_append_c(out, '/');
+        g_string_append(out, g_ptr_array_index(kept, i));
+    }
+
+    // Query: only parameters the site needs, in a fixed order (the
+    // fragment is dropped)
+    if (*path_end == '?') {
+        const char *query = path_end + 1;
+        char *query_copy = g_strndup(query, strcspn(query, "#"));
+        char **params = g_strsplit(query_copy, "&", -1);
+        GPtrArray *kept_params = g_ptr_array_new();
+
+        for (int i = 0; params[i]; ++i) {
+            size_t name_len = strcspn(params[i], "=");
+            if (name_len > 0 && url_query_param_is_kept(bare_host, params[i], name_len))
+                g_ptr_array_add(kept_params, params[i]);
+        }
+        g_ptr_array_sort(kept_params, url_query_param_compare);
+
+        for (guint i = 0; i < kept_params->len; ++i) {
+            g_string_append_c(out, i == 0 ? '?' : '&');
+            g_string_append(out, g_ptr_array_index(kept_params, i));
+        }
+
+        g_ptr_array_free(kept_params, TRUE);
+        g_strfreev(params);
+        g_free(query_copy);
+    }
+
+    g_ptr_array_free(kept, TRUE);
+    g_strfreev(segments);
+    g_free(path_copy);
+    g_free(host);
+    return g_string_free(out, FALSE);
+}
+
+
+// --------------------------------
+
+
+// Query parameter rules of canonicalize_url():
+//   - Tracking and presentation parameters (utm_*, click ids, referrers,
+//     AMP switches) never identify a recipe and are always dropped.
+//   - Sites listed below serve each recipe at a plain path, so every
+//     parameter is dropped, except the few named (WordPress sites can
+//     also link a post as ?p=<id>).
+//   - Other sites keep their remaining parameters.
+
+static gboolean url_query_param_is_kept(const char *host, const char *name, size_t name_len) {
+    static const char *tracking_params[] = {
+        "fbclid", "gclid", "dclid", "msclkid", "yclid", "igshid",
+        "mc_cid", "mc_eid", "_ga", "_gl", "cmpid", "cid", "s_cid", "ncid",
+        "ref", "ref_src", "ref_url", "referrer", "src", "source",
+        "amp", "outputtype", "print",
+        NULL
+    };
+
+    static const struct {
+        const char *host;       // Site host (subdomains match too)
+        const char *keep;       // Space-separated parameters to keep ("" = none)
+    } site_rules[] = {
+        { "allrecipes.com", "" },
+        { "bbcgoodfood.com", "" },
+        { "bonappetit.com", "" },
+        { "budgetbytes.com", "p" },
+        { "chowhound.com", "" },
+        { "americastestkitchen.com", "" },
+        { "cooksillustrated.com", "" },
+        { "delish.com", "" },
+        { "eatingwell.com", "" },
+        { "epicurious.com", "" },
+        { "food52.com", "" },
+        { "foodnetwork.com", "" },
+        { "cooking.nytimes.com", "" },
+        { "thekitchn.com", "" },
+        { "saveur.com", "" },
+        { "seriouseats.com", "" },
+        { "simplyrecipes.com", "" },
+        { "smittenkitchen.com", "p" },
+        { "thespruceeats.com", "" },
+        { "tasteofhome.com", "" },
+        { NULL, NULL }
+    };
+
+    char *lower = g_ascii_strdown(name, name_len);
+    gboolean kept = !g_str_has_prefix(lower, "utm_");
+
+    for (int i = 0; kept && tracking_params[i]; ++i) {
+        if (strcmp(lower, tracking_params[i]) == 0) kept = FALSE;
+    }
+
+    for (int i = 0; kept && site_rules[i].host; ++i) {
+        size_t host_len = strlen(host), rule_len = strlen(site_rules[i].host);
+        gboolean same_site = host_len >= rule_len &&
+                             strcmp(host + host_len - rule_len, site_rules[i].host) == 0 &&
+                             (host_len == rule_len || host[host_len - rule_len - 1] == '.');
+        if (!same_site) continue;
+
+        // Listed site: keep only the named parameters
+        kept = FALSE;
+        char **keep = g_strsplit(site_rules[i].keep, " ", -1);
+        for (int k = 0; keep[k]; ++k) {
+            if (*keep[k] && strcmp(lower, keep[k]) == 0) kept = TRUE;
+        }
+        g_strfreev(keep);
+        break;
+    }
+
+    g_free(lower);
+    return kept;
+}
+
+
+// --------------------------------
+
+
+// Helper: g_ptr_array_sort() comparator for query parameters ("name=value").
+
+static gint url_query_param_compare(gconstpointer a, gconstpointer b) {
+    return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+
+// --------------------------------
+
+
+// 64-bit FNV-1a hash of 'len' bytes, used as a fingerprint. Never returns
+// 0, which marks an empty FingerprintSet slot.
+
+static guint64 fingerprint_hash(const char *data, size_t len) {
+    guint64 hash = G_GUINT64_CONSTANT(14695981039346656037);
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (guchar)data[i];
+        hash *= G_GUINT64_CONSTANT(1099511628211);
+    }
+    return hash ? hash : 1;
+}
+
+
+// --------------------------------
+
+
+// Bit mixer (the splitmix64 finalizer): spreads every input bit over the
+// whole output, for probing and for deriving the MinHash functions.
+
+static guint64 fingerprint_mix(guint64 x) {
+    x ^= x >> 30;
+    x *= G_GUINT64_CONSTANT(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= G_GUINT64_CONSTANT(0x94d049bb133111eb);
+    x ^= x >> 31;
+    return x;
+}
+
+
+// --------------------------------
+
+
+// Creates an empty fingerprint set.
+
+static FingerprintSet *fingerprint_set_new(void) {
+    FingerprintSet *set = g_new0(FingerprintSet, 1);
+    set->capacity = FINGERPRINT_SET_MIN_CAPACITY;
+    set->keys = g_new0(guint64, set->capacity);
+    set->values = g_new0(guint32, set->capacity);
+    return set;
+}
+
+
+// --------------------------------
+
+
+// Frees a fingerprint set (NULL is ignored).
+
+static void fingerprint_set_free(FingerprintSet *set) {
+    if (!set) return;
+    g_free(set->keys);
+    g_free(set->values);
+    g_free(set);
+}
+
+
+// --------------------------------
+
+
+// Looks up a fingerprint. Returns TRUE if present and stores its value in
+// *value (if not NULL).
+
+static gboolean fingerprint_set_lookup(const FingerprintSet *set, guint64 key, guint32 *value) {
+    guint mask = set->capacity - 1;
+    for (guint i = (guint)fingerprint_mix(key) & mask; set->keys[i] != 0; i = (i + 1) & mask) {
+        if (set->keys[i] == key) {
+            if (value) *value = set->values[i];
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+
+// --------------------------------
+
+
+// Inserts a fingerprint with a value, doubling the table when it gets 3/4
+// full. Returns FALSE (and keeps the old value) if it was already present.
+
+static gboolean fingerprint_set_insert(FingerprintSet *set, guint64 key, guint32 value) {
+    if (fingerprint_set_lookup(set, key, NULL))
+        return FALSE;
+
+    if ((set->size + 1) * 4 > set->capacity * 3) {
+        guint64 *old_keys = set->keys;
+        guint32 *old_values = set->values;
+        guint old_capacity = set->capacity;
+
+        set->capacity *= 2;
+        set->keys = g_new0(guint64, set->capacity);
+        set->values = g_new0(guint32, set->capacity);
+        set->size = 0;
+        for (guint i = 0; i < old_capacity; ++i) {
+            if (old_keys[i] != 0) fingerprint_set_insert(set, old_keys[i], old_values[i]);
+        }
+        g_free(old_keys);
+        g_free(old_values);
+    }
+
+    guint mask = set->capacity - 1;
+    guint i = (guint)fingerprint_mix(key) & mask;
+    while (set->keys[i] != 0) i = (i + 1) & mask;
+    set->keys[i] = key;
+    set->values[i] = value;
+    set->size++;
+    return TRUE;
+}
+
+
+// --------------------------------
+
+
+// Creates an empty near-duplicate title index.
+
+static TitleIndex *title_index_new(void) {
+    TitleIndex *index = g_new0(TitleIndex, 1);
+    index->bands = fingerprint_set_new();
+    index->signatures = g_array_new(FALSE, FALSE, sizeof(TitleSignature));
+    return index;
+}
+
+
+// --------------------------------
+
+
+// Frees a title index (NULL is ignored).
+
+static void title_index_free(TitleIndex *index) {
+    if (!index) return;
+    fingerprint_set_free(index->bands);
+    g_array_free(index->signatures, TRUE);
+    g_free(index);
+}
+
+
+// --------------------------------
+
+
+// Computes the MinHash signature of a title: the title is reduced to
+// lowercase words separated by single spaces, cut into overlapping
+// TITLE_SHINGLE_SIZE-character shingles, and each signature value is the
+// smallest hash of any shingle under one of TITLE_MINHASH_SIZE hash
+// functions. Returns FALSE if the title has no full shingle.
+
+static gboolean title_signature(const char *title, guint32 *signature) {
+    char normalized[512];
+    size_t len = 0;
+
+    for (const char *c = title; *c && len < sizeof(normalized) - 1; ++c) {
+        if (g_ascii_isalnum(*c)) {
+            normalized[len++] = g_ascii_tolower(*c);
+        } else if (len > 0 && normalized[len - 1] != ' ') {
+            normalized[len++] = ' ';
+        }
+    }
+    if (len > 0 && normalized[len - 1] == ' ') len--;
+    if (len < TITLE_SHINGLE_SIZE) return FALSE;
+
+    for (int k = 0; k < TITLE_MINHASH_SIZE; ++k) signature[k] = G_MAXUINT32;
+
+    for (size_t i = 0; i + TITLE_SHINGLE_SIZE <= len; ++i) {
+        guint64 shingle = fingerprint_hash(normalized + i, TITLE_SHINGLE_SIZE);
+        for (int k = 0; k < TITLE_MINHASH_SIZE; ++k) {
+            guint32 h = (guint32)(fingerprint_mix(shingle + (guint64)(k + 1) * G_GUINT64_CONSTANT(0x9e3779b97f4a7c15)) >> 32);
+            if (h < signature[k]) signature[k] = h;
+        }
+    }
+    return TRUE;
+}
+
+
+// --------------------------------
+
+
+// Adds a site's title to the index unless it is a near duplicate of one
+// another site already added. Each band of the signature is looked up
+// first; a title filed under the same band key by a different site is
+// compared on the whole signature.
+// Returns TRUE if the title was new (and is now indexed), FALSE if it is
+// a near duplicate. Titles too short to shingle always count as new.
+
+static gboolean title_index_add(TitleIndex *index, const char *title, const RecipeSiteInfo *site) {
+    TitleSignature entry = { .site = site };
+    guint32 *signature = entry.values;
+    if (!title_signature(title, signature))
+        return TRUE;
+
+    const int rows = TITLE_MINHASH_SIZE / TITLE_LSH_BANDS;
+    guint64 band_keys[TITLE_LSH_BANDS];
+
+    for (int b = 0; b < TITLE_LSH_BANDS; ++b) {
+        band_keys[b] = fingerprint_hash((const char *)(signature + b * rows), sizeof(guint32) * rows) ^ (guint64)b;
+        if (band_keys[b] == 0) band_keys[b] = 1;
+
+        guint32 other;
+        if (!fingerprint_set_lookup(index->bands, band_keys[b], &other))
+            continue;
+
+        const TitleSignature *candidate = &g_array_index(index->signatures, TitleSignature, other);
+        if (candidate->site == site)
+            continue;
+
+        int agree = 0;
+        for (int k = 0; k < TITLE_MINHASH_SIZE; ++k) {
+            if (candidate->values[k] == signature[k]) agree++;
+        }
+        if (agree >= TITLE_NEAR_DUP_MIN_AGREE)
+            return FALSE;
+    }
+
+    guint32 id = index->signatures->len;
+    g_array_append_val(index->signatures, entry);
+    for (int b = 0; b < TITLE_LSH_BANDS; ++b) {
+        fingerprint_set_insert(index->bands, band_keys[b], id);
+    }
+    return TRUE;
+}
+
+
+// ==================
+
+
+/*
+ * STRING ARENA NOTES:
+ *
+ * Every accepted link used to be a g_strdup_printf("%s\x1f%s") heap
+ * string, built from a sanitized GString copy of the title, another of
+ * the href and a third for the full URL, plus a fourth copy as the
+ * duplicate filter's key; the UI then split it in place and copied both
+ * halves again into the result store. Now add_link() sanitizes into
+ * stack buffers and writes each link once, as a ResultRecord in the
+ * search's StringArena:
+ * - Records are referenced by 32-bit ResultRefs: parser output lists hold
+ *   GUINT_TO_POINTER(ref), the duplicate filter maps the canonical URL to
+ *   the ref, the result channel queues refs, and RecipeResult points its
+ *   title and URL straight at the record bytes.
+ * - The root search context creates the arena and its children share it,
+ *   so an "All Sites" search has one arena for every site.
+ * - Identical records are interned (the same link from the cache and the
+ *   parser is stored once).
+ * - The arena is reference counted by the contexts, the channel and the
+ *   results in the store; clearing the list for the next search drops
+ *   the last reference and frees every chunk at once.
+ * - The result cache keeps its "title\x1fURL" file format; entries are
+ *   loaded into and written from the arena.
+ */
+
+
+// Creates an empty string arena (one reference).
+
+static StringArena *string_arena_new(void) {
+    StringArena *arena = g_new0(StringArena, 1);
+    arena->ref_count = 1;
+    g_mutex_init(&arena->lock);
+    arena->interned = fingerprint_set_new();
+    return arena;
+}
+
+
+// --------------------------------
+
+
+// Adds a reference to a string arena and returns it.
+
+static StringArena *string_arena_ref(StringArena *arena) {
+    g_atomic_int_inc(&arena->ref_count);
+    return arena;
+}
+
+
+// --------------------------------
+
+
+// Drops one reference; the last one frees every record at once.
+
+static void string_arena_unref(StringArena *arena) {
+    if (!arena || !g_atomic_int_dec_and_test(&arena->ref_count))
+        return;
+
+    for (guint i = 0; i < arena->n_chunks; ++i) {
+        g_free(arena->chunks[i]);
+    }
+    fingerprint_set_free(arena->interned);
+    g_mutex_clear(&arena->lock);
+    g_free(arena);
+}
+
+
+// --------------------------------
+
+
+// Stores a title/URL record and returns its reference. If the same record
+// is already in the arena, the existing one is returned instead (interned).
+// Returns 0 if the record is larger than a chunk or the arena is full.
+// Safe from any thread.
+
+static ResultRef string_arena_add(StringArena *arena, const char *title, size_t title_len, const char *url, size_t url_len) {
+    size_t size = sizeof(ResultRecord) + title_len + 1 + url_len + 1;
+    size = (size + sizeof(guint32) - 1) & ~(sizeof(guint32) - 1);  // Keep records aligned
+    if (size > STRING_ARENA_CHUNK_SIZE - sizeof(guint64))
+        return 0;
+
+    guint64 key = fingerprint_mix(fingerprint_hash(title, title_len)) ^ fingerprint_hash(url, url_len);
+    if (key == 0) key = 1;
+
+    g_mutex_lock(&arena->lock);
+
+    // Interned copy?
+    ResultRef ref = 0;
+    if (fingerprint_set_lookup(arena->interned, key, &ref)) {
+        const ResultRecord *rec = string_arena_record(arena, ref);
+        if (rec->title_len == title_len && rec->url_len == url_len &&
+            memcmp(result_record_title(rec), title, title_len) == 0 &&
+            memcmp(result_record_url(rec), url, url_len) == 0) {
+            g_mutex_unlock(&arena->lock);
+            return ref;
+        }
+    }
+
+    // New chunk when the record does not fit in the current one. The first
+    // bytes of chunk 0 are skipped so no record gets reference 0.
+    if (arena->n_chunks == 0 || arena->used + size > STRING_ARENA_CHUNK_SIZE) {
+        if (arena->n_chunks == STRING_ARENA_MAX_CHUNKS) {
+            g_mutex_unlock(&arena->lock);
+            return 0;
+        }
+        arena->chunks[arena->n_chunks] = g_malloc(STRING_ARENA_CHUNK_SIZE);
+        arena->used = arena->n_chunks == 0 ? sizeof(guint64) : 0;
+        arena->n_chunks++;
+    }
+
+    guint chunk = arena->n_chunks - 1;
+    ResultRecord *rec = (ResultRecord *)(void *)(arena->chunks[chunk] + arena->used);
+    rec->title_len = (guint32)title_len;
+    rec->url_len = (guint32)url_len;
+    memcpy(rec->text, title, title_len);
+    rec->text[title_len] = '\0';
+    memcpy(rec->text + title_len + 1, url, url_len);
+    rec->text[title_len + 1 + url_len] = '\0';
+
+    ref = ((ResultRef)chunk << STRING_ARENA_CHUNK_BITS) | arena->used;
+    arena->used += (guint32)size;
+    arena->records++;
+    fingerprint_set_insert(arena->interned, key, ref);
+
+    g_mutex_unlock(&arena->lock);
+    return ref;
+}
+
+
+// --------------------------------
+
+
+// Resolves a record reference. Records never move, so the pointer stays
+// valid as long as the caller holds a reference on the arena.
+
+static const ResultRecord *string_arena_record(const StringArena *arena, ResultRef ref) {
+    const char *chunk = arena->chunks[ref >> STRING_ARENA_CHUNK_BITS];
+    return (const ResultRecord *)(const void *)(chunk + (ref & (STRING_ARENA_CHUNK_SIZE - 1)));
+}
+
+
+// --------------------------------
+
+
+// Title of a record (NUL-terminated).
+
+static const char *result_record_title(const ResultRecord *record) {
+    return record->text;
+}
+
+
+// --------------------------------
+
+
+// URL of a record (NUL-terminated).
+
+static const char *result_record_url(const ResultRecord *record) {
+    return record->text + record->title_len + 1;
+}
+
+
+// ==================
+
+
+// Adds a safe HTML link to the returned recipes using g_list_append.
+// Deduplicates on the canonical form of the URL (see canonicalize_url), so
+// tracking parameters, http/https, "www." and AMP variants of one page
+// count once, and uses the result budget (shared with any parent context)
+// to stop at the limit.
+// Accepted links are also published to the UI at once.
+// Cancelled searches add nothing.
+
+static void add_link(GList **out, const char* title, const char* base_url, const char* href, SearchContext *search) {
+    if (search_context_is_cancelled(search) ||
+        g_atomic_int_get(&search->result_total) >= search->result_limit) {
+        return;  // Limit reached (or search cancelled), skip adding more recipe links
+    }
+
+    // Make a sanitized copy of the title (for HTML safety) so we can format it
+    char temp_title[512];
+    sanitize_string(temp_title, sizeof(temp_title), title);
+
+    // Capitalize each word in the title
+    capitalize_each_word(temp_title);
+
+    // Build the full (sanitized) URL on the stack; a truncated URL would be broken
+    char full_url[STRING_ARENA_MAX_URL];
+    size_t base_len = g_strlcpy(full_url, base_url, sizeof(full_url));
+    if (base_len >= sizeof(full_url) || !sanitize_string(full_url + base_len, sizeof(full_url) - base_len, href)) {
+        fprintf(stderr, "[WARNING]: Skipping over-long recipe URL from %s.\n", search->site_name);
+        return;
+    }
+
+    // Add link if it's not a duplicate and the budget still has room. The
+    // record is written once into the search's arena; the list, the
+    // duplicate filter and the UI all refer to it.
+    char *canonical = canonicalize_url(full_url);
+    guint64 key = fingerprint_hash(canonical, strlen(canonical));
+    g_free(canonical);
+
+    if (fingerprint_set_lookup(search->link_set, key, NULL) || !search_context_claim_result(search))
+        return;  // Discard duplicate (or over-limit link)
+
+    ResultRef record = string_arena_add(search->arena, temp_title, strlen(temp_title), full_url, strlen(full_url));
+    if (!record)
+        return;  // Arena full
+
+    *out = g_list_append(*out, GUINT_TO_POINTER(record));
+    fingerprint_set_insert(search->link_set, key, record);
+    search_context_publish(search, record, search->link_set->size - 1);
+}
+
+
+// ------------------------------
+
+
+// Adds a site's fallback link (its search or recipe index page, offered
+// when the parser found nothing or failed) with add_link(), and counts it
+// in the context. A search that produced only fallback links is neither
+// cached nor treated as a success (see search_context_found_results).
+
+static void add_fallback_link(GList **out, const char *title, const char *url, SearchContext *search) {
+    guint before = search->link_set->size;
+    add_link(out, title, "", url, search);
+    if (search->link_set->size > before) {
+        g_atomic_int_inc(&search->fallback_links);
+    }
+}
+
+
+// ------------------------------
+
+
+
+// Helper: Trim leading and trailing spaces
+// Efficiently trims leading and trailing spaces from the input source, and
+// copies the trimmed result into the destination, adding a null terminator.
+// If the trimmed string is too long, it will be truncated safely.
+//
+// In most cases with typical recipe titles, no trimming is normally
+// needed, and 'src' is copied immediately to the 'dest' output buffer.
+//
+// If trimming is needed, the function uses pointers to scan the input:
+//   - It walks forward through input string 'src' to skip leading whitespace
+//   - It walks backward through 'src' to ignore trailing whitespace
+//
+// Note: This app does not use in-place processing (src == dest), so the
+// original string is not modified here.  This is safe for use in GTK apps
+// because it does not modify 'src', does not perform dynamic memory
+// allocation on the heap, and avoids freeing or interference with
+// GTK-managed string ownership.
+
+static void trim_whitespace(const char *src, char *dest, size_t dest_size) {
+
+    // Defensive check: ensure valid pointers and non-zero destination size.
+    if (!src || !dest || dest_size == 0) {
+        if (dest_size > 0) {
+            dest[0] = '\0';  // Null-terminate dest if possible.
+        }
+        return;
+    }
+
+    // Walk forward from the start of 'src' to skip leading whitespace characters.
+    const char *start = src;
+    while (*start && isspace((unsigned char)*start)) {
+        start++;
+    }
+
+    // Walk backward from the end of 'src' to find the last non-whitespace character.
+    const char *end = src + strlen(src);
+    while (end > start && isspace((unsigned char)*(end - 1))) {
+        end--;
+    }
+
+    size_t trimmed_len = (size_t)(end - start);
+
+    // Fast path: No leading or trailing spaces, and src != dest.
+    // Just copy src directly to dest and return early.
+    if (start == src && *end == '\0') {
+        if (src != dest) {
+            strncpy(dest, src, dest_size - 1);
+            dest[dest_size - 1] = '\0';  // Ensure null termination.
+        }
+        return;
+    }
+
+    // Now we know trimming was done, so copy the trimmed substring safely.
+
+    // Shorten trimmed_len if it exceeds the destination buffer size.
+    if (trimmed_len >= dest_size) {
+        trimmed_len = dest_size - 1;
+    }
+
+    // Copy the trimmed section of src into dest.
+    memcpy(dest, start, trimmed_len);
+
+    // Null-terminate the destination string.
+    dest[trimmed_len] = '\0';
+}
+
+
+
+// ------------------------------
+
+
+// Helper to Capitalize Each Word In A String
+static void capitalize_each_word(char *str) {
+    bool capitalize_next = true;
+    for (char *p = str; *p; ++p) {
+        if (capitalize_next && isalpha((unsigned char)*p)) {
+            *p = toupper((unsigned char)*p);
+            capitalize_next = false;
+        } else {
+            *p = tolower((unsigned char)*p);
+        }
+
+        if (*p == ' ') {
+            capitalize_next = true;
+        }
+    }
+}
+
+
+// ------------------------------
+
+
+
+// Sanitize Input String:
+// Copies 'src' into the dst_size buffer 'dst', removing control characters
+// (except allowed printable ASCII bytes) to avoid crashes or blank recipe
+// titles. Returns FALSE if the copy had to be truncated.
+// Note: This approach may show two replacement question-mark
+// characters (??) for a single accented character if the input
+// contains invalid or multi-byte UTF-8 sequences.
+// This simple method trades off perfect replacement of accented characters
+// for stability and consistent, non-empty output suitable for UI display.
+// Previous frustrating attempts to implement full UTF-8 normalization and
+// accent-stripping logic were complicated by:
+// - Difficulty reliably converting accented characters to plain ASCII
+// - Invalid or malformed UTF-8 sequences causing normalization failures
+// - Complex Unicode handling with longer execution times, resulting in empty
+//   or blank output strings
+
+
+static gboolean sanitize_string(char *dst, size_t dst_size, const char *src) {
+    size_t len = 0;
+    const unsigned char *p = (const unsigned char *)src;
+
+    for (; *p && len + 1 < dst_size; ++p) {
+        if (*p >= 32 && *p != 127) {
+            dst[len++] = (char)*p;
+        }
+    }
+    if (dst_size > 0) dst[len] = '\0';
+    return *p == '\0';
+}
+
+
+// ------------------------------
+
+
+
+// Helper function that simplistically singularizes English recipe words and
+// search terms to singular form.
+// Used for search terms sent to sites, where a protected plural reads
+// better unchanged. Title matching uses stem_recipe_word() instead.
+// Checks against exceptions word list and phrase list which are always
+//   preserved as-is, and applies singularization safely. 
+// Uses trim_whitespace() to clean output.
+// Summary:
+// If src is NULL or dstlen == 0:
+//    Writes an empty string ("") into dst (if space allows).
+// If src matches one of the protected multi-word phrases (e.g., "cream cheese", "olive oil"):
+//    Copies the phrase unchanged into dst.
+// If src matches one of the protected words (e.g., "anchovies", "eggs"):
+//     Copies the word unchanged into dst.
+// If the word ends with "ies":
+//    Converts it to end with "y" (e.g., "berries" → "berry").
+// If the word ends with s (longer than 1 char):
+//    Strips the final "s" (e.g., "cakes" → "cake").
+// Otherwise:
+//    Copies src unchanged into dst.
+
+static void singularize(const char *src, char *dst, size_t dstlen) {
+    if (!src || dstlen == 0) {
+        if (dstlen > 0) dst[0] = '\0';
+        return;
+    }
+
+    // Exceptions word list: always preserved as-is (plural or not)
+    static const char *protected_recipe_words[] = {
+        "anchovies",
+        "bagels",
+        "beans",
+        "berries",
+        "brownies",
+        "buns",
+        "carrots",
+        "chaffles",
+        "chips",
+        "clams",
+        "cookies",
+        "crackers",
+        "cupcakes",
+        "dumplings",
+        "eggs",
+        "fries",
+        "greens",
+        "grits",
+        "herbs",
+        "lentils",
+        "loaves",
+        "meatballs",
+        "muffins",
+        "mussels",
+        "nachos",
+        "noodles",
+        "nuts",
+        "olives",
+        "pancakes",
+        "peppers",
+        "pickles",
+        "pies",
+        "ribs",
+        "sandwiches",
+        "sausages",
+        "scallops",
+        "seeds",
+        "shrimp",
+        "snacks",
+        "spaghetti",
+        "spices",
+        "sprouts",
+        "sweets",
+        "tacos",
+        "treats",
+        "vegetables",
+        "veggies",
+        "waffles",
+        "wraps",
+        "zoodles",
+        NULL
+    };
+
+    // Protected multi-word recipe phrases where singularizing words
+    // would distort meaning and thus should be preserved as-is.
+    static const char *protected_recipe_phrases[] = {
+        "apple cider",
+        "apple slices",
+        "baking powder",
+        "baking soda",
+        "bread crumbs",
+        "brown rice",
+        "brown sugar",
+        "cocoa powder",
+        "chocolate chips",
+        "cooking oil",
+        "corn flakes",
+        "cream cheese",
+        "cream of tartar",
+        "cream sauce",
+        "dark chocolate",
+        "fried oysters",
+        "french fries",
+        "green beans",
+        "green onions",
+        "green peas",
+        "hot chili",
+        "hot dogs",
+        "hot sauce",
+        "lemon zest",
+        "mixed nuts",
+        "olive oil",
+        "orange juice",
+        "potato chips",
+        "red onions",
+        "red pepper",
+        "soy sauce",
+        "strawberry jam",
+        "sweet chili",
+        "sweet corn",
+        "sweet potatoes",
+        "vanilla extract",
+        "whole wheat",
+        NULL
+    };
+
+    char trimmed_src[256];
+    trim_whitespace(src, trimmed_src, sizeof(trimmed_src));
+    // Check for protected multi-word phrases (case-insensitive)
+    for (int i = 0; protected_recipe_phrases[i]; ++i) {
+        if (strcasecmp(trimmed_src, protected_recipe_phrases[i]) == 0) {
+            snprintf(dst, dstlen, "%s", trimmed_src);
+            return;
+        }
+    }
+    // Check exceptions word list
+    for (int i = 0; protected_recipe_words[i]; ++i) {
+        if (strcasecmp(trimmed_src, protected_recipe_words[i]) == 0) {
+            snprintf(dst, dstlen, "%s", trimmed_src);
+            return;
+        }
+    }
+    size_t len = strlen(trimmed_src);
+    // Rule: convert "ies" to "y"
+    if (len > 3 && strcasecmp(trimmed_src + len - 3, "ies") == 0) {
+        snprintf(dst, dstlen, "%.*sy", (int)(len - 3), trimmed_src);
+        return;
+    }
+    // Rule: remove trailing 's' if longer than 1 char
+    if (len > 1 && (trimmed_src[len - 1] == 's' || trimmed_src[len - 1] == 'S')) {
+        snprintf(dst, dstlen, "%.*s", (int)(len - 1), trimmed_src);
+        return;
+    }
+    // Default: copy trimmed input as-is
+    snprintf(dst, dstlen, "%s", trimmed_src);
+}
+
+
+// ------------------------------
+
+
+// Reduces a lowercase word to its singular stem for title matching, so a
+// query word and a title word match in either number. Unlike singularize()
+// there are no protected words: "dumplings" stems to "dumpling" and
+// "cookies" to "cookie". Matches are word-start prefixes (see
+// token_matcher_new), so a stem only needs to begin both forms.
+// Rules, first match wins:
+//   - A few irregular plurals ("loaves" → "loaf").
+//   - "ies": "ie" for the -ie nouns below and short words ("pies" → "pie"),
+//     otherwise "y" ("berries" → "berry").
+//   - "oes", "ches", "shes", "sses", "xes", "zes": drop "es"
+//     ("tomatoes" → "tomato", "sandwiches" → "sandwich").
+//   - Words ending in "ss" are kept; other words longer than three
+//     characters drop a final "s" ("eggs" → "egg").
+
+static void stem_recipe_word(const char *src, char *dst, size_t dstlen) {
+    if (!src || dstlen == 0) {
+        if (dstlen > 0) dst[0] = '\0';
+        return;
+    }
+
+    static const char *irregular_plurals[][2] = {
+        { "halves", "half" },
+        { "knives", "knife" },
+        { "leaves", "leaf" },
+        { "loaves", "loaf" },
+    };
+
+    // Singulars ending in "ie", whose plural would otherwise become "-y"
+    static const char *ie_plurals[] = {
+        "brownies",
+        "cookies",
+        "hoagies",
+        "smoothies",
+        "veggies",
+        NULL
+    };
+
+    size_t len = strlen(src);
+
+    for (size_t i = 0; i < G_N_ELEMENTS(irregular_plurals); ++i) {
+        if (strcmp(src, irregular_plurals[i][0]) == 0) {
+            g_strlcpy(dst, irregular_plurals[i][1], dstlen);
+            return;
+        }
+    }
+
+    if (len > 3 && g_str_has_suffix(src, "ies")) {
+        gboolean ie = len <= 5;  // "pies", "ties"
+        for (int i = 0; !ie && ie_plurals[i]; ++i)
+            ie = strcmp(src, ie_plurals[i]) == 0;
+        if (ie) {
+            snprintf(dst, dstlen, "%.*s", (int)(len - 1), src);
+        } else {
+            snprintf(dst, dstlen, "%.*sy", (int)(len - 3), src);
+        }
+        return;
+    }
+
+    static const char *es_endings[] = { "oes", "ches", "shes", "sses", "xes", "zes", NULL };
+    for (int i = 0; es_endings[i]; ++i) {
+        if (len > strlen(es_endings[i]) && g_str_has_suffix(src, es_endings[i])) {
+            snprintf(dst, dstlen, "%.*s", (int)(len - 2), src);
+            return;
+        }
+    }
+
+    if (len > 3 && src[len - 1] == 's' && src[len - 2] != 's') {
+        snprintf(dst, dstlen, "%.*s", (int)(len - 1), src);
+        return;
+    }
+    g_strlcpy(dst, src, dstlen);
+}
+
+
+// ------------------------------
+
+
+// Rewrites recipe titles that have a trailing block of digits so they are
+//   more human-friendly and visually separated.
+// Splits a recipe title into two parts: the descriptive name and a trailing
+//   numeric rating block (e.g., 1,234 Ratings).
+// Uused when parsing recipe titles from websites where the site includes
+//   numbers (ratings, votes, or counts) at the end of the title string
+// without clean separation.
+// It makes the recipe titles easier to read in the GTK listbox/buttons by
+//   inserting " - " before the number block.
+// If a number appears at the end of the title (with optional commas),
+// it inserts " - " before the number block for readability.
+// Special handling:
+// - Leaves titles unchanged if numbers are embedded in words (e.g., "Rib1234").
+// - Adds a space before an opening parenthesis if the number block is wrapped
+// Returns a newly allocated string that must be freed by the caller.
+// Examples:
+//   "Delicious Chicken Soup1,234 Ratings" -->"Delicious Chicken Soup - 1,234 Ratings"
+//   "Amazing Ribs(1,234 Ratings)" --> "Amazing Ribs ( - 1,234 Ratings)"
+//   "Best Rib1234" --> "Rib1234"
+//  "Taco Recipes" --> "Taco Recipes"
+// What it does step-by-step:
+//   1. Scan from the end of the string to find the last digit.
+//        If no digits → return the original title unchanged.
+//  2. Identify the whole block of digits (e.g., "1234" or "1,234") by
+//      walking backward.
+//  3. Safety check: If the digits are part of a word (like "Rib1234"),
+//      don’t split ==> return unchanged.
+//  4. Special case: If the digits are immediately after a parenthesis
+//       (e.g., "Ribs(1,234 Ratings)"), insert a space before (.
+
+static char *split_title_and_digits(const char *title) {
+    if (!title) return NULL;
+
+    size_t len = strlen(title);
+    if (len == 0) return strdup("");
+
+    // Step 1: Find the last digit in the string
+    ssize_t end = -1;
+    for (ssize_t i = len - 1; i >= 0; i--) {
+        if (isdigit((unsigned char)title[i])) {
+            end = i;
+            break;
+        }
+    }
+
+    if (end == -1) return strdup(title);  // No digits found
+
+    // Step 2: Walk backwards to find the start of the digit block (including commas)
+    ssize_t start = end;
+    while (start > 0 && (isdigit((unsigned char)title[start - 1]) || title[start - 1] == ',')) {
+        start--;
+    }
+
+    // Step 3: Avoid splitting embedded numbers (e.g., Rib1234)
+    if (start > 0 && isalpha((unsigned char)title[start - 1])) {
+        return strdup(title);
+    }
+
+    // Step 4: Check for tight parenthesis, e.g. "Ribs(1,234 Ratings)"
+    // Insert a space before '(' if needed
+    int insert_space_before_paren = 0;
+    if (start > 0 && title[start - 1] == '(') {
+        insert_space_before_paren = 1;
+        start--;  // Include the '(' in the part1
+    }
+
+    // Step 5: Find where the tail starts (after the digit block)
+    size_t tail_start = end + 1;
+    size_t tail_len = len - tail_start;
+
+    // Compose output: [part1] + " - " + [digits] + [tail]
+    size_t part1_len = start;
+    size_t digits_len = end - start + 1;
+
+    // +1 extra space if we're inserting before '('
+    size_t out_len = part1_len + insert_space_before_paren + 3 + digits_len + tail_len + 1;
+
+    char *out = malloc(out_len);
+    if (!out) return NULL;
+
+    char *p = out;
+
+    // Copy part1
+    memcpy(p, title, part1_len);
+    p += part1_len;
+
+    if (insert_space_before_paren) {
+        *p++ = ' ';
+    }
+
+    // Add " - "
+    memcpy(p, " - ", 3);
+    p += 3;
+
+    // Copy digits
+    memcpy(p, title + start, digits_len);
+    p += digits_len;
+
+    // Copy tail
+    memcpy(p, title + tail_start, tail_len);
+    p += tail_len;
+
+    *p = '\0';
+
+    return out;
+}
+
+
+// ------------------------------
+// ------------------------------
+// ------------------------------
+
+
+/*
+ * Extracts quoted phrases from a user’s search string, preserving
+ * multi-word terms exactly as typed.
+ *
+ * JM: This is an experimental function, and prints debug info to the terminal
+ *
+ * Behavior:
+ * - Normalize fancy / curly quote marks ==> ASCII).
+ * - Extract complete quoted phrases; ignore unmatched quotes.
+ * - Preserve punctuation/apostrophes inside phrases.
+ * - Lowercase and trim each phrase.
+ * - Ignore unquoted words.
+ * - Return space-separated phrases (no quotes).
+ * - Overall, it preserves meaningful search term grouping and punctuation
+ *   within the string, and presents it as an unquoted, flat string to
+ *   downstream search systems.
+ *
+ * Example:
+ *   Input:  "Grilled Cheese" and ‘Oyster Po’ Boys’ or 'Tomato Soup'
+ *   Output: grilled cheese oyster po' boys tomato soup
+ *
+ * Notes:
+ * - Input must be UTF-8; only ASCII quotes are normalized.
+ * - Output string must be freed with g_free().
+ * - This design follows a similar philosophy to how Google handles quoted
+ *   search terms: quoted phrases are treated as exact terms. Unquoted terms
+ *   are typically tokenized into individual words by most search engines, but
+ *   in this function, we ignore them entirely to focus on strong user intent.
+ */
+
+char *extract_quoted_terms(const char *search_term) {
+    if (!search_term) return NULL;
+
+    // Duplicate input into a mutable buffer so we can modify it
+    char *input = g_strdup(search_term);
+    normalize_quotes_utf8(input);
+
+    GString *result = g_string_new(NULL);
+    char *p = input;
+
+    printf("[DEBUG]: Starting function extract_quoted_terms:\n%s\n", search_term);
+    printf("[DEBUG]: Input string address: %p\n\n", (void *)search_term);
+
+    while (*p) {
+        if (*p == '"' || *p == '\'') {
+            printf("[DEBUG] Found quote: %c at position: %td\n", *p, p - input);
+            char quote = *p++;
+            char *start = p;
+            char *end = strchr(start, quote);
+            if (!end) {
+                printf("[DEBUG] No closing quote found. Remaining string: %s\n", start);
+                break;
+            }
+
+            size_t len = end - start;
+            if (len > 0) {
+                char *term = g_strndup(start, len);
+                char *trimmed = g_strstrip(term);
+                char *processed = g_ascii_strdown(trimmed, -1);
+
+                printf("[DEBUG] Found quoted term: %s\n", term);
+                printf("[DEBUG] Processed term: %s\n", processed);
+
+                if (result->len > 0)
+                    g_string_append_c(result, ' ');
+                g_string_append(result, processed);
+
+                g_free(term);
+                g_free(processed);
+            } else {
+                printf("[DEBUG] Empty quoted string found\n");
+            }
+
+            p = end + 1;
+        } else {
+            p++;
+        }
+    }
+
+    g_free(input);
+
+    if (result->len > 0) {
+        printf("[DEBUG] Total recipes that matched quoted search term: %zu\n\n", result->len);
+    } else {
+        printf("[DEBUG] No quoted search term found.\n\n");
+    }
+
+    // Caller must g_free() this result.
+    return g_string_free(result, FALSE);
+}
+
+
+// ------------------------------
+
+
+static GList* extract_quoted_phrases(const char *search_term) {
+    if (!search_term) return NULL;
+
+    // Duplicate input to mutable buffer
+    char *input = g_strdup(search_term);
+    normalize_quotes_utf8(input);
+
+    GList *phrases = NULL;
+    char *p = input;
+
+    while (*p) {
+        if (*p == '"' || *p == '\'') {
+            char quote = *p++;
+            char *start = p;
+            char *end = strchr(start, quote);
+            if (!end) {
+                // No closing quote; stop processing further
+                break;
+            }
+
+            size_t len = end - start;
+            if (len > 0) {
+                char *term = g_strndup(start, len);
+                char *trimmed = g_strstrip(term);
+                char *processed = g_ascii_strdown(trimmed, -1);
+
+                // Append the full quoted phrase as one string
+                phrases = g_list_append(phrases, processed);
+
+                g_free(term);
+                // Note: processed is stored in list, so do not free here
+            }
+            p = end + 1;
+        } else {
+            p++;
+        }
+    }
+
+    g_free(input);
+    return phrases; // caller must free list and strings
+}
+
+
+// ------------------------------
+
+
+
+// Normalize single and double curly quote marks in-place to ASCII quotes.
+// This can expanded later to handle more UTF-8 symbols if needed.
+
+static void normalize_quotes_utf8(char *str) {
+    if (!str) return;
+
+    for (; *str; ++str) {
+        unsigned char c = (unsigned char)*str;
+
+        switch (c) {
+            // ASCII-compatible replacement for common curly quotes:
+            case 0xE2: {
+                if ((unsigned char)str[1] == 0x80) {
+                    switch ((unsigned char)str[2]) {
+                        case 0x98: // ‘
+                        case 0x99: // ’
+                            *str = '\'';
+                            str[1] = str[2] = ' ';
+                            break;
+                        case 0x9C: // “
+                        case 0x9D: // ”
+                            *str = '"';
+                            str[1] = str[2] = ' ';
+                            break;
+                    }
+                }
+                break;
+            }
+        }
+    }
+}
+
+
+
+// ------------------------------
+
+
+static QuoteStatus detect_quote_status(const char *search_term) {
+    int single_quotes = 0;
+    int double_quotes = 0;
+
+    for (const char *p = search_term; *p; p++) {
+        if (*p == '\'') single_quotes++;
+        else if (*p == '"') double_quotes++;
+    }
+
+    if ((single_quotes > 0 && single_quotes % 2 == 0) ||
+        (double_quotes > 0 && double_quotes % 2 == 0)) {
+        return QUOTE_PAIR;
+    }
+
+    if (single_quotes > 0 || double_quotes > 0) {
+        return QUOTE_SINGLE;
+    }
+
+    return QUOTE_NONE;
+}
+
+
+
+// ---------------------------------------------------------------------------
+// ---------------------------------------------------------------------------
+
+
+// The following two functions work together as a text preprocessing utility
+//   that extracts meaningful keywords from recipe titles, the user's input.
+// These functions are handy to:
+//    - Parse recipe titles or user search queries into keywords.
+//    -  Improve search matching (ignoring filler words).
+//    - Build tags or indexes from recipe names.
+// For example:
+//    User searches for: "The Best Soup in the World"
+//    After filtering: [best soup world] becomes the key search words, which
+//      match recipes more effectively by comparing only meaningful words.
+
+// Stop-Words List
+// Purpose:
+// Checks whether a given word is a stop word (commonly ignored words).
+// Implementation:
+//   It loops through the stop_words[] list.
+//   Uses g_ascii_strcasecmp() (case-insensitive compare).
+//   Returns TRUE if the word matches a stop word, otherwise FALSE.
+
+static const char *stop_words[] = {
+    "a", "an", "the", "and", "or", "with", "of", "in", "on", "at", "to", "for", "by", NULL
+};
+
+// Check if word is stop word (case-insensitive)
+static gboolean is_stop_word(const char *word) {
+    if (!word) return FALSE;
+
+    for (int i = 0; stop_words[i] != NULL; i++) {
+        if (g_ascii_strcasecmp(word, stop_words[i]) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Tokenizes, lowercases, filters stop words, returns GList of tokens
+// Purpose:
+// Takes a full phrase, splits it into words (tokens), lowercases them, removes
+//    stop words, and returns the remaining tokens in a GList.
+//  Implementation:
+//    1. Converts the entire input phrase to lowercase (g_ascii_strdown).
+//    2. Tokenizes by spaces (strtok_r).
+//    3. Skips stop words using is_stop_word().
+//    4.	Adds remaining words to a GList (each word duplicated with g_strdup()so they survive after freeing the input buffer).
+//    5.Returns the GList * of filtered tokens.
+
+GList *tokenize_and_filter_stop_words(const char *phrase) {
+    if (!phrase) return NULL;
+
+    // Duplicate and lowercase input for tokenization
+    char *input = g_ascii_strdown(phrase, -1);
+    GList *filtered_tokens = NULL;
+
+    // Tokenize by space
+    char *saveptr = NULL;
+    char *token = strtok_r(input, " ", &saveptr);
+
+    while (token) {
+        if (!is_stop_word(token)) {
+            // Add to filtered list (dup because input will be freed)
+            filtered_tokens = g_list_append(filtered_tokens, g_strdup(token));
+        }
+        token = strtok_r(NULL, " ", &saveptr);
+    }
+
+    g_free(input);
+    return filtered_tokens;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Builds the matcher of a quoted search: the quoted phrases, combined,
+// tokenized and stop-word filtered. Returns NULL if the search has no
+// quoted phrase with a meaningful word.
+// Called once per search (see result_channel_new), instead of once per
+// result title.
+
+static TokenMatcher *token_matcher_new_for_quoted_search(const char *search_term) {
+    GList *quoted_phrases = extract_quoted_phrases(search_term);
+    if (!quoted_phrases) return NULL;
+
+    printf("[INFO]: Extracted quoted phrases:\n");
+    for (GList *iter = quoted_phrases; iter; iter = iter->next)
+        printf("%s \n", (char *)iter->data);
+
+    // Build combined string of phrases
+    GString *combined = g_string_new("");
+    for (GList *iter = quoted_phrases; iter; iter = iter->next) {
+        if (combined->len > 0) g_string_append_c(combined, ' ');
+        g_string_append(combined, (char *)iter->data);
+    }
+    g_list_free_full(quoted_phrases, g_free);
+
+    // Tokenize and filter stop words
+    GList *tokens = tokenize_and_filter_stop_words(combined->str);
+    g_string_free(combined, TRUE);
+
+    TokenMatcher *matcher = tokens ? token_matcher_new(tokens) : NULL;
+    g_list_free_full(tokens, g_free);
+
+    if (matcher) {
+        printf("[INFO]: Using decisive search term (partial_search_term):\n");
+        for (guint i = 0; i < matcher->tokens->len; ++i)
+            printf("%s%s", i ? " " : "", (char *)g_ptr_array_index(matcher->tokens, i));
+        printf("\n\n");
+    }
+    return matcher;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Compiles tokens (already lowercase, as from tokenize_and_filter_stop_words)
+// into an Aho-Corasick automaton.
+// Matching rules, applied by token_matcher_scan():
+//   - Case-insensitive (ASCII), like the strstr() on a lowercased title it
+//     replaces.
+//   - A token must start at a word boundary, so "ham" no longer matches
+//     inside "graham", while "roast" still matches "roasted".
+//   - Singular and plural are equivalent: each token also matches its
+//     stem_recipe_word() form, so "dumplings" matches "Pork Dumpling Soup"
+//     and "cookies" matches "Sugar Cookie Bars". Tokens with the same stem
+//     count as one token.
+//   - Duplicate tokens are compiled once; at most TOKEN_MATCHER_MAX_TOKENS.
+// The automaton is a full DFA: after compilation every state has a
+// transition for every byte class, so scanning never follows fail links.
+
+static TokenMatcher *token_matcher_new(GList *tokens) {
+    TokenMatcher *matcher = g_new0(TokenMatcher, 1);
+    matcher->tokens = g_ptr_array_new_with_free_func(g_free);
+
+    // Distinct tokens (by singular form), the patterns spelling them, and
+    // the alphabet they use
+    GPtrArray *singulars = g_ptr_array_new_with_free_func(g_free);
+    GPtrArray *patterns = g_ptr_array_new();       // Borrowed from tokens/singulars
+    GArray *pattern_token = g_array_new(FALSE, FALSE, sizeof(guint));
+    size_t total_len = 0;
+
+    for (GList *l = tokens; l; l = l->next) {
+        const char *token = l->data;
+        if (!*token || matcher->tokens->len >= TOKEN_MATCHER_MAX_TOKENS)
+            continue;
+
+        char singular[256];
+        stem_recipe_word(token, singular, sizeof(singular));
+        if (!*singular) g_strlcpy(singular, token, sizeof(singular));
+
+        gboolean seen = FALSE;
+        for (guint i = 0; i < singulars->len && !seen; ++i)
+            seen = strcmp(g_ptr_array_index(singulars, i), singular) == 0;
+        if (seen)
+            continue;
+
+        guint t = matcher->tokens->len;
+        g_ptr_array_add(matcher->tokens, g_strdup(token));
+        g_ptr_array_add(singulars, g_strdup(singular));
+
+        const char *forms[2] = { g_ptr_array_index(matcher->tokens, t), g_ptr_array_index(singulars, t) };
+        for (int f = 0; f < 2; ++f) {
+            if (f == 1 && strcmp(forms[0], forms[1]) == 0)
+                break;
+            g_ptr_array_add(patterns, (gpointer)forms[f]);
+            g_array_append_val(pattern_token, t);
+            total_len += strlen(forms[f]);
+            for (const guchar *c = (const guchar *)forms[f]; *c; ++c) {
+                if (matcher->byte_class[*c] == 0)
+                    matcher->byte_class[*c] = (guint8)++matcher->n_classes;
+            }
+        }
+    }
+    matcher->n_classes++;  // Class 0: bytes that occur in no token
+
+    // Trie (at most one state per pattern byte, plus the root)
+    guint max_states = (guint)total_len + 1;
+    guint n = matcher->n_classes;
+    matcher->next = g_new(gint, (gsize)max_states * n);
+    matcher->output = g_new(gint, max_states);
+    matcher->dict_link = g_new(gint, max_states);
+    matcher->depth = g_new0(gint, max_states);
+    for (gsize i = 0; i < (gsize)max_states * n; ++i) matcher->next[i] = -1;
+    for (guint i = 0; i < max_states; ++i) matcher->output[i] = matcher->dict_link[i] = -1;
+    matcher->n_states = 1;
+
+    for (guint p = 0; p < patterns->len; ++p) {
+        gint state = 0;
+        for (const guchar *c = g_ptr_array_index(patterns, p); *c; ++c) {
+            gint *slot = &matcher->next[state * n + matcher->byte_class[*c]];
+            if (*slot < 0) {
+                *slot = (gint)matcher->n_states++;
+                matcher->depth[*slot] = matcher->depth[state] + 1;
+            }
+            state = *slot;
+        }
+        matcher->output[state] = (gint)g_array_index(pattern_token, guint, p);
+    }
+
+    g_array_free(pattern_token, TRUE);
+    g_ptr_array_free(patterns, TRUE);
+    g_ptr_array_free(singulars, TRUE);
+
+    // Breadth-first pass: fail links become DFA transitions, and each state
+    // learns the nearest shorter token ending with it (dictionary link)
+    gint *fail = g_new0(gint, matcher->n_states);
+    gint *queue = g_new(gint, matcher->n_states);
+    guint head = 0, tail = 0;
+
+    for (guint c = 0; c < n; ++c) {
+        gint child = matcher->next[c];
+        if (child < 0) {
+            matcher->next[c] = 0;
+        } else {
+            fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+
+    while (head < tail) {
+        gint state = queue[head++];
+        for (guint c = 0; c < n; ++c) {
+            gint child = matcher->next[state * n + c];
+            gint via_fail = matcher->next[fail[state] * n + c];
+            if (child < 0) {
+                matcher->next[state * n + c] = via_fail;
+            } else {
+                fail[child] = via_fail;
+                matcher->dict_link[child] = matcher->output[via_fail] >= 0 ? via_fail : matcher->dict_link[via_fail];
+                queue[tail++] = child;
+            }
+        }
+    }
+
+    g_free(queue);
+    g_free(fail);
+    return matcher;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Frees a token matcher.
+
+static void token_matcher_free(TokenMatcher *matcher) {
+    if (!matcher) return;
+    g_ptr_array_free(matcher->tokens, TRUE);
+    g_free(matcher->next);
+    g_free(matcher->output);
+    g_free(matcher->dict_link);
+    g_free(matcher->depth);
+    g_free(matcher);
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Scans text once and appends every token occurrence that starts at a word
+// boundary to 'matches' (TokenMatch, in text order of their end). The array
+// is cleared first, so one scratch array can serve every title.
+// Returns the number of distinct tokens found.
+
+static guint token_matcher_scan(const TokenMatcher *matcher, const char *text, GArray *matches) {
+    g_array_set_size(matches, 0);
+
+    guint64 found = 0;
+    gint state = 0;
+    guint n = matcher->n_classes;
+
+    for (guint i = 0; text[i]; ++i) {
+        guchar c = (guchar)g_ascii_tolower(text[i]);
+        state = matcher->next[state * n + matcher->byte_class[c]];
+
+        gint s = matcher->output[state] >= 0 ? state : matcher->dict_link[state];
+        for (; s >= 0; s = matcher->dict_link[s]) {
+            guint token = (guint)matcher->output[s];
+            guint len = (guint)matcher->depth[s];
+            guint start = i + 1 - len;
+
+            // Word-start occurrences only
+            if (start > 0 && g_ascii_isalnum(text[start - 1]))
+                continue;
+
+            TokenMatch match = { token, start, len };
+            g_array_append_val(matches, match);
+            found |= G_GUINT64_CONSTANT(1) << token;
+        }
+    }
+
+    guint distinct = 0;
+    for (; found; found &= found - 1) distinct++;
+    return distinct;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Proximity of a match: the length in bytes of the shortest stretch of text
+// that contains at least one occurrence of every distinct token found by
+// token_matcher_scan(). 0 if nothing matched.
+
+static guint token_matches_span(const GArray *matches) {
+    if (matches->len == 0) return 0;
+
+    // Occurrences sorted by start offset (scan order is by end offset)
+    GArray *sorted = g_array_sized_new(FALSE, FALSE, sizeof(TokenMatch), matches->len);
+    g_array_append_vals(sorted, matches->data, matches->len);
+    for (guint i = 1; i < sorted->len; ++i) {
+        TokenMatch m = g_array_index(sorted, TokenMatch, i);
+        guint j = i;
+        for (; j > 0 && g_array_index(sorted, TokenMatch, j - 1).offset > m.offset; --j)
+            g_array_index(sorted, TokenMatch, j) = g_array_index(sorted, TokenMatch, j - 1);
+        g_array_index(sorted, TokenMatch, j) = m;
+    }
+
+    guint64 wanted = 0;
+    for (guint i = 0; i < sorted->len; ++i)
+        wanted |= G_GUINT64_CONSTANT(1) << g_array_index(sorted, TokenMatch, i).token;
+
+    // Sliding window over the occurrences
+    guint counts[TOKEN_MATCHER_MAX_TOKENS] = { 0 };
+    guint64 covered = 0;
+    guint best = G_MAXUINT;
+    guint left = 0;
+
+    for (guint right = 0; right < sorted->len; ++right) {
+        TokenMatch r = g_array_index(sorted, TokenMatch, right);
+        if (counts[r.token]++ == 0) covered |= G_GUINT64_CONSTANT(1) << r.token;
+
+        while (covered == wanted) {
+            TokenMatch l = g_array_index(sorted, TokenMatch, left);
+            guint end = 0;
+            for (guint k = left; k <= right; ++k) {
+                TokenMatch m = g_array_index(sorted, TokenMatch, k);
+                if (m.offset + m.length > end) end = m.offset + m.length;
+            }
+            if (end - l.offset < best) best = end - l.offset;
+
+            if (--counts[l.token] == 0) covered &= ~(G_GUINT64_CONSTANT(1) << l.token);
+            left++;
+        }
+    }
+
+    g_array_free(sorted, TRUE);
+    return best == G_MAXUINT ? 0 : best;
+}
+
+
+// ---------------------------------------------------------------------------
+
+
+// Phrase adjacency: counts the pairs of consecutive search tokens (in query
+// order) that occur side by side in the text, with nothing but spaces or
+// punctuation between them. "roasted chicken" has one such pair in
+// "Roasted Chicken Thighs" and none in "Chicken, Garlic & Roasted Potatoes".
+
+static guint token_matches_adjacent_pairs(const TokenMatcher *matcher, const char *text, const GArray *matches) {
+    guint pairs = 0;
+
+    for (guint t = 0; t + 1 < matcher->tokens->len; ++t) {
+        gboolean adjacent = FALSE;
+
+        for (guint i = 0; i < matches->len && !adjacent; ++i) {
+            TokenMatch a = g_array_index(matches, TokenMatch, i);
+            if (a.token != t) continue;
+
+            for (guint j = 0; j < matches->len && !adjacent; ++j) {
+                TokenMatch b = g_array_index(matches, TokenMatch, j);
+                guint gap_start = a.offset + a.length;
+                if (b.token != t + 1 || b.offset < gap_start) continue;
+
+                adjacent = TRUE;
+                for (guint k = gap_start; k < b.offset && adjacent; ++k)
+                    adjacent = !g_ascii_isalnum(text[k]);
+            }
+        }
+        if (adjacent) pairs++;
+    }
+    return pairs;
+}
+
+
+// ==================
+
+
+/*
+ * RESULT RANKING NOTES:
+ *
+ * Results used to be listed in the order the parsers happened to emit
+ * them, and a search stopped listing once its result budget tripped, so
+ * an "All Sites" search showed whichever sites answered first. Now every
+ * result is scored as it arrives and only the best RESULT_TOP_K are kept:
+ * - The score (result_ranker_score) adds up weighted parts in [0, 1]:
+ *     coverage     share of the search tokens found in the title
+ *                  (plural and singular forms count the same);
+ *     adjacency    share of consecutive search tokens found side by side,
+ *                  so the phrase itself beats scattered words;
+ *     conciseness  share of the title's words that are search tokens, so
+ *                  "Roasted Chicken" beats a long title that merely
+ *                  mentions both words (title length normalization);
+ *     site rank    the source site's own ordering, halving every
+ *                  RANK_SITE_RANK_HALFLIFE positions, so each site's top
+ *                  hits win ties against its tail.
+ * - The kept results are a min-heap on score (worst on top). A result
+ *   that does not beat the worst kept one is rejected in O(1) before any
+ *   allocation; one that does replaces it in O(log K).
+ * - After each channel flush the list is replaced by the heap's contents,
+ *   best first: one store splice, one rebind on the next frame.
+ * - Equal scores keep the earlier result, so a stable search shows a
+ *   stable list.
+ * - The SearchContext budgets still bound how many candidates the
+ *   parsers gather (memory), while the ranker bounds what is shown.
+ */
+
+
+// Creates the ranker of one search and compiles its tokens: the quoted
+// phrases for a quoted search, otherwise every non-stop word of the query.
+// A quoted search without a meaningful quoted word gets no matcher (and
+// append_results() then shows nothing, as before).
+
+static ResultRanker *result_ranker_new(const char *query, QuoteStatus quote_status) {
+    ResultRanker *ranker = g_new0(ResultRanker, 1);
+    ranker->heap = g_ptr_array_new_with_free_func(g_object_unref);
+    ranker->capacity = RESULT_TOP_K;
+    ranker->hits = g_array_new(FALSE, FALSE, sizeof(TokenMatch));
+
+    if (quote_status == QUOTE_PAIR) {
+        ranker->matcher = token_matcher_new_for_quoted_search(query);
+    } else {
+        printf("[INFO]: Using decisive search term (raw search_term):\n%s\n\n", query);
+        GList *tokens = tokenize_and_filter_stop_words(query);
+        ranker->matcher = tokens ? token_matcher_new(tokens) : NULL;
+        g_list_free_full(tokens, g_free);
+    }
+    return ranker;
+}
+
+
+// --------------------------------
+
+
+// Frees a ranker and drops its references on the kept results.
+
+static void result_ranker_free(ResultRanker *ranker) {
+    if (!ranker) return;
+    token_matcher_free(ranker->matcher);
+    g_ptr_array_free(ranker->heap, TRUE);
+    g_array_free(ranker->hits, TRUE);
+    g_free(ranker);
+}
+
+
+// --------------------------------
+
+
+// Matches a title against the search tokens in one pass and fills in the
+// match and ranking fields of 'info' (matched/total tokens, span, site
+// rank, sequence and score). See RESULT RANKING NOTES for the score.
+
+static void result_ranker_score(ResultRanker *ranker, const char *title, guint site_rank, RecipeInfo *info) {
+    double coverage = 0.0, adjacency = 0.0, conciseness = 0.0;
+
+    info->site_rank = site_rank;
+    info->sequence = ranker->sequence++;
+
+    if (ranker->matcher && ranker->matcher->tokens->len > 0) {
+        guint total = ranker->matcher->tokens->len;
+        guint matched = token_matcher_scan(ranker->matcher, title, ranker->hits);
+
+        info->total_tokens = (int)total;
+        info->matched_tokens = (int)matched;
+        info->match_span = (int)token_matches_span(ranker->hits);
+
+        coverage = (double)matched / total;
+        if (total > 1) {
+            adjacency = (double)token_matches_adjacent_pairs(ranker->matcher, title, ranker->hits) / (total - 1);
+        } else {
+            adjacency = matched ? 1.0 : 0.0;
+        }
+
+        // Words in the title
+        guint words = 0;
+        for (const char *c = title; *c; ++c) {
+            if (g_ascii_isalnum(*c) && (c == title || !g_ascii_isalnum(c[-1])))
+                words++;
+        }
+        conciseness = words ? (double)MIN(matched, words) / words : 0.0;
+    }
+
+    info->score = RANK_WEIGHT_COVERAGE * coverage
+                + RANK_WEIGHT_ADJACENCY * adjacency
+                + RANK_WEIGHT_CONCISENESS * conciseness
+                + RANK_WEIGHT_SITE * (RANK_SITE_RANK_HALFLIFE / (RANK_SITE_RANK_HALFLIFE + site_rank));
+}
+
+
+// --------------------------------
+
+
+// Ranking order of two results: negative if 'a' ranks below 'b' (lower
+// score, or the same score but arrived later).
+
+static int result_rank_compare(const RecipeResult *a, const RecipeResult *b) {
+    if (a->info.score != b->info.score)
+        return a->info.score < b->info.score ? -1 : 1;
+    if (a->info.sequence != b->info.sequence)
+        return a->info.sequence > b->info.sequence ? -1 : 1;
+    return 0;
+}
+
+
+// --------------------------------
+
+
+// TRUE if a result scored 'score' (and arriving now) would be kept: the
+// heap has room, or it beats the worst kept result.
+
+static gboolean result_ranker_would_keep(const ResultRanker *ranker, double score) {
+    if (ranker->heap->len < ranker->capacity)
+        return TRUE;
+    const RecipeResult *worst = g_ptr_array_index(ranker->heap, 0);
+    return score > worst->info.score;
+}
+
+
+// --------------------------------
+
+
+// Helper: Restores the min-heap property below index i.
+
+static void result_ranker_sift_down(GPtrArray *heap, guint i) {
+    for (;;) {
+        guint smallest = i, l = 2 * i + 1, r = 2 * i + 2;
+        if (l < heap->len && result_rank_compare(heap->pdata[l], heap->pdata[smallest]) < 0) smallest = l;
+        if (r < heap->len && result_rank_compare(heap->pdata[r], heap->pdata[smallest]) < 0) smallest = r;
+        if (smallest == i) return;
+
+        gpointer tmp = heap->pdata[i];
+        heap->pdata[i] = heap->pdata[smallest];
+        heap->pdata[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+
+// --------------------------------
+
+
+// Offers a scored result to the kept set. If there is room it is added;
+// otherwise it replaces the worst kept result if it ranks above it.
+// Takes a reference on the result if kept. Returns TRUE if kept.
+
+static gboolean result_ranker_offer(ResultRanker *ranker, RecipeResult *result) {
+    GPtrArray *heap = ranker->heap;
+
+    if (heap->len < ranker->capacity) {
+        // Sift the new result up from the bottom
+        g_ptr_array_add(heap, g_object_ref(result));
+        for (guint i = heap->len - 1; i > 0; ) {
+            guint parent = (i - 1) / 2;
+            if (result_rank_compare(heap->pdata[i], heap->pdata[parent]) >= 0) break;
+            gpointer tmp = heap->pdata[i];
+            heap->pdata[i] = heap->pdata[parent];
+            heap->pdata[parent] = tmp;
+            i = parent;
+        }
+        return TRUE;
+    }
+
+    if (result_rank_compare(result, heap->pdata[0]) <= 0) {
+        ranker->dropped++;
+        return FALSE;
+    }
+
+    // Replace the worst kept result
+    g_object_unref(heap->pdata[0]);
+    heap->pdata[0] = g_object_ref(result);
+    result_ranker_sift_down(heap, 0);
+    ranker->dropped++;
+    return TRUE;
+}
+
+
+// --------------------------------
+
+
+// Helper: qsort comparator, best result first.
+
+static int result_rank_compare_desc(const void *a, const void *b) {
+    return result_rank_compare(*(RecipeResult * const *)b, *(RecipeResult * const *)a);
+}
+
+
+// --------------------------------
+
+
+// Returns the kept results ordered best first. The array holds no
+// references; free it with g_ptr_array_free(array, TRUE).
+
+static GPtrArray *result_ranker_sorted(const ResultRanker *ranker) {
+    GPtrArray *sorted = g_ptr_array_sized_new(ranker->heap->len);
+    for (guint i = 0; i < ranker->heap->len; ++i)
+        g_ptr_array_add(sorted, ranker->heap->pdata[i]);
+    qsort(sorted->pdata, sorted->len, sizeof(gpointer), result_rank_compare_desc);
+    return sorted;
+}
+
+
+// ---------------------------------------------------------------------------
+// ---------------------------------------------------------------------------
+
+
+
+// Normalizes a recipe title to lowercase.
+// It also checks if the search term (needle) appears anywhere inside the
+// recipe title (haystack).
+
+static bool contains_word_case_insensitive(const char *haystack, const char *needle) {
+    if (!haystack || !needle) return false;
+
+    char h[512], n[128];
+    strncpy(h, haystack, sizeof(h) - 1);
+    strncpy(n, needle, sizeof(n) - 1);
+    h[sizeof(h) - 1] = '\0';
+    n[sizeof(n) - 1] = '\0';
+
+    // Convert both to lowercase
+    for (char *p = h; *p; ++p) *p = tolower(*p);
+    for (char *p = n; *p; ++p) *p = tolower(*p);
+
+    return strstr(h, n) != NULL;
+}
+
+
+// ------------------------------
+
+
+
+// Helper: Converts a recipe slug (any format) into a nicely spaced, Title Case-ready string.
+//
+// A recipe slug is the short, URL-friendly identifier for a recipe, typically
+// found at the end of a food webpage URL. It usually contains words from
+// the recipe's title, joined together without spaces or with dashes/underscores.
+// This function:
+// - Trims whitespace
+// - Replaces dashes/underscores with spaces
+// - Inserts a space before capital letters in camelCase or PascalCase slugs
+// - Leaves capitalization untouched; final Title Casing is handled in
+//   the add_link() function
+// Formats handled:
+// - camelCase:     cheesyChickenCasserole
+// - PascalCase:    CheesyChickenCasserole
+// - snake_case:    cheesy_chicken_casserole
+// - kebab-case:    cheesy-chicken-casserole
+// Think of PascalCase as "CamelCase wearing a top hat."
+// Think of camelCase as "PascalCase on casual Friday."
+
+static void slug_to_title(const char *slug, char *out, size_t out_size) {
+
+printf("[DEBUG]: slug_to_title function input slug:%s\n", slug);
+
+    char trimmed_slug[256];
+    trim_whitespace(slug, trimmed_slug, sizeof(trimmed_slug));
+
+    bool had_space = false, had_underscore = false, had_dash = false;
+
+    for (size_t i = 0; trimmed_slug[i] != '\0'; ++i) {
+        if (trimmed_slug[i] == ' ') had_space = true;
+        else if (trimmed_slug[i] == '_') had_underscore = true;
+        else if (trimmed_slug[i] == '-') had_dash = true;
+    }
+
+    size_t out_index = 0;
+
+    if (had_space || had_underscore || had_dash) {
+        for (size_t i = 0; trimmed_slug[i] != '\0' && out_index < out_size - 1; ++i) {
+            char c = trimmed_slug[i];
+            if (c == '_' || c == '-') c = ' ';
+            out[out_index++] = c;
+        }
+    } else {
+        // Insert space before capital letters following lowercase letters
+        for (size_t i = 0; trimmed_slug[i] != '\0' && out_index < out_size - 1; ++i) {
+            char c = trimmed_slug[i];
+            if (i > 0 && isupper((unsigned char)c) && islower((unsigned char)trimmed_slug[i - 1])) {
+                if (out_index < out_size - 2)
+                    out[out_index++] = ' ';
+            }
+            out[out_index++] = c;
+        }
+    }
+
+    out[out_index] = '\0';
+
+printf("[DEBUG]: slug_to_title function output title:%s\n", out);
+
+}
+
+
+
+// ----------------------------
+
+
+// Callback for when a recipe button is clicked
+// Safely retrieves the URL stored in the button's data
+static void on_recipe_clicked(GtkWidget *btn, gpointer user_data G_GNUC_UNUSED) {
+    // Get the URL stored in the button
+    const char *url = g_object_get_data(G_OBJECT(btn), "url");
+
+    if (!url) {
+        g_warning("Recipe button clicked but URL is missing!");
+        return;
+    }
+
+    // Open the URL in the default browser
+    gtk_show_uri_on_window(NULL, url, GDK_CURRENT_TIME, NULL);
+
+    // Note: Do NOT free 'url' here because it's owned by the button
+    // It will be freed automatically when the button is destroyed
+}
+
+
+
+// ------------------------------
+
+
+// Helper: This ensures the search box gets the cursor and keyboard focus
+// after the app window is shown
+
+static gboolean focus_entry_idle(gpointer user_data) {
+    GtkWidget *entry = GTK_WIDGET(user_data);
+    gtk_widget_grab_focus(entry);
+    // Also explicitly set focus on the window itself
+    GtkWindow *win = GTK_WINDOW(gtk_widget_get_toplevel(entry));
+    gtk_window_set_focus(win, entry);
+    return FALSE;
+}
+
+// ------------------------------
+
+
+
+// Focus the entry field to automatically get keyboard focus when the window is shown
+
+static void on_window_realize(GtkWidget *widget G_GNUC_UNUSED, gpointer user_data) {
+    g_idle_add(focus_entry_idle, user_data);
+}
+
+
+// ==================
+
+
+// This sets up a customized appearance (colors, fonts) via CSS at runtime.
+// It loads a CSS string and applies the CSS styles globally to all of the GTK
+// widgets in the app.
+
+// CSS errors are captured and reported.
+// This 
+
+static void register_css_styles(const gchar *css_data) {
+    GtkCssProvider *css_provider = gtk_css_provider_new();
+    GError *error = NULL;
+
+    // Try loading CSS data, capture any errors
+    if (!gtk_css_provider_load_from_data(css_provider, css_data, -1, &error)) {
+        // CSS failed to load, print error message
+        fprintf(stderr, "Error loading CSS styles: %s\n", error->message);
+        g_error_free(error);
+        g_object_unref(css_provider);
+        return;
+    }
+
+    // Apply CSS globally to default screen
+    GdkScreen *screen = gdk_screen_get_default();
+    if (screen) {
+        gtk_style_context_add_provider_for_screen(
+            screen,
+            GTK_STYLE_PROVIDER(css_provider),
+            GTK_STYLE_PROVIDER_PRIORITY_USER);
+    } else {
+        fprintf(stderr, "Warning: No default screen available to apply CSS styles\n");
+    }
+
+    g_object_unref(css_provider);
+}
+
+
+
+// ==================
+// ======================
+// ==================
+
+
+/*
+ * append_results populates the GTK listbox with clickable buttons representing
+ * filtered recipe results from the matched recipe website links.
+ *
+ * Displays recipe search results in the GTK listbox widget, applying advanced
+ * filtering based on whether the user provided quoted search terms.
+ * Filters and displays recipes based on the user's search term, including
+ * support for quoted phrases for exact matches and broader "partial" matches.
+ * Logic Overview:
+ * 1. Keeps the rows already in the listbox: links are fed in batches by the
+ *    search's ResultChannel as the parsers find them.
+ * 2. If search_term has quoted phrases:
+ *    - The quoted phrases were combined, stop-word filtered and compiled
+ *      once per search into a TokenMatcher (Aho-Corasick automaton); for
+ *      other searches every non-stop word is compiled, for ranking only.
+ *    - Each title is scanned once for all tokens at word starts; the
+ *      number of distinct tokens and their span (proximity) are recorded,
+ *      and the ResultRanker scores the title (see RESULT RANKING NOTES).
+ *    - Filters recipes:
+ *        a) Looser (partial) term tokens appear in the recipe title.
+ *        b) Each quoted phrase's keywords are in the recipe title.
+ *    - Only recipes passing both checks are included.
+ * 3. If no quoted phrases:
+ *    - Filters recipes containing all tokens of the search term.
+ * 4. For matched recipes:
+ *    - Drops recipes that rank below the RESULT_TOP_K kept so far.
+ *    - Creates RecipeResult objects (RecipeInfo plus GObject wrapper) and
+ *      offers them to the ranker's bounded heap.
+ * 5. Result store:
+ *    - Replaces the store with the kept results, best first; the
+ *      recycled-row view binds the visible rows on the next frame clock tick.
+ *    - Yellow buttons for perfect matches.
+ *    - Beige buttons for partial matches.
+ * 6. Memory safety:
+ *    - The store owns the results; clearing it frees them.
+ *
+ * Purpose:
+ * Improves recall and relevance for quoted queries by broadening searches
+ * locally while still highlighting exact matches.
+ *
+ * Parameters:
+ *   listbox: The GTK listbox widget to populate with results.
+ *   arena: The search's StringArena holding the link records.
+ *   links: GList of RankedLinks (record plus the site position).
+ *   ranker: The search's ResultRanker (see result_channel_new).
+ *   quote_status: Enum indicating presence of quoted phrases.
+ *
+ * FUTURE IMPROVEMENTS:
+ *   - Add subtle fade effect during removal for smoother visual feedback.
+ */
+
+/*
+JM NOTES, 8/26/2025:
+AllRecipes.com behavior
+The discrepancy between quoted and unquoted searches is not a bug in your code; it’s the website’s search engine behavior.
+On AllRecipes:
+Unquoted search: the site will return any recipe that contains any of the terms you typed, often with broader matching and ranking.
+Quoted search: the site will try to match the exact phrase, which is much stricter. If a recipe title doesn’t have roasted chicken exactly as a phrase, it may be excluded.
+This explains why your code sees many results for roasted chicken unquoted but only one for "roasted chicken" quoted.
+Effect on this logic:
+Your code is faithfully applying the perfect vs. partial-match rules to whatever data the website returns.
+If the site skews results based on quoted terms, your perfect-match count will naturally be lower.
+Partial-match logic mitigates this a little, because it only requires one token match, which is why your yellow links catch the other recipes.
+Reality check: The site behavior is influencing your “perfect match” count, so the skew is external, not a bug in your app.
+E.g., the AllRecipes.com behavior when doing a recipe search using a browser directly on thier website skews the user experience for quoted searches. 
+Users might be surprised that the quoted search term "roasted chicken" returns zero results while the unquoted search term roasted chicken returns plenty.
+The behavior is site-dependent. AllRecipes is strict with quotes (0 results), while Food Network allows partial matches and returns more.
+This logic's partial-match feature is compensating nicely for sites that return very few results for quoted searches. Users still see relevant recipes highlighted
+ in yellow even when the site is restrictive.
+The only “weirdness” comes from how individual food sites handle quoted search terms.
+This code correctly tries to preserve user intent of quoted search terms by giving visual cues of yellow and beige highlighted results.
+ */
+
+// ==================
+
+
+// Filters recipe links against the search term, ranks them, and shows the
+// best ones in the listbox's result store (steps 3-5 above).
+// Results kept from earlier batches stay, so every search can stream its
+// links into the list as they are found (see result_channel_flush).
+
+static void append_results(GtkWidget *listbox_widget, StringArena *arena, GList *links, ResultRanker *ranker, QuoteStatus quote_status) {
+    gboolean changed = FALSE;
+
+    // Step 3: The search terms were compiled into the ranker's matcher once
+    // per search (result_ranker_new); each title is matched and scored in
+    // one pass
+    for (GList *l = links; l; l = l->next) {
+        RankedLink *link = l->data;
+        const ResultRecord *rec = string_arena_record(arena, link->record);
+        const char *title = result_record_title(rec);
+
+        RecipeInfo match = { 0 };
+        result_ranker_score(ranker, title, link->site_rank, &match);
+
+        // Match logic for quoted search
+        if (quote_status == QUOTE_PAIR && ranker->matcher) {
+            match.perfect_match = match.matched_tokens == match.total_tokens;
+            match.partial_match = !match.perfect_match && match.matched_tokens > 0;
+        }
+
+        // Skip non-matching recipe if quote filter is active
+        if (quote_status == QUOTE_PAIR && !match.perfect_match && !match.partial_match)
+            continue;
+
+        // Step 4: Keep the recipe only if it ranks among the best so far
+        if (!result_ranker_would_keep(ranker, match.score)) {
+            ranker->dropped++;
+            continue;
+        }
+
+        RecipeResult *result = recipe_result_new_from_record(arena, link->record);
+        match.title = result->info.title;
+        match.url = result->info.url;
+        result->info = match;
+
+        if (match.perfect_match) {
+            printf("[INFO] INSERTING PERFECT MATCH (YELLOW): %s (%d/%d tokens, score %.2f)\n",
+                   title, match.matched_tokens, match.total_tokens, match.score);
+        } else if (match.partial_match) {
+            printf("[INFO] INSERTING PARTIAL MATCH (BEIGE): %s (%d/%d tokens, score %.2f)\n",
+                   title, match.matched_tokens, match.total_tokens, match.score);
+        } else {
+            printf("[INFO] INSERTING RECIPE LINK: %s (score %.2f)\n", title, match.score);
+        }
+
+        changed |= result_ranker_offer(ranker, result);
+        g_object_unref(result);
+    }
+
+    // Step 5: Show the kept results best first; the view rebinds on the next frame
+    if (changed) {
+        GPtrArray *sorted = result_ranker_sorted(ranker);
+        result_view_replace(listbox_widget, sorted);
+        g_ptr_array_free(sorted, TRUE);
+    }
+}
+
+
+// ==================
+
+
+/*
+ * RESULT VIEW NOTES:
+ *
+ * Results live in a GListStore of RecipeResult objects; the listbox is
+ * only a view of it:
+ * - Rows are recycled. The listbox holds just enough row buttons for the
+ *   visible part of the scrolled window plus RESULT_VIEW_OVERSCAN_ROWS
+ *   above and below. On scroll, those buttons are relabelled and restyled
+ *   for the store items now in view; nothing is created or destroyed.
+ * - Two spacer widgets are sized to the rows above and below the bound
+ *   window, so the scrollbar covers the whole list. Rows are assumed to
+ *   share one height, measured from a laid-out row.
+ * - Rebinding runs from a tick callback of the listbox's GdkFrameClock, so
+ *   any number of appends (and scroll events) within a frame cost one
+ *   rebind, and a new batch of results appears on the next frame.
+ * - Widget cost is therefore bound by the window height, not the number
+ *   of results. The store itself holds at most RESULT_TOP_K ranked results
+ *   (plus a site's fallback link): the ResultRanker caps the list, so the
+ *   view needs no limit of its own. Memory is bounded earlier, on the
+ *   candidates a search gathers (MAX_RESULTS, capped by
+ *   result_limit_for_memory).
+ */
+
+
+// GObject boilerplate for RecipeResult (final type, no properties).
+
+G_DEFINE_TYPE(RecipeResult, recipe_result, G_TYPE_OBJECT)
+
+static void recipe_result_finalize(GObject *object) {
+    RecipeResult *result = RECIPE_RESULT(object);
+    if (result->arena) {
+        string_arena_unref(result->arena);  // Title and URL live in the arena
+    } else {
+        g_free(result->info.title);
+        g_free(result->info.url);
+    }
+    G_OBJECT_CLASS(recipe_result_parent_class)->finalize(object);
+}
+
+static void recipe_result_class_init(RecipeResultClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = recipe_result_finalize;
+}
+
+static void recipe_result_init(RecipeResult *result G_GNUC_UNUSED) {
+}
+
+
+// --------------------------------
+
+
+// Creates a result store entry with no match details; title and URL are
+// copied.
+
+static RecipeResult *recipe_result_new(const char *title, const char *url) {
+    RecipeResult *result = g_object_new(RECIPE_TYPE_RESULT, NULL);
+    result->info.title = g_strdup(title);
+    result->info.url = g_strdup(url);
+    return result;
+}
+
+
+// --------------------------------
+
+
+// Creates a result store entry for a record of a search's arena. Title and
+// URL point into the arena (no copies), which the result keeps alive.
+
+static RecipeResult *recipe_result_new_from_record(StringArena *arena, ResultRef record) {
+    const ResultRecord *rec = string_arena_record(arena, record);
+    RecipeResult *result = g_object_new(RECIPE_TYPE_RESULT, NULL);
+    result->arena = string_arena_ref(arena);
+    result->info.title = (char *)result_record_title(rec);
+    result->info.url = (char *)result_record_url(rec);
+    return result;
+}
+
+
+// --------------------------------
+
+
+// Builds the result view: puts the listbox between two spacers in the
+// scrolled window, creates the store, and rebinds whenever the store
+// changes or the window scrolls or resizes.
+
+static ResultView *result_view_attach(GtkScrolledWindow *scrolled, GtkListBox *listbox) {
+    ResultView *view = g_new0(ResultView, 1);
+    view->listbox = listbox;
+    view->store = g_list_store_new(RECIPE_TYPE_RESULT);
+    view->rows = g_ptr_array_new();
+    view->row_height = RESULT_VIEW_ROW_HEIGHT_ESTIMATE;
+
+    // Spacers above and below the recycled rows
+    GtkWidget *content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+    view->top_spacer = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+    view->bottom_spacer = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
+    gtk_box_pack_start(GTK_BOX(content), view->top_spacer, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(content), GTK_WIDGET(listbox), FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(content), view->bottom_spacer, FALSE, FALSE, 0);
+    gtk_container_add(GTK_CONTAINER(scrolled), content);
+
+    view->vadjustment = gtk_scrolled_window_get_vadjustment(scrolled);
+    g_signal_connect_swapped(view->vadjustment, "value-changed", G_CALLBACK(result_view_queue_rebind), view);
+    g_signal_connect_swapped(view->vadjustment, "changed", G_CALLBACK(result_view_queue_rebind), view);
+    g_signal_connect_swapped(view->store, "items-changed", G_CALLBACK(result_view_queue_rebind), view);
+
+    g_object_set_data_full(G_OBJECT(listbox), "result-view", view, result_view_free);
+    return view;
+}
+
+
+// --------------------------------
+
+
+// Returns the result view attached to a listbox by result_view_attach().
+
+static ResultView *result_view_get(GtkWidget *listbox) {
+    return g_object_get_data(G_OBJECT(listbox), "result-view");
+}
+
+
+// --------------------------------
+
+
+// Appends a batch of results to the store in one splice (one
+// "items-changed", one rebind) and drops the caller's references.
+
+static void result_view_append(GtkWidget *listbox, GPtrArray *results) {
+    ResultView *view = result_view_get(listbox);
+    if (results->len == 0) return;
+
+    guint n = g_list_model_get_n_items(G_LIST_MODEL(view->store));
+    g_list_store_splice(view->store, n, 0, results->pdata, results->len);
+    for (guint i = 0; i < results->len; ++i) {
+        g_object_unref(g_ptr_array_index(results, i));
+    }
+}
+
+
+// --------------------------------
+
+
+// Replaces the whole store with 'results' in one splice (the store adds
+// its own references). Used for ranked lists, whose order can change as
+// better results arrive.
+
+static void result_view_replace(GtkWidget *listbox, GPtrArray *results) {
+    ResultView *view = result_view_get(listbox);
+
+    guint n = g_list_model_get_n_items(G_LIST_MODEL(view->store));
+    g_list_store_splice(view->store, 0, n, results->pdata, results->len);
+}
+
+
+// --------------------------------
+
+
+// Empties the result store (freeing every result) and scrolls the view
+// back to the top for the next search.
+
+static void result_view_clear(GtkWidget *listbox) {
+    ResultView *view = result_view_get(listbox);
+
+    g_list_store_remove_all(view->store);
+    gtk_adjustment_set_value(view->vadjustment, 0.0);
+}
+
+
+// --------------------------------
+
+
+// Schedules one rebind on the listbox's next frame; further calls before
+// then are free.
+
+static void result_view_queue_rebind(ResultView *view) {
+    if (view->tick_id == 0) {
+        view->tick_id = gtk_widget_add_tick_callback(GTK_WIDGET(view->listbox), result_view_tick, view, NULL);
+    }
+}
+
+
+// --------------------------------
+
+
+// Frame clock tick: runs the scheduled rebind once.
+
+static gboolean result_view_tick(GtkWidget *widget G_GNUC_UNUSED, GdkFrameClock *frame_clock G_GNUC_UNUSED, gpointer user_data) {
+    ResultView *view = user_data;
+    view->tick_id = 0;
+    result_view_rebind(view);
+    return G_SOURCE_REMOVE;
+}
+
+
+// --------------------------------
+
+
+// Binds the recycled rows to the store items around the viewport, creating
+// row buttons only when the viewport needs more than exist, and sizes the
+// spacers for the rows outside the bound window.
+
+static void result_view_rebind(ResultView *view) {
+    GListModel *model = G_LIST_MODEL(view->store);
+    guint n = g_list_model_get_n_items(model);
+
+    // Learn the real row height once a row has been laid out
+    if (view->rows->len > 0) {
+        GtkWidget *row = gtk_widget_get_parent(g_ptr_array_index(view->rows, 0));
+        int height = row ? gtk_widget_get_allocated_height(row) : 0;
+        if (row && gtk_widget_get_visible(row) && height > 1 && height != view->row_height) {
+            view->row_height = height;
+            result_view_queue_rebind(view);  // Re-layout with the measured height
+        }
+    }
+
+    // Window of store items to bind
+    double value = gtk_adjustment_get_value(view->vadjustment);
+    double page = gtk_adjustment_get_page_size(view->vadjustment);
+    guint first_visible = (guint)(value / view->row_height);
+    guint first = first_visible > RESULT_VIEW_OVERSCAN_ROWS ? first_visible - RESULT_VIEW_OVERSCAN_ROWS : 0;
+    guint count = page > 0 ? (guint)(page / view->row_height) + 1 + 2 * RESULT_VIEW_OVERSCAN_ROWS : RESULT_VIEW_MIN_ROWS;
+
+    if (first > n) first = n;
+    if (count > n - first) count = n - first;
+
+    // Grow the row pool if the viewport got taller
+    while (view->rows->len < count) {
+        GtkWidget *btn = gtk_button_new();
+        g_signal_connect(btn, "clicked", G_CALLBACK(on_recipe_clicked), NULL);
+        gtk_list_box_insert(view->listbox, btn, -1);
+        g_ptr_array_add(view->rows, btn);
+    }
+
+    for (guint i = 0; i < view->rows->len; ++i) {
+        GtkWidget *btn = g_ptr_array_index(view->rows, i);
+        GtkWidget *row = gtk_widget_get_parent(btn);
+
+        if (i < count) {
+            RecipeResult *result = g_list_model_get_item(model, first + i);
+            result_view_bind_row(btn, &result->info);
+            g_object_unref(result);
+            gtk_widget_show_all(row);
+        } else {
+            gtk_widget_hide(row);
+        }
+    }
+
+    view->first = first;
+    gtk_widget_set_size_request(view->top_spacer, -1, (int)first * view->row_height);
+    gtk_widget_set_size_request(view->bottom_spacer, -1, (int)(n - first - count) * view->row_height);
+}
+
+
+// --------------------------------
+
+
+// Helper: Show one recipe in a recycled row button.
+// Applies CSS styling according to the search type:
+//   - Default links: standard white/black button
+//   - Partial matches: beige background button
+//   - Perfect matches: yellow background button with blue glowing border
+// Classes left over from the item the row showed before are removed first.
+
+static void result_view_bind_row(GtkWidget *btn, const RecipeInfo *ri) {
+    gtk_button_set_label(GTK_BUTTON(btn), ri->title);
+
+    // Store URL safely in the button object; freed when rebound or destroyed
+    g_object_set_data_full(G_OBJECT(btn), "url", g_strdup(ri->url), g_free);
+
+    GtkStyleContext *ctx = gtk_widget_get_style_context(btn);
+    gtk_style_context_remove_class(ctx, "recipe-perfect");
+    gtk_style_context_remove_class(ctx, "recipe-partial");
+    gtk_style_context_remove_class(ctx, "recipe-button");
+    gtk_style_context_remove_class(ctx, "visible");
+
+    if (ri->perfect_match) {
+        gtk_style_context_add_class(ctx, "recipe-perfect");
+        gtk_style_context_add_class(ctx, "visible");
+    } else if (ri->partial_match) {
+        gtk_style_context_add_class(ctx, "recipe-partial");
+    } else {
+        gtk_style_context_add_class(ctx, "recipe-button");
+    }
+}
+
+
+// --------------------------------
+
+
+// Frees a result view (object data destructor of its listbox).
+
+static void result_view_free(gpointer data) {
+    ResultView *view = data;
+    g_signal_handlers_disconnect_by_data(view->vadjustment, view);
+    g_signal_handlers_disconnect_by_data(view->store, view);
+    g_object_unref(view->store);
+    g_ptr_array_free(view->rows, TRUE);
+    g_free(view);
+}
+
+
+// ==================
+// ==================
+// ==================
+
+
+
+// Thread entry point -- search logic only (no UI)
+// This function runs in a separate thread to:
+//  - Read a recipe search query from a UI input.
+//  - Construct a URL for the selected recipe site.
+//  - Download and parse the HTML results (only for parsers that need the DOM).
+//  - Extract and store recipe data.
+//  - Schedule a callback (search_complete_cb) to update the UI with
+//     the results.
+//  It is designed to be non-blocking, thread-safe, and modular:
+//    each site can have its own parser logic via parse_site.
+//  When the "All Sites" entry is selected, the query is handed to
+//    run_all_sites_search() instead, which streams results per site.
+//  The query and site were captured by initialize_on_search() in a
+//    SearchRequest, whose token is cancelled if a newer search supersedes
+//    this one; the thread then winds down early and its results are dropped.
+
+static gpointer search_thread_func(gpointer data) {
+
+    SearchRequest *request = data;
+    AppWidgets *w = request->w;
+    SearchResultData *result = g_new0(SearchResultData, 1);
+    result->w = w;
+    result->success = FALSE;
+    result->query = g_strdup(request->query);
+    result->quote_status = request->quote_status;
+    result->search = search_context_ref(request->search);
+
+    // Prep
+    const char *q = request->query;
+
+//    printf("\n[DEBUG]: Function search_thread_func received this input:\n%s\n\n", q);
+
+    if (!q || !*q) {
+        result->status_message = g_strdup("      Please enter a recipe search term (like roast chicken, or chili)");
+        g_idle_add(search_complete_cb, result);
+        search_request_free(request);
+        return NULL;
+    }
+
+    int n_sites = (int)(sizeof(g_recipe_site_table) / sizeof(g_recipe_site_table[0]));
+    int index = request->site_index;
+
+    // The "All Sites" entry follows the individual sites in the combo box
+    if (index == n_sites) {
+        search_context_unref(result->search);
+        g_free(result->query);
+        g_free(result);
+        run_all_sites_search(request);
+        search_request_free(request);
+        return NULL;
+    }
+
+    if (index < 0 || index >= n_sites) {
+        result->status_message = g_strdup("Please select a valid recipe site.");
+        g_idle_add(search_complete_cb, result);
+        search_request_free(request);
+        return NULL;
+    }
+
+    const RecipeSiteInfo *site = &g_recipe_site_table[index];
+
+    result->url = build_site_search_url(site, q);
+    if (!result->url) {
+        result->status_message = g_strdup("Failed to build URL.");
+        g_idle_add(search_complete_cb, result);
+        search_request_free(request);
+        return NULL;
+    }
+
+    // Fresh per-search state (result budget, duplicate filter, site identity)
+    // under the request's cancellation token
+    SearchContext *search = search_context_new(request->search, site, result_limit_for_memory(MAX_RESULTS));
+    result->success = run_site_search(search, q, result->url, &result->results, &result->status_message);
+    search_context_unref(search);
+
+    g_idle_add(search_complete_cb, result);
+    search_request_free(request);
+    return NULL;
+
+}
+
+
+// ==================
+
+
+// Frees a SearchRequest and drops its token reference.
+
+static void search_request_free(SearchRequest *request) {
+    search_context_unref(request->search);
+    g_free(request->query);
+    g_free(request);
+}
+
+
+// ==================
+
+
+// Builds the search page URL of one recipe site for the user's query.
+// Returns a newly allocated URL (caller must g_free), or NULL if the
+// search term could not be encoded.
+
+static char *build_site_search_url(const RecipeSiteInfo *site, const char *query) {
+    char *enc = g_uri_escape_string(query, NULL, FALSE);
+    if (!enc) {
+        fprintf(stderr, "[WARNING]: Failed to encode search term for %s.\n", site->name);
+        return NULL;
+    }
+
+    char *url = g_strdup_printf(site->url_pattern, enc);
+    g_free(enc);
+    return url;
+}
+
+
+// ==================
+
+
+// Runs one site's search for the query and appends its links to *out.
+// Shared by single-site searches and the "All Sites" worker pool, so it
+// only touches its own local state and never the UI.
+// The on-disk result cache is checked first: a fresh entry is returned
+// as-is, and a stale one is returned immediately while a background
+// thread re-runs the parser. Only a miss runs the parser (and, for the
+// JavaScript sites, the Node.js scraper) in this thread.
+// Returns TRUE if links were produced; on failure *status_message is set.
+
+static gboolean run_site_search(SearchContext *search, const char *query, const char *url, GList **out, char **status_message) {
+
+    const RecipeSiteInfo *site = search->site;
+    char *cache_path = result_cache_path(site, query);
+
+    if (cache_path) {
+        switch (result_cache_lookup(cache_path, search->arena, out)) {
+            case RESULT_CACHE_FRESH:
+                printf("[INFO]: Using cached %s results for: %s\n", site->name, query);
+                search_context_publish_list(search, *out);
+                g_free(cache_path);
+                return TRUE;
+            case RESULT_CACHE_STALE:
+                printf("[INFO]: Using stale cached %s results (refreshing in background) for: %s\n", site->name, query);
+                search_context_publish_list(search, *out);
+                result_cache_refresh_async(site, query, url, cache_path);
+                g_free(cache_path);
+                return TRUE;
+            case RESULT_CACHE_MISS:
+            default:
+                break;
+        }
+    }
+
+    gboolean ran = run_site_parser(search, query, url, out, status_message);
+
+    // Results made only of fallback links are not cached; they are often a
+    // transient failure (network, scraper worker, a changed page), and a
+    // cancelled search may have stopped part-way
+    if (ran && *out && search_context_found_results(search) && cache_path && !search_context_is_cancelled(search)) {
+        result_cache_store(cache_path, site, query, search->arena, *out);
+    }
+
+    g_free(cache_path);
+    return ran;
+}
+
+
+// ==================
+
+
+// Runs one site's parser for the query and appends its links to *out.
+// Only download and build a DOM when the site parser actually walks it.
+// Parsers that fetch their own data (Node.js scripts, their own libcurl
+// request) or only add a static link get a NULL root instead, which
+// saves a full HTTP round trip plus a full Gumbo parse per search.
+// Sites with a JSON search API are read by run_json_endpoint() first,
+// and sites with a SiteEscalation go through run_site_escalation().
+// Returns TRUE if the parser ran; on failure *status_message is set.
+
+static gboolean run_site_parser(SearchContext *search, const char *query, const char *url, GList **out, char **status_message) {
+
+    const RecipeSiteInfo *site = search->site;
+    MemoryBlock page = { NULL, 0, 0 };
+    GumboOutput *output = NULL;
+    GumboNode *root = NULL;
+
+    if (site->escalation) {
+        return run_site_escalation(search, query, out);
+    }
+
+    if (site->fetch_mode == SITE_NEEDS_PREFETCHED_DOM) {
+        if (!download_html(url, search, &page)) {
+            *status_message = g_strdup("Failed to fetch recipes.");
+            return FALSE;
+        }
+
+        output = gumbo_parse_with_options(&kGumboDefaultOptions, page.data, page.size);
+        if (!output) {
+            *status_message = g_strdup("Failed to parse HTML from site.");
+            download_arena_reset();
+            return FALSE;
+        }
+        root = output->root;
+    } else if (site->fetch_mode == SITE_JSON_ENDPOINT) {
+        // Read the site's search API here; its parser only adds the fallback
+        if (!run_json_endpoint(search, site->json_endpoint, query, out)) {
+            fprintf(stderr, "[WARNING]: %s search API failed; using the fallback link.\n", site->name);
+        }
+    } else {
+        printf("[INFO]: Skipping prefetch of %s search page (parser %s).\n",
+               site->name,
+               site->fetch_mode == SITE_STATIC_FALLBACK_ONLY ? "adds a static link only" : "fetches its own data");
+    }
+
+    gboolean ran = FALSE;
+    if (site->parse_site) {
+        site->parse_site(root, out, search, query);
+        ran = TRUE;
+    }
+
+    // The links are copies, so the DOM can go as soon as the parser returns
+    if (output) {
+        gumbo_destroy_output(&kGumboDefaultOptions, output);
+    }
+    if (page.data) {
+        download_arena_reset();
+    }
+
+    return ran;
+}
+
+
+// ==================
+
+
+// Queries a site's JSON search API and adds one link per result.
+// This replaces a Node.js script that only did an https.get() and mapped
+// the reply to {title, url}: the request goes through the shared HTTP
+// engine into this thread's download arena, and the members named by the
+// JsonEndpoint are read with json-c, so an API-backed site costs one HTTP
+// request instead of a Node.js job. Results without a title or link are
+// skipped. Returns FALSE if the API could not be fetched or did not answer
+// with a results array.
+
+static gboolean run_json_endpoint(SearchContext *search, const JsonEndpoint *endpoint, const char *query, GList **out) {
+    if (!endpoint) return FALSE;
+
+    char *encoded = url_encode(query ? query : "");
+    char *api_url = g_strdup_printf(endpoint->url_pattern, encoded);
+    g_free(encoded);
+
+    MemoryBlock page = { NULL, 0, 0 };
+    gboolean fetched = download_html(api_url, search, &page);
+    g_free(api_url);
+    if (!fetched) return FALSE;
+
+    struct json_tokener *tok = json_tokener_new();
+    struct json_object *reply = json_tokener_parse_ex(tok, page.data, (int)page.size);
+    json_tokener_free(tok);
+    download_arena_reset();
+
+    struct json_object *results = NULL;
+    if (!reply ||
+        !json_object_object_get_ex(reply, endpoint->results_key, &results) ||
+        !json_object_is_type(results, json_type_array)) {
+        fprintf(stderr, "[WARNING]: %s search API reply has no \"%s\" array.\n",
+                search->site_name, endpoint->results_key);
+        json_object_put(reply);
+        return FALSE;
+    }
+
+    size_t n_results = json_object_array_length(results);
+    for (size_t i = 0; i < n_results && !search_context_is_cancelled(search); ++i) {
+        struct json_object *result = json_object_array_get_idx(results, i);
+        struct json_object *title_obj = NULL, *url_obj = NULL;
+        if (!json_object_object_get_ex(result, endpoint->title_key, &title_obj) ||
+            !json_object_object_get_ex(result, endpoint->url_key, &url_obj)) {
+            continue;
+        }
+
+        const char *title = json_object_get_string(title_obj);
+        const char *url = json_object_get_string(url_obj);
+        if (title && *title && url && *url) {
+            add_link(out, title, endpoint->base_url, url, search);
+        }
+    }
+
+    printf("[INFO]: %s search API returned %zu results.\n", search->site_name, n_results);
+    json_object_put(reply);
+    return TRUE;
+}
+
+
+// ==================
+
+
+/*
+ * Fetch tiers:
+ * - A site with a SiteEscalation is searched cheapest tier first:
+ *   FETCH_TIER_STATIC (its search page through the shared HTTP engine,
+ *   parsed with Gumbo and read with the site's CSS selector), then
+ *   FETCH_TIER_EMBEDDED (JSON-LD, else Next.js __NEXT_DATA__ state, on
+ *   that same page), then
+ *   FETCH_TIER_BROWSER (the site's parser, i.e. its Playwright script).
+ * - The first tier that produces a link wins; later tiers are not run.
+ *   Every page tier keeps only links containing the site's url_match, and
+ *   the CSS selector must give at least FETCH_TIER_STATIC_MIN_LINKS of
+ *   them: a nav or footer link that happens to match is not a result.
+ * - Each site remembers the tier that last produced links, in
+ *   g_fetch_tiers and in FETCH_TIER_FILE so it survives a restart. The
+ *   browser tier only counts when its parser found real results (see
+ *   search_context_found_results): a parser that only added the site's
+ *   fallback link leaves the record as it was.
+ * - The two page tiers share one download. So the record only changes the
+ *   work done when it says FETCH_TIER_BROWSER: the page download is then
+ *   skipped, except on every FETCH_TIER_RETRY_INTERVAL-th search, which
+ *   starts from the page tiers again in case the site changed back.
+ */
+
+
+// Runs the site's search through the fetch tiers (see the notes above)
+// and appends its links to *out. The browser tier is the site's own
+// parser, which also adds the site's fallback link when it finds nothing.
+// Returns TRUE (the parser contract of run_site_parser()).
+
+static gboolean run_site_escalation(SearchContext *search, const char *query, GList **out) {
+
+    const RecipeSiteInfo *site = search->site;
+    const SiteEscalation *escalation = site->escalation;
+    FetchTier start = fetch_tier_start(site);
+    FetchTier used = FETCH_TIER_COUNT;
+
+    if (start < FETCH_TIER_BROWSER) {
+        char *encoded = url_encode(query ? query : "");
+        char *page_url = g_strdup_printf(escalation->search_url, encoded);
+        g_free(encoded);
+
+        MemoryBlock page = { NULL, 0, 0 };
+        if (download_html(page_url, search, &page)) {
+            GumboOutput *output = gumbo_parse_with_options(&kGumboDefaultOptions, page.data, page.size);
+            if (output) {
+                if (html_scrape_links(output->root, escalation->link_selector, NULL, escalation->base_url,
+                                      escalation->url_match, FETCH_TIER_STATIC_MIN_LINKS, out, search) > 0) {
+                    used = FETCH_TIER_STATIC;
+                } else if (html_extract_json_ld_links(output->root, escalation->base_url,
+                                                      escalation->url_match, out, search) > 0 ||
+                           html_extract_next_data_links(output->root, escalation->base_url,
+                                                        escalation->url_match, out, search) > 0) {
+                    used = FETCH_TIER_EMBEDDED;
+                }
+                gumbo_destroy_output(&kGumboDefaultOptions, output);
+            }
+            download_arena_reset();
+        }
+        g_free(page_url);
+    }
+
+    if (used == FETCH_TIER_COUNT && !search_context_is_cancelled(search)) {
+        printf("[INFO]: %s: %s; running the browser script.\n", site->name,
+               start < FETCH_TIER_BROWSER ? "no links on the search page" : "last found links with the browser");
+        site->parse_site(NULL, out, search, query);
+        // The parser always adds a fallback link, so *out alone proves nothing
+        if (search_context_found_results(search)) used = FETCH_TIER_BROWSER;
+    }
+
+    // A cancelled search may have stopped before the tier that would have worked
+    if (used != FETCH_TIER_COUNT && !search_context_is_cancelled(search)) {
+        fetch_tier_learn(site, used);
+    }
+    return TRUE;
+}
+
+
+// ==================
+
+
+// Tier to start the site's search at: its learned tier, except that a
+// site stuck on the browser tier retries the page tiers once every
+// FETCH_TIER_RETRY_INTERVAL searches.
+
+static FetchTier fetch_tier_start(const RecipeSiteInfo *site) {
+    FetchTier start = FETCH_TIER_STATIC;
+
+    g_mutex_lock(&g_fetch_tier_lock);
+    fetch_tier_load_locked();
+    FetchTierRecord *record = g_hash_table_lookup(g_fetch_tiers, site->name);
+    if (record && record->tier == FETCH_TIER_BROWSER) {
+        if (++record->browser_runs < FETCH_TIER_RETRY_INTERVAL) {
+            start = FETCH_TIER_BROWSER;
+        } else {
+            record->browser_runs = 0;
+        }
+    }
+    g_mutex_unlock(&g_fetch_tier_lock);
+
+    return start;
+}
+
+
+// ==================
+
+
+// Remembers the tier that produced the site's links, and rewrites the
+// tier file if that changed the site's record.
+
+static void fetch_tier_learn(const RecipeSiteInfo *site, FetchTier tier) {
+    g_mutex_lock(&g_fetch_tier_lock);
+    fetch_tier_load_locked();
+
+    FetchTierRecord *record = g_hash_table_lookup(g_fetch_tiers, site->name);
+    if (!record) {
+        record = g_new0(FetchTierRecord, 1);
+        record->tier = FETCH_TIER_COUNT;
+        g_hash_table_insert(g_fetch_tiers, (gpointer)site->name, record);
+    }
+
+    if (record->tier != tier) {
+        static const char *const tier_names[FETCH_TIER_COUNT + 1] = { "page", "embedded data", "browser", "none" };
+        printf("[INFO]: %s found links with the %s tier (was %s).\n",
+               site->name, tier_names[tier], tier_names[record->tier]);
+        record->tier = tier;
+        record->browser_runs = 0;
+        fetch_tier_save_locked();
+    }
+    g_mutex_unlock(&g_fetch_tier_lock);
+}
+
+
+// ==================
+
+
+// Gets the path of the learned tier file, creating its folder if needed.
+// Returns a newly allocated path (caller must g_free).
+
+static char *fetch_tier_path(void) {
+    char *folder_path = g_build_filename(g_get_user_cache_dir(), "recipe_finder", NULL);
+    g_mkdir_with_parents(folder_path, 0700);
+    char *path = g_build_filename(folder_path, FETCH_TIER_FILE, NULL);
+    g_free(folder_path);
+    return path;
+}
+
+
+// ==================
+
+
+// Creates g_fetch_tiers on first use and fills it from the tier file:
+// {"AllRecipes": 0, "Delish": 2, ...}. Unknown sites and out-of-range
+// tiers are ignored. Caller holds g_fetch_tier_lock.
+
+static void fetch_tier_load_locked(void) {
+    if (g_fetch_tiers) return;
+    g_fetch_tiers = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, g_free);
+
+    char *path = fetch_tier_path();
+    char *contents = NULL;
+    struct json_object *root = NULL;
+    if (g_file_get_contents(path, &contents, NULL, NULL)) {
+        root = json_tokener_parse(contents);
+        g_free(contents);
+    }
+    g_free(path);
+    if (!root) return;
+
+    // Keys are the table's own name strings, so records outlive the JSON
+    size_t n_sites = sizeof(g_recipe_site_table) / sizeof(g_recipe_site_table[0]);
+    for (size_t i = 0; i < n_sites; ++i) {
+        struct json_object *tier = NULL;
+        if (!g_recipe_site_table[i].escalation ||
+            !json_object_object_get_ex(root, g_recipe_site_table[i].name, &tier) ||
+            !json_object_is_type(tier, json_type_int)) {
+            continue;
+        }
+        int value = json_object_get_int(tier);
+        if (value < FETCH_TIER_STATIC || value >= FETCH_TIER_COUNT) continue;
+
+        FetchTierRecord *record = g_new0(FetchTierRecord, 1);
+        record->tier = (FetchTier)value;
+        g_hash_table_insert(g_fetch_tiers, (gpointer)g_recipe_site_table[i].name, record);
+    }
+
+    json_object_put(root);
+}
+
+
+// ==================
+
+
+// Writes every site's learned tier to the tier file. Caller holds
+// g_fetch_tier_lock.
+
+static void fetch_tier_save_locked(void) {
+    struct json_object *root = json_object_new_object();
+
+    GHashTableIter iter;
+    gpointer key, value;
+    g_hash_table_iter_init(&iter, g_fetch_tiers);
+    while (g_hash_table_iter_next(&iter, &key, &value)) {
+        const FetchTierRecord *record = value;
+        json_object_object_add(root, key, json_object_new_int(record->tier));
+    }
+
+    char *path = fetch_tier_path();
+    GError *error = NULL;
+    if (!g_file_set_contents(path, json_object_to_json_string_ext(root, JSON_C_TO_STRING_PRETTY), -1, &error)) {
+        fprintf(stderr, "[WARNING]: Could not write fetch tier file %s: %s\n",
+                path, error ? error->message : "unknown error");
+        g_clear_error(&error);
+    }
+
+    g_free(path);
+    json_object_put(root);
+}
+
+
+// ==================
+
+
+// "All Sites" search coordinator (runs in the search thread).
+// Pushes one task per recipe site into a fixed-size GThreadPool, so at most
+// ALL_SITES_MAX_CONCURRENT_SEARCHES parsers run at once (and the scraper
+// worker further caps concurrent Chromium jobs, see run_site_script()).
+// Each finished site streams its links into the listbox right away.
+// A site that runs longer than ALL_SITES_SITE_TIMEOUT_MS (plus the usual
+// reply slack) is abandoned: the search completes without it and any
+// results it returns later are dropped. If the whole search is superseded,
+// every unfinished site is abandoned the same way.
+
+static void run_all_sites_search(SearchRequest *request) {
+    guint n_sites = sizeof(g_recipe_site_table) / sizeof(g_recipe_site_table[0]);
+
+    AllSitesSearch *search = g_new0(AllSitesSearch, 1);
+    search->ref_count = 1;
+    search->w = request->w;
+    search->token = search_context_ref(request->search);
+    search->query = g_strdup(request->query);
+    search->quote_status = request->quote_status;
+    g_mutex_init(&search->lock);
+    g_cond_init(&search->cond);
+
+    // One combined budget, plus one context (own limit) per site
+    search->context = search_context_new(request->search, NULL, result_limit_for_memory(MAX_ALL_SITES_RESULTS));
+    search->site_contexts = g_new0(SearchContext *, n_sites);
+    gint site_limit = result_limit_for_memory(MAX_RESULTS);
+    for (guint i = 0; i < n_sites; ++i) {
+        search->site_contexts[i] = search_context_new(search->context, &g_recipe_site_table[i], site_limit);
+    }
+
+    search->states = g_new0(SiteTaskState, n_sites);
+    search->started_at = g_new0(gint64, n_sites);
+    search->n_sites = n_sites;
+    search->remaining = n_sites;
+
+    printf("[INFO]: Searching all %u sites (%d at a time, %d s per site).\n",
+           n_sites, ALL_SITES_MAX_CONCURRENT_SEARCHES, ALL_SITES_SITE_TIMEOUT_MS / 1000);
+
+    GError *error = NULL;
+    GThreadPool *pool = g_thread_pool_new(all_sites_task_func, search,
+                                          ALL_SITES_MAX_CONCURRENT_SEARCHES, TRUE, &error);
+    if (!pool) {
+        fprintf(stderr, "[ERROR]: Could not create the site search thread pool: %s\n",
+                error ? error->message : "unknown error");
+        g_clear_error(&error);
+        all_sites_post_update(search, "Search failed.", TRUE);
+        all_sites_search_unref(search);
+        return;
+    }
+
+    // Task data is the 1-based site index (the pool rejects NULL tasks)
+    for (guint i = 0; i < n_sites; ++i) {
+        g_atomic_int_inc(&search->ref_count);
+        g_thread_pool_push(pool, GUINT_TO_POINTER(i + 1), NULL);
+    }
+
+    // Wait for every site, abandoning any that overrun their time budget
+    gint64 budget = (gint64)(ALL_SITES_SITE_TIMEOUT_MS + SCRAPE_JOB_WAIT_SLACK_MS) * 1000;
+
+    g_mutex_lock(&search->lock);
+    while (search->remaining > 0) {
+        // Superseded by a newer search: abandon everything still pending
+        if (search_context_is_cancelled(search->context)) {
+            printf("[INFO]: All Sites search was cancelled with %u sites unfinished.\n", search->remaining);
+            for (guint i = 0; i < n_sites; ++i) {
+                if (search->states[i] == SITE_TASK_QUEUED || search->states[i] == SITE_TASK_RUNNING) {
+                    search->states[i] = SITE_TASK_TIMED_OUT;
+                }
+            }
+            search->remaining = 0;
+            break;
+        }
+
+        gint64 now = g_get_monotonic_time();
+        gint64 next_check = now + G_USEC_PER_SEC;
+
+        for (guint i = 0; i < n_sites; ++i) {
+            if (search->states[i] != SITE_TASK_RUNNING)
+                continue;
+
+            gint64 expires = search->started_at[i] + budget;
+            if (now >= expires) {
+                search->states[i] = SITE_TASK_TIMED_OUT;
+                search_context_cancel(search->site_contexts[i]);
+                search->remaining--;
+                search->timed_out++;
+                fprintf(stderr, "[WARNING]: %s did not finish within %d s; skipping it.\n",
+                        g_recipe_site_table[i].name, ALL_SITES_SITE_TIMEOUT_MS / 1000);
+                all_sites_post_update(search, g_recipe_site_table[i].name, FALSE);
+            } else if (expires < next_check) {
+                next_check = expires;
+            }
+        }
+
+        if (search->remaining > 0)
+            g_cond_wait_until(&search->cond, &search->lock, next_check);
+    }
+
+    char *summary;
+    if (search->total_results == 0) {
+        summary = g_strdup("   No matching recipes were found on any of the recipe sites.");
+    } else {
+        summary = g_strdup_printf("   Found %u recipes on %u of %u sites.",
+                                  search->total_results, search->sites_with_results, search->n_sites);
+    }
+    if (search->timed_out > 0) {
+        char *with_timeouts = g_strdup_printf("%s  (%u slow sites were skipped)", summary, search->timed_out);
+        g_free(summary);
+        summary = with_timeouts;
+    }
+
+    printf("[INFO]: All Sites search finished:%s\n", summary);
+    all_sites_post_update(search, summary, TRUE);
+    g_free(summary);
+    g_mutex_unlock(&search->lock);
+
+    // Abandoned sites keep their pool thread until they return; do not wait
+    g_thread_pool_free(pool, FALSE, FALSE);
+    all_sites_search_unref(search);
+}
+
+
+// ==================
+
+
+// Thread-pool task of an "All Sites" search: searches one site.
+// The site's deadline is stored in its SearchContext so that JavaScript
+// parsers ask the scraper worker for a matching job timeout.
+// Results are sent to the UI unless the coordinator already gave up on
+// this site.
+
+static void all_sites_task_func(gpointer task_data, gpointer pool_data) {
+    AllSitesSearch *search = pool_data;
+    guint index = GPOINTER_TO_UINT(task_data) - 1;
+    const RecipeSiteInfo *site = &g_recipe_site_table[index];
+    SearchContext *site_search = search->site_contexts[index];
+
+    // Queued tasks of a cancelled search have nothing left to do
+    if (search_context_is_cancelled(site_search)) {
+        all_sites_search_unref(search);
+        return;
+    }
+
+    gint64 started = g_get_monotonic_time();
+    site_search->deadline = started + (gint64)ALL_SITES_SITE_TIMEOUT_MS * 1000;
+
+    g_mutex_lock(&search->lock);
+    if (search->states[index] == SITE_TASK_TIMED_OUT) {
+        // Abandoned while we were taking the lock
+        g_mutex_unlock(&search->lock);
+        all_sites_search_unref(search);
+        return;
+    }
+    search->states[index] = SITE_TASK_RUNNING;
+    search->started_at[index] = started;
+    g_cond_signal(&search->cond);
+    g_mutex_unlock(&search->lock);
+
+    printf("[INFO]: [All Sites] Searching %s ...\n", site->name);
+
+    GList *results = NULL;
+    char *status_message = NULL;
+    char *url = build_site_search_url(site, search->query);
+
+    if (url) {
+        run_site_search(site_search, search->query, url, &results, &status_message);
+    }
+
+    if (status_message) {
+        fprintf(stderr, "[WARNING]: [All Sites] %s: %s\n", site->name, status_message);
+    }
+
+    g_mutex_lock(&search->lock);
+    if (search->states[index] == SITE_TASK_TIMED_OUT) {
+        printf("[INFO]: [All Sites] Dropping late results from %s.\n", site->name);
+    } else {
+        search->states[index] = SITE_TASK_DONE;
+        search->remaining--;
+        if (results) {
+            search->sites_with_results++;
+            search->total_results += g_list_length(results);
+        }
+        printf("[INFO]: [All Sites] %s returned %u links in %.1f s.\n", site->name,
+               results ? g_list_length(results) : 0,
+               (g_get_monotonic_time() - started) / (double)G_USEC_PER_SEC);
+        all_sites_post_update(search, site->name, FALSE);
+        g_cond_signal(&search->cond);
+    }
+    g_mutex_unlock(&search->lock);
+
+    g_list_free(results);  // Records live in the search's arena
+    g_free(status_message);
+    g_free(url);
+    all_sites_search_unref(search);
+}
+
+
+// ==================
+
+
+// Drops one reference to an "All Sites" search and frees it with the last one.
+
+static void all_sites_search_unref(AllSitesSearch *search) {
+    if (!g_atomic_int_dec_and_test(&search->ref_count))
+        return;
+
+    g_mutex_clear(&search->lock);
+    g_cond_clear(&search->cond);
+    for (guint i = 0; i < search->n_sites; ++i) {
+        search_context_unref(search->site_contexts[i]);
+    }
+    g_free(search->site_contexts);
+    search_context_unref(search->context);
+    search_context_unref(search->token);
+    g_free(search->states);
+    g_free(search->started_at);
+    g_free(search->query);
+    g_free(search);
+}
+
+
+// ==================
+
+
+// Queues one "All Sites" update for the main thread.
+// Called with search->lock held (except on pool creation failure), so the
+// "finished" count in consecutive updates never goes backwards.
+//   results: links of a finished site (ownership moves to the update)
+//   message: site name for progress updates, or the summary when final
+
+static void all_sites_post_update(AllSitesSearch *search, const char *message, gboolean final) {
+    SiteBatchResult *batch = g_new0(SiteBatchResult, 1);
+    batch->w = search->w;
+    batch->message = g_strdup(message);
+    batch->finished = search->n_sites - search->remaining;
+    batch->n_sites = search->n_sites;
+    batch->final = final;
+    batch->search = search_context_ref(search->token);
+
+    g_idle_add(all_sites_update_cb, batch);
+}
+
+
+// ==================
+
+
+// Applies one "All Sites" update in the GTK main thread.
+// Site updates append that site's links to the listbox and turn the pulsing
+// progress bar into a real "sites finished" fraction.
+// The final update restores the UI, just like search_complete_cb() does.
+
+static gboolean all_sites_update_cb(gpointer data) {
+    SiteBatchResult *batch = data;
+    AppWidgets *w = batch->w;
+
+    // A newer search owns the UI now; drop updates of the superseded one
+    if (search_context_is_cancelled(batch->search)) {
+        goto done;
+    }
+
+    // Links published before this update go in ahead of it
+    if (batch->search->channel) {
+        result_channel_flush(batch->search->channel);
+    }
+
+    // Progress is now measurable, so stop pulsing
+    if (w->pulse_timer_id != 0) {
+        g_source_remove(w->pulse_timer_id);
+        w->pulse_timer_id = 0;
+    }
+
+    if (!batch->final) {
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(w->progress_bar),
+                                      batch->n_sites ? (double)batch->finished / batch->n_sites : 1.0);
+
+        char *status = g_strdup_printf("   Searching all recipe sites ... %u of %u done (%s)",
+                                       batch->finished, batch->n_sites, batch->message);
+        gtk_label_set_text(GTK_LABEL(w->status_label), status);
+        g_free(status);
+    } else {
+        // Hide progress bar, restore the cursor and re-enable UI
+        gtk_widget_hide(w->progress_bar);
+        set_cursor(gtk_widget_get_toplevel(w->search_button), GDK_LEFT_PTR);
+        set_ui_enabled(w, TRUE);
+        gtk_label_set_text(GTK_LABEL(w->status_label), batch->message);
+        finish_active_search(w, batch->search);
+    }
+
+done:
+    search_context_unref(batch->search);
+    g_free(batch->message);
+    g_free(batch);
+
+    return G_SOURCE_REMOVE;
+}
+
+
+// ==================
+// ==================
+// ==================
+
+
+/*
+ * SEARCH RESULT CACHE NOTES:
+ *
+ * Results change slowly, but a Playwright scrape takes seconds, so every
+ * site's links are kept on disk per (site, normalized query):
+ *   <user cache dir>/recipe_finder/results/site<NN>-<sha1 of query>.json
+ * - NN is the site's index in g_recipe_site_table.
+ * - The query is normalized with normalize_quotes_utf8() and
+ *   tokenize_and_filter_stop_words(), so "The Chili" and "chili" share an
+ *   entry while quoted and unquoted searches stay separate.
+ * - Fresh entries (RESULT_CACHE_TTL_SECONDS) are used as-is. Stale entries
+ *   (up to RESULT_CACHE_MAX_STALE_SECONDS) are painted right away while a
+ *   background refresh rewrites them for the next search. Older entries
+ *   are deleted on lookup.
+ * - Files are written with g_file_set_contents(), which replaces them
+ *   atomically, so a crash never leaves a half-written entry.
+ * - Only searches with real results are stored. Parsers add their
+ *   fallback link with add_fallback_link(), and a result list made only of
+ *   fallbacks (a failed fetch, a dead scraper worker, a changed page) is
+ *   neither written nor allowed to replace a stale entry.
+ */
+
+
+// Builds the normalized form of a search term used as the cache key:
+// curly quotes folded to ASCII, lowercased, stop words removed, and the
+// remaining tokens joined by single spaces.
+// Returns NULL if nothing is left (e.g. the query was only stop words).
+
+static char *result_cache_normalize_query(const char *query) {
+    if (!query) return NULL;
+
+    char *copy = g_strdup(query);
+    normalize_quotes_utf8(copy);
+
+    // Tabs and newlines separate words just like spaces
+    for (char *p = copy; *p; ++p) {
+        if (isspace((unsigned char)*p)) *p = ' ';
+    }
+
+    GList *tokens = tokenize_and_filter_stop_words(copy);
+    g_free(copy);
+    if (!tokens) return NULL;
+
+    GString *key = g_string_new("");
+    for (GList *t = tokens; t; t = t->next) {
+        if (key->len > 0) g_string_append_c(key, ' ');
+        g_string_append(key, (const char *)t->data);
+    }
+    g_list_free_full(tokens, g_free);
+
+    return g_string_free(key, FALSE);
+}
+
+
+// --------------------------------
+
+
+// Gets the cache file path for a site and query, creating the cache
+// folder if needed. Returns NULL if the query has no keywords.
+
+static char *result_cache_path(const RecipeSiteInfo *site, const char *query) {
+    char *normalized = result_cache_normalize_query(query);
+    if (!normalized) return NULL;
+
+    char *digest = g_compute_checksum_for_string(G_CHECKSUM_SHA1, normalized, -1);
+    g_free(normalized);
+
+    char *folder_path = g_build_filename(g_get_user_cache_dir(), "recipe_finder", "results", NULL);
+    g_mkdir_with_parents(folder_path, 0700);
+
+    char *file_name = g_strdup_printf("site%02d-%s.json", (int)(site - g_recipe_site_table), digest);
+    char *path = g_build_filename(folder_path, file_name, NULL);
+
+    g_free(file_name);
+    g_free(folder_path);
+    g_free(digest);
+    return path;
+}
+
+
+// --------------------------------
+
+
+// Loads the cached links at 'path' ("title\x1fURL" strings on disk) into
+// the search's arena and appends their ResultRefs to *out.
+// Returns RESULT_CACHE_MISS (and leaves *out untouched) if the entry is
+// missing, unreadable, from another format version, or too old to serve.
+
+static ResultCacheState result_cache_lookup(const char *path, StringArena *arena, GList **out) {
+    char *contents = NULL;
+    if (!g_file_get_contents(path, &contents, NULL, NULL))
+        return RESULT_CACHE_MISS;
+
+    struct json_object *root = json_tokener_parse(contents);
+    g_free(contents);
+    if (!root) {
+        fprintf(stderr, "[WARNING]: Ignoring corrupt result cache file %s\n", path);
+        return RESULT_CACHE_MISS;
+    }
+
+    struct json_object *version, *fetched, *links;
+    if (!json_object_object_get_ex(root, "version", &version) ||
+        json_object_get_int(version) != RESULT_CACHE_FORMAT_VERSION ||
+        !json_object_object_get_ex(root, "fetched", &fetched) ||
+        !json_object_object_get_ex(root, "links", &links) ||
+        !json_object_is_type(links, json_type_array)) {
+        json_object_put(root);
+        return RESULT_CACHE_MISS;
+    }
+
+    gint64 age = g_get_real_time() / G_USEC_PER_SEC - json_object_get_int64(fetched);
+    if (age < 0 || age > RESULT_CACHE_MAX_STALE_SECONDS) {
+        json_object_put(root);
+        g_remove(path);  // Too old to be useful, even as a stale answer
+        return RESULT_CACHE_MISS;
+    }
+
+    GList *cached = NULL;
+    size_t n_links = json_object_array_length(links);
+    for (size_t i = 0; i < n_links; ++i) {
+        const char *entry = json_object_get_string(json_object_array_get_idx(links, i));
+        const char *sep = entry ? strchr(entry, '\x1f') : NULL;
+        ResultRef record = sep ? string_arena_add(arena, entry, sep - entry, sep + 1, strlen(sep + 1)) : 0;
+        if (record) {
+            cached = g_list_prepend(cached, GUINT_TO_POINTER(record));
+        }
+    }
+    json_object_put(root);
+
+    if (!cached)
+        return RESULT_CACHE_MISS;
+
+    *out = g_list_concat(*out, g_list_reverse(cached));
+    return age <= RESULT_CACHE_TTL_SECONDS ? RESULT_CACHE_FRESH : RESULT_CACHE_STALE;
+}
+
+
+// --------------------------------
+
+
+// Writes a site's links (records of 'arena') for a query to the cache
+// file at 'path', as "title\x1fURL" strings.
+// The site name and normalized query are stored for easier inspection.
+
+static void result_cache_store(const char *path, const RecipeSiteInfo *site, const char *query, StringArena *arena, GList *links) {
+    struct json_object *root = json_object_new_object();
+    struct json_object *array = json_object_new_array();
+    char *normalized = result_cache_normalize_query(query);
+    GString *entry = g_string_new(NULL);
+
+    for (GList *l = links; l; l = l->next) {
+        const ResultRecord *rec = string_arena_record(arena, GPOINTER_TO_UINT(l->data));
+        g_string_assign(entry, result_record_title(rec));
+        g_string_append_c(entry, '\x1f');
+        g_string_append(entry, result_record_url(rec));
+        json_object_array_add(array, json_object_new_string(entry->str));
+    }
+    g_string_free(entry, TRUE);
+
+    json_object_object_add(root, "version", json_object_new_int(RESULT_CACHE_FORMAT_VERSION));
+    json_object_object_add(root, "site", json_object_new_string(site->name));
+    json_object_object_add(root, "query", json_object_new_string(normalized ? normalized : ""));
+    json_object_object_add(root, "fetched", json_object_new_int64(g_get_real_time() / G_USEC_PER_SEC));
+    json_object_object_add(root, "links", array);
+
+    GError *error = NULL;
+    const char *text = json_object_to_json_string_ext(root, JSON_C_TO_STRING_PLAIN);
+    if (!g_file_set_contents(path, text, -1, &error)) {
+        fprintf(stderr, "[WARNING]: Could not write result cache file %s: %s\n",
+                path, error ? error->message : "unknown error");
+        g_clear_error(&error);
+    }
+
+    json_object_put(root);
+    g_free(normalized);
+}
+
+
+// --------------------------------
+
+
+// Starts a background refresh of a stale cache entry, unless one is
+// already running for the same file.
+
+static void result_cache_refresh_async(const RecipeSiteInfo *site, const char *query, const char *url, const char *path) {
+    g_mutex_lock(&g_result_cache_lock);
+    if (!g_result_cache_refreshing) {
+        g_result_cache_refreshing = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    }
+    if (g_hash_table_contains(g_result_cache_refreshing, path)) {
+        g_mutex_unlock(&g_result_cache_lock);
+        return;
+    }
+    g_hash_table_add(g_result_cache_refreshing, g_strdup(path));
+    g_mutex_unlock(&g_result_cache_lock);
+
+    ResultCacheRefresh *refresh = g_new0(ResultCacheRefresh, 1);
+    refresh->site = site;
+    refresh->query = g_strdup(query);
+    refresh->url = g_strdup(url);
+    refresh->path = g_strdup(path);
+
+    g_thread_unref(g_thread_new("result_cache_refresh", result_cache_refresh_thread, refresh));
+}
+
+
+// --------------------------------
+
+
+// Background thread: re-runs the site parser for a stale entry and
+// rewrites the cache file when the site returned real results. A run that
+// only produced fallback links leaves the stale (good) entry in place.
+
+static gpointer result_cache_refresh_thread(gpointer data) {
+    ResultCacheRefresh *refresh = data;
+    GList *links = NULL;
+    char *status_message = NULL;
+
+    // Own context, so the refresh never eats into a foreground search's budget
+    SearchContext *search = search_context_new(NULL, refresh->site, result_limit_for_memory(MAX_RESULTS));
+
+    if (run_site_parser(search, refresh->query, refresh->url, &links, &status_message) && links &&
+        search_context_found_results(search)) {
+        result_cache_store(refresh->path, refresh->site, refresh->query, search->arena, links);
+        printf("[INFO]: Refreshed cached %s results (%u links).\n", refresh->site->name, g_list_length(links));
+    } else {
+        fprintf(stderr, "[WARNING]: Background refresh of %s results failed: %s\n",
+                refresh->site->name, status_message ? status_message : "no results returned");
+    }
+
+    g_mutex_lock(&g_result_cache_lock);
+    g_hash_table_remove(g_result_cache_refreshing, refresh->path);
+    g_mutex_unlock(&g_result_cache_lock);
+
+    g_list_free(links);  // Records live in the context's arena (freed with it)
+    search_context_unref(search);
+    g_free(status_message);
+    g_free(refresh->query);
+    g_free(refresh->url);
+    g_free(refresh->path);
+    g_free(refresh);
+    return NULL;
+}
+
+
+// ==================
+
+
+// Finalizes the UI after the background recipe search completes.
+// Stops the pulsing progress bar animation, restores UI interactivity,
+// and adds the last streamed results or an appropriate fallback message.
+// Runs in the GTK main thread via g_idle_add().
+
+static gboolean search_complete_cb(gpointer data) {
+
+    SearchResultData *result = data;
+
+    // A newer search owns the UI now; drop the superseded one's results
+    if (search_context_is_cancelled(result->search)) {
+        printf("[INFO]: Dropping results of a superseded search for: %s\n", result->query ? result->query : "");
+        goto cleanup;
+    }
+
+// JM: Display function info in the terminal. Uses a  ternary operator
+//         as a conditional expression rather than a full if statement.
+//         This avoids calling g_list_length on a NULL pointer.
+printf(
+    "\n[INFO]: Function search_complete_cb() was called.\n"
+    "        callback success flag = %d\n"
+    "        memory address of GList containing recipe links: %p\n"
+    "        number of recipe links in GList: %d\n\n",
+    result->success,
+    result->results,
+    result->results ? g_list_length(result->results) : 0
+);
+fflush(stdout);
+
+
+    AppWidgets *w = result->w;
+
+    // STOP the progress bar timer first
+    if (w->pulse_timer_id != 0) {
+        g_source_remove(w->pulse_timer_id);
+        w->pulse_timer_id = 0;
+    }
+
+    // Hide progress bar and re-enable UI
+    // Restores the busy/wait cursor to the normal arrow
+    gtk_widget_hide(w->progress_bar);
+    set_cursor(gtk_widget_get_toplevel(w->search_button), GDK_LEFT_PTR);
+    set_ui_enabled(w, TRUE);
+    finish_active_search(w, result->search);
+
+    // The links were streamed in while the search ran; add any still queued
+    if (result->search->channel) {
+        result_channel_flush(result->search->channel);
+    }
+
+    // Show results or fallback
+    if (result->success && result->results) {
+        gtk_label_set_text(GTK_LABEL(w->status_label), "");
+    } else if (result->url && !result->results) {
+        insert_fallback_link(w->listbox, result->url, "Matching recipes not found. Click to open the main food website.");
+        gtk_label_set_text(GTK_LABEL(w->status_label), "");
+    } else {
+        gtk_label_set_text(GTK_LABEL(w->status_label),
+                           result->status_message ? result->status_message : "Search failed.");
+    }
+
+    // Clean up
+cleanup:
+    search_context_unref(result->search);
+    g_list_free(result->results);
+    g_free(result->url);
+    g_free(result->query);
+    g_free(result->status_message);
+    g_free(result);
+
+    return G_SOURCE_REMOVE;
+}
+
+
+
+// ==================
+
+
+
+// Callback for GTK timer
+// Pulses the progress bar widget inside AppWidgets every 100ms.  The
+// 100 ms interval comes from the timer set up with g_timeout_add(100, ...)
+// Keeps the progress bar animation running while a background task is
+// in progress.
+// Returns G_SOURCE_CONTINUE to keep the timer active.
+static gboolean pulse_progress_bar(gpointer data) {
+    AppWidgets *w = data;
+    gtk_progress_bar_pulse(GTK_PROGRESS_BAR(w->progress_bar));
+    return G_SOURCE_CONTINUE; // Keep the timeout running
+}
+
+
+
+
+// ==================
+// ==================
+// ==================
+
+
+
+// Search for matching recipes!
+// Initial immediate search button handler -- sets up UI and defers real work
+
+static void initialize_on_search(GtkButton *btn G_GNUC_UNUSED, gpointer ud) {
+    AppWidgets *w = ud;
+
+    // Ensure there is a search term to use
+    const char *q = gtk_entry_get_text(GTK_ENTRY(w->entry));
+    if (!q || !*q) {
+    // Don't proceed with empty input
+        gtk_label_set_text(GTK_LABEL(w->status_label),
+            "      Please enter a recipe search term (like:  roast chicken, or chili, or Peking Duck)");
+        printf("\n\n=========================================================\n");
+        printf("\nUSER SEARCH TERM WAS EMPTY!\n");
+        return;
+    }
+
+    // A search that is still running is superseded by this one
+    supersede_active_search(w);
+
+    printf("\n\n=========================================================\n");
+    printf("    <<<   N E W     R E C I P E     S E A R C H   >>>\n");
+    printf("=========================================================\n");
+    printf("\nUSER SEARCH TERM:\n%s\n", q);
+    printf("\n------------------------------------------------\n");
+
+    // Detect quote status and store it in the widgets struct for later use
+    QuoteStatus quote_status = detect_quote_status(q);
+    w->quote_status = quote_status;
+
+    // Prepare user-facing status message based on quote usage
+    const char *status_msg = NULL;
+    switch (quote_status) {
+        case QUOTE_PAIR:
+            status_msg = "    Quoted searches behave differently on each website!  Searching, please wait …";
+            break;
+        case QUOTE_SINGLE:
+            status_msg = "   Searching for recipes (Note: Please check your unmatched quote marks) ...";
+            break;
+        case QUOTE_NONE:
+        default:
+            status_msg = "   Searching for matching recipes. Please wait ...";
+            break;
+    }
+
+    // Set busy cursor
+    GtkWidget *toplevel = gtk_widget_get_toplevel(w->search_button);
+    set_cursor(toplevel, GDK_WATCH);
+
+    // Lock the result list during search (search input stays usable)
+    set_ui_enabled(w, FALSE);
+
+    // Clear any previous results
+    clear_recipe_results(w->listbox);
+
+    // Show status and progress bar
+    gtk_label_set_text(GTK_LABEL(w->status_label), status_msg);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(w->progress_bar), 0.0);
+    gtk_widget_show(w->progress_bar);
+
+    // Process GTK events before launching the thread
+    while (gtk_events_pending())
+        gtk_main_iteration_do(FALSE);
+
+    // Start pulsing progress bar (replacing the superseded search's timer)
+    if (w->pulse_timer_id != 0) {
+        g_source_remove(w->pulse_timer_id);
+    }
+    w->pulse_timer_id = g_timeout_add(100, (GSourceFunc)pulse_progress_bar, w);
+
+    // Capture everything the thread needs, with a new cancellation token
+    SearchRequest *request = g_new0(SearchRequest, 1);
+    request->w = w;
+    request->search = search_context_new(NULL, NULL, G_MAXINT);
+    request->search->channel = result_channel_new(w, q, quote_status, request->search->arena);
+    request->query = g_strdup(q);
+    request->site_index = gtk_combo_box_get_active(GTK_COMBO_BOX(w->combo));
+    request->quote_status = quote_status;
+    w->active_search = search_context_ref(request->search);
+
+    // launch search thread (detached; it only reports back via g_idle_add)
+    g_thread_unref(g_thread_new("recipe_search_thread", search_thread_func, request));
+
+}
+
+
+// ==================
+
+
+// Cancels the running search, if any, so a new search can take over at
+// once instead of waiting for it. Its HTTP transfers are aborted, its
+// Node.js jobs are cancelled in the worker (closing their pages), its
+// threads return early, and any results it still posts are dropped.
+// Main thread only.
+
+static void supersede_active_search(AppWidgets *w) {
+    if (!w->active_search)
+        return;
+
+    printf("[INFO]: Cancelling the running search.\n");
+    result_channel_close(w->active_search->channel);
+    search_context_cancel(w->active_search);
+    search_context_unref(w->active_search);
+    w->active_search = NULL;
+}
+
+
+// ==================
+
+
+// Clears the active search once its final result has been shown.
+// Main thread only.
+
+static void finish_active_search(AppWidgets *w, SearchContext *search) {
+    if (w->active_search && w->active_search == search) {
+        search_context_unref(w->active_search);
+        w->active_search = NULL;
+    }
+}
+
+
+// ==================
+
+
+/*
+ * RESULT CHANNEL NOTES:
+ *
+ * Parsers used to hand their links to the UI only when the whole site was
+ * done, so a slow JavaScript site showed a pulsing bar for many seconds
+ * while its first links were already known. The ResultChannel turns this
+ * into a producer/consumer pipeline:
+ * - Producers: add_link() publishes every link it accepts, and
+ *   run_site_search() publishes cache hits. Any thread may publish.
+ * - The queue is a GAsyncQueue, so producers never wait on the UI.
+ * - Consumer: the first publish after the queue was drained schedules one
+ *   main-loop source (result_channel_drain_cb) at default priority, which
+ *   ranks everything queued into the listbox with append_results(). A
+ *   burst of links therefore costs a single wakeup, and each link reaches
+ *   the list within one main-loop iteration.
+ * - Completion callbacks flush the channel once more before showing their
+ *   summary, so the status text never runs ahead of the list.
+ * - Closing the channel (a newer search took over) makes every later
+ *   drain discard its links instead of touching the new search's list.
+ */
+
+
+// Creates a result channel for one search from the UI, with the ranker
+// (and its compiled search tokens) used by append_results() for the whole
+// search. 'arena' is the search's record arena the queued links refer to.
+
+static ResultChannel *result_channel_new(AppWidgets *w, const char *query, QuoteStatus quote_status, StringArena *arena) {
+    ResultChannel *channel = g_new0(ResultChannel, 1);
+    channel->ref_count = 1;
+    channel->queue = g_async_queue_new_full(g_free);
+    channel->w = w;
+    channel->query = g_strdup(query);
+    channel->quote_status = quote_status;
+    channel->ranker = result_ranker_new(query, quote_status);
+    channel->arena = string_arena_ref(arena);
+    return channel;
+}
+
+
+// --------------------------------
+
+
+// Adds a reference to a result channel and returns it.
+
+static ResultChannel *result_channel_ref(ResultChannel *channel) {
+    g_atomic_int_inc(&channel->ref_count);
+    return channel;
+}
+
+
+// --------------------------------
+
+
+// Drops one reference; the last one frees the channel and any links still
+// queued in it.
+
+static void result_channel_unref(ResultChannel *channel) {
+    if (!channel || !g_atomic_int_dec_and_test(&channel->ref_count))
+        return;
+
+    g_async_queue_unref(channel->queue);
+    if (channel->ranker && channel->ranker->dropped > 0) {
+        printf("[INFO]: Kept the best %u results; %u lower-ranked results were not shown.\n",
+               channel->ranker->heap->len, channel->ranker->dropped);
+    }
+    result_ranker_free(channel->ranker);
+    string_arena_unref(channel->arena);
+    g_free(channel->query);
+    g_free(channel);
+}
+
+
+// --------------------------------
+
+
+// Queues one link record, with its position in its site's results, and
+// makes sure a drain source is pending. Safe from any thread.
+
+static void result_channel_publish(ResultChannel *channel, ResultRef record, guint site_rank) {
+    if (g_atomic_int_get(&channel->closed))
+        return;
+
+    RankedLink *link = g_new(RankedLink, 1);
+    link->site_rank = site_rank;
+    link->record = record;
+    g_async_queue_push(channel->queue, link);
+
+    if (g_atomic_int_compare_and_exchange(&channel->drain_scheduled, 0, 1)) {
+        g_idle_add_full(G_PRIORITY_DEFAULT, result_channel_drain_cb,
+                        result_channel_ref(channel), (GDestroyNotify)result_channel_unref);
+    }
+}
+
+
+// --------------------------------
+
+
+// Marks a channel as superseded: links queued or published later are
+// discarded instead of shown. Main thread only.
+
+static void result_channel_close(ResultChannel *channel) {
+    if (channel) {
+        g_atomic_int_set(&channel->closed, 1);
+    }
+}
+
+
+// --------------------------------
+
+
+// Moves every queued link into the listbox (after the match filtering and
+// ranking of append_results()). Returns the number of links taken off the
+// queue. Main thread only.
+
+static guint result_channel_flush(ResultChannel *channel) {
+    GList *links = NULL;
+    guint n = 0;
+    RankedLink *link;
+
+    while ((link = g_async_queue_try_pop(channel->queue)) != NULL) {
+        links = g_list_prepend(links, link);
+        n++;
+    }
+
+    if (links && !g_atomic_int_get(&channel->closed)) {
+        links = g_list_reverse(links);
+        append_results(channel->w->listbox, channel->arena, links, channel->ranker, channel->quote_status);
+        channel->published += n;
+    }
+
+    g_list_free_full(links, g_free);
+    return n;
+}
+
+
+// --------------------------------
+
+
+// Main-loop source scheduled by result_channel_publish(). Re-arms the
+// scheduling flag first, so links published while it runs get a new
+// source, then flushes the queue.
+
+static gboolean result_channel_drain_cb(gpointer data) {
+    ResultChannel *channel = data;
+
+    g_atomic_int_set(&channel->drain_scheduled, 0);
+    result_channel_flush(channel);
+
+    return G_SOURCE_REMOVE;
+}
+
+
+// ==================
+
+
+// Helper: Set busy or normal cursor on the toplevel window
+static void set_cursor(GtkWidget *widget, GdkCursorType cursor_type) {
+    GdkDisplay *display = gdk_display_get_default();
+    GdkCursor *cursor = (cursor_type != GDK_BLANK_CURSOR)
+        ? gdk_cursor_new_for_display(display, cursor_type)
+        : NULL;
+    GdkWindow *window = gtk_widget_get_window(widget);
+    if (window)
+        gdk_window_set_cursor(window, cursor);
+    if (cursor)
+        g_object_unref(cursor);
+}
+
+
+
+// ==================
+
+
+// Helper function to clear the previous recipe search results
+static void clear_recipe_results(GtkWidget *listbox) {
+    // The recycled rows stay; emptying the store hides them on the next frame
+    result_view_clear(listbox);
+}
+
+
+// ==================
+
+
+// Scroll-blocking filter
+// Note: G_GNUC_UNUSED is added to prevent compiler warnings.
+// GTK signal handlers must match a specific function signature, even if
+// you don't use the parameters. As an example, for this scroll-event,
+// GTK expects a function like:
+//   gboolean handler(GtkWidget *widget, GdkEventScroll *event, gpointer user_data);
+// Even if the parameters widget, event, and user_data are unused, you still
+// need to include them in the function signature, or GTK will not connect
+// the signal properly.
+
+static gboolean block_scroll(GtkWidget *widget G_GNUC_UNUSED,
+                             GdkEventScroll *event G_GNUC_UNUSED,
+                             gpointer user_data G_GNUC_UNUSED) {
+    return search_in_progress;  // Block scroll events while search is running
+}
+
+
+// ==================
+
+
+// Unified UI enable/disable function:
+// Only the result list is locked while a search runs. The entry, site combo
+// and search button stay usable so the user can start a new search, which
+// supersedes (cancels) the running one.
+
+static void set_ui_enabled(const AppWidgets *w, gboolean enabled) {
+    search_in_progress = !enabled;
+
+    gtk_widget_set_sensitive(w->listbox, enabled);
+    gtk_widget_set_can_focus(w->listbox, enabled);
+}
+
+
+// ==================
+
+
+// Fallback recipe link handler
+// Adds a manual recipe link button to the combo box if the selected site
+// has no direct matching recipes.
+// The fallback link tries to provide a webpage that in itself has various
+// matching recipes on the food site. Worst case the fallback link will
+// be the main page of the food website.
+// Uses the same main result renderer to consistently format the link button.
+
+void insert_fallback_link(GtkWidget *listbox, const char *url, const char *description) {
+    // A plain result styled like the others, shown through the result view
+    GPtrArray *fallback = g_ptr_array_new();
+    g_ptr_array_add(fallback, recipe_result_new(description, url));
+    result_view_append(listbox, fallback);
+    g_ptr_array_free(fallback, TRUE);
+}
+
+
+
+
+// ================================================================
+//  ***  CSS STYLES  ***
+// ================================================================
+
+// Load and register the app's custom GTK CSS style rules to enhance the UI.
+// CSS stands for Cascading Style Sheets.
+// CSS styles affect the appearance of GTK elements (combo boxes, buttons,
+// entry fields, and labels), without changing their actual functionality.
+// This includes colors, fonts, spacing, borders, layouts, and animations.
+
+static void load_app_css_styles(void) {
+    const gchar *css =
+        // =====================
+        // Search Entry Field Styles
+        //   (Yellow Background)
+        // =====================
+        "entry.search-entry {"
+        "  background-color: #fff7b3;"
+        "  font-weight: bold;"
+        "  font-size: 18pt;"
+        "  border: 1px solid #aaa;"
+        "  border-radius: 6px;"
+        "  padding: 8px;"
+        "}\n"
+
+        // =======================
+        // Combo Box Parent Styles
+        //   (Blue Background)
+        // =======================
+        ".site-combo {"
+        "  background-color: #b3d7ff;"
+        "  color: #222222;"
+        "  font-weight: bold;"
+        "  font-size: 13pt;"
+        "  min-height: 12px;"
+        "  padding-top: 0px;"
+        "  padding-bottom: 0px;"
+        "  margin-top: 0px;"
+        "  margin-bottom: 0px;"
+        "}\n"
+
+        // ================================================
+        // Combo Box Children Styles (elements inside box)
+        // ================================================
+        ".site-combo > * {"
+        "  background-color: #b3d7ff;"
+        "  color: #222222;"
+        "  font-weight: bold;"
+        "  font-size: 13pt;"
+        "  min-height: 12px;"
+        "  padding-top: 0px;"
+        "  padding-bottom: 0px;"
+        "  margin-top: 0px;"
+        "  margin-bottom: 0px;"
+        "}\n"
+
+        // ===================================
+        // Status Label (status and error messages)
+        // ===================================
+        ".status-label {"
+        "  color: red;"
+        "  font-weight: bold;"
+        "  font-size: 12pt;"
+        "}\n"
+
+        // ===================
+        // Search Button Styles
+        // ===================
+        ".search-button {"
+        "  background-image: none;"
+        "  background-color: #a2f6a9;"
+        "  color: black;"
+        "  font-weight: bold;"
+        "  font-size: 18px;"
+        "  border: 2px solid #388E3C;"
+        "  border-radius: 5px;"
+        "  padding: 12px 16px;"
+        "}\n"
+        ".search-button:hover {"
+        "  background-color: #b2f2bb;"
+        "}\n"
+
+        // ========================
+        // Combo Box List Row Styles
+        // ========================
+        "combobox box list row,"
+        "combobox menuitem {"
+        "  padding: 4px 12px;"
+        "  min-height: 28px;"
+        "  font-size: 13pt;"
+        "}\n"
+
+        // ======================================
+        // Standard Recipe Link Button Styles
+        // ======================================
+        "button.recipe-button {"
+        "  background-image: none;"
+        "  background-color: #FFFBE7;"
+        "  box-shadow: 0 1px 2px rgba(0, 0, 0, 0.1);"
+        "  color: #000000;"
+        "  font-weight: bold;"
+        "  font-size: 12pt;"
+        "  border: 1px solid #E0C080;"
+        "  border-radius: 6px;"
+        "  padding: 6px 10px;"
+        "}\n"
+        "button.recipe-button:hover {"
+        "  border-color: #888888;"            /* dark gray hover */
+        "  background-color: #FFFBE7;"        /* subtle lighten */
+        "}\n"
+
+        // ======================================
+        // Partial Match Recipe Styles (Light Beige + Hover)
+        // ======================================
+        "button.recipe-partial {"
+        "  background-image: none;"
+        "  background-color: #FFF8E1;"
+        "  color: #000000;"
+        "  font-weight: bold;"
+        "  font-size: 12pt;"
+        "  border: 1px solid #E0C080;"
+        "  border-radius: 6px;"
+        "  padding: 6px 10px;"
+        "}\n"
+        "button.recipe-partial:hover {"
+        "  border-color: #AFA89A;"            /* warm gray hover */
+        "  background-color: #FFFBE7;"        /* subtle lighten */
+        "}\n"
+
+        // =================================================
+        // Perfect Match Recipe Styles (Bright Yellow + Blue Hover)
+        // =================================================
+        "button.recipe-perfect {"
+        "  background-image: none;"
+        "  background-color: #fff7b3;"
+        "  color: #000000;"
+        "  font-weight: bold;"
+        "  font-size: 12pt;"
+        "  border: 2px solid #FFD700;"
+        "  border-radius: 6px;"
+        "  padding: 6px 10px;"
+        "}\n"
+        "button.recipe-perfect:hover {"
+        "  border-color: #4A90E2;"            /* blue glow effect on hover */
+        "  background-color: #fffb90;"        /* subtle lighten */
+        "}\n";
+
+    register_css_styles(css);
+}
+
+
+
+// ==========================================================================
+//  ***  PERSISTENT NODE.JS SCRAPER WORKER  ***
+// ==========================================================================
+
+/*
+NOTES ON THE SCRAPER WORKER:
+
+Launching "node script.js" for every search meant a cold start of Node.js,
+Playwright and a full Chromium instance per query (often 2-4 seconds before
+the first byte). Instead, one long-lived Node.js worker is started right
+after the splash screen dependency check and stays up for the life of the app.
+
+  - The worker keeps a warm Chromium browser, plus one browser context per
+    recipe site that is reused across searches (cookies, cache, consent).
+  - Each site's embedded *_js_code script runs inside the worker unchanged:
+    require('playwright') is redirected so chromium.launch() hands back the
+    warm browser, and browser.close() only closes that search's pages.
+  - console.log() output of a script is captured and returned as its
+    "stdout", so the C parsers parse exactly what they used to read via popen().
+
+Site scripts are never written to temporary .js files. The first time a
+site runs in a worker, its script is sent once in a "register" message and
+kept by the worker under the site's key; every later search of that site
+is just a small "run" message. A restarted worker starts with no scripts,
+so they are registered again on first use.
+
+Protocol (one JSON object per line):
+   C -> worker:  {"op":"register","site":"allrecipes","script":"..."}
+                 (no reply; a script that does not compile is logged, and
+                 its runs fail with code 1)
+   C -> worker:  {"op":"run","id":7,"site":"allrecipes",
+                  "args":["chili"],"timeout_ms":90000}
+   worker -> C:  {"id":7,"ok":true,"code":0,"stdout":"[...]","ms":812}
+   A "run" request with "stream":true gets its console output as it is
+   printed, in {"id":7,"out":"..."} lines, and an empty final "stdout".
+   A "run" request with "diagnostics":"<folder>" (diagnostics mode, off
+   unless enabled for the site, see scrape_diagnostics_load) runs in a
+   fresh context that records a HAR file, and saves a full-page screenshot
+   and the DOM of each page before it closes, all into that folder.
+   C -> worker:  {"op":"cancel","id":7}  closes job 7's pages (aborting a
+                 pending page.goto) and ends it with code 130; the C side
+                 has stopped waiting by then, so that reply is ignored.
+   Other ops:    {"op":"ping"} and {"op":"shutdown"}.
+   On startup the worker announces itself with a reply that has id 0.
+
+All C parsers reach the worker through run_site_script(), which is safe to
+call from any search thread. If the worker is missing or has crashed, it is
+restarted (at most once every SCRAPE_WORKER_RESTART_DELAY_US).
+*/
+
+// Scraper worker JavaScript (run with "node -e")
+static const char *scrape_worker_js_code =
+"const readline = require('readline');\n"
+"const path = require('path');\n"
+"const util = require('util');\n"
+"const vm = require('vm');\n"
+"const fs = require('fs');\n"
+"const { execSync } = require('child_process');\n"
+"\n"
+"function log(msg) {\n"
+"  process.stderr.write('[JS WORKER] ' + msg + '\\n');\n"
+"}\n"
+"\n"
+"function send(obj) {\n"
+"  process.stdout.write(JSON.stringify(obj) + '\\n');\n"
+"}\n"
+"\n"
+"// Resolve modules from NODE_PATH first, then from the global npm root\n"
+"// (resolved once by the app at startup; asked from npm only as a fallback).\n"
+"let globalRoot = process.env.RECIPE_FINDER_NPM_ROOT || null;\n"
+"function requireModule(name) {\n"
+"  try {\n"
+"    return require(name);\n"
+"  } catch (e) {\n"
+"    if (globalRoot === null) {\n"
+"      try {\n"
+"        globalRoot = execSync('npm root -g', { encoding: 'utf8', stdio: ['ignore', 'pipe', 'ignore'] }).trim();\n"
+"      } catch (e2) {\n"
+"        globalRoot = '';\n"
+"      }\n"
+"    }\n"
+"    if (!globalRoot) throw e;\n"
+"    return require(path.join(globalRoot, name));\n"
+"  }\n"
+"}\n"
+"\n"
+"let playwright = null;\n"
+"try {\n"
+"  playwright = requireModule('playwright');\n"
+"} catch (e) {\n"
+"  log('Playwright is not available: ' + e.message);\n"
+"}\n"
+"\n"
+"// Warm browsers keyed by launch options, and one reusable context per site.\n"
+"const browsers = new Map();\n"
+"const siteContexts = new Map();\n"
+"\n"
+"function launchKey(opts) {\n"
+"  return JSON.stringify({ headless: opts.headless !== false, args: opts.args || [] });\n"
+"}\n"
+"\n"
+"function getBrowser(opts) {\n"
+"  const key = launchKey(opts);\n"
+"  let browser = browsers.get(key);\n"
+"  if (!browser) {\n"
+"    browser = playwright.chromium.launch(opts);\n"
+"    browsers.set(key, browser);\n"
+"    browser.then(b => b.on('disconnected', () => {\n"
+"      browsers.delete(key);\n"
+"      for (const k of [...siteContexts.keys()]) {\n"
+"        if (k.endsWith('|' + key)) siteContexts.delete(k);\n"
+"      }\n"
+"    }), () => browsers.delete(key));\n"
+"  }\n"
+"  return browser;\n"
+"}\n"
+"\n"
+"async function getSiteContext(site, opts, ctxOpts) {\n"
+"  const key = launchKey(opts);\n"
+"  const ctxKey = site + '|' + key;\n"
+"  let ctx = siteContexts.get(ctxKey);\n"
+"  if (!ctx) {\n"
+"    ctx = getBrowser(opts).then(b => b.newContext(ctxOpts || {}));\n"
+"    siteContexts.set(ctxKey, ctx);\n"
+"    ctx.catch(() => siteContexts.delete(ctxKey));\n"
+"  }\n"
+"  return ctx;\n"
+"}\n"
+"\n"
+"// Diagnostics jobs (\"diagnostics\": folder) save their page artifacts there,\n"
+"// named <site>-<start time>-<n>.\n"
+"function artifactBase(job, n) {\n"
+"  return path.join(job.diagnostics, job.site + '-' + job.stamp + '-' + n);\n"
+"}\n"
+"\n"
+"async function captureArtifacts(job, page) {\n"
+"  const base = artifactBase(job, ++job.captured);\n"
+"  try {\n"
+"    await page.screenshot({ path: base + '.png', fullPage: true });\n"
+"    fs.writeFileSync(base + '.html', await page.content(), 'utf-8');\n"
+"    log('[' + job.site + '] Saved ' + base + '.png and .html');\n"
+"  } catch (e) {\n"
+"    log('[' + job.site + '] Diagnostics capture failed: ' + e.message);\n"
+"  }\n"
+"}\n"
+"\n"
+"// A diagnostics job gets a context of its own, so its HAR file (written when\n"
+"// the context closes) holds only this job's traffic.\n"
+"async function diagnosticsContext(job, opts, ctxOpts) {\n"
+"  const har = artifactBase(job, 'context' + (job.contexts.length + 1)) + '.har';\n"
+"  const browser = await getBrowser(opts);\n"
+"  const ctx = await browser.newContext(Object.assign({}, ctxOpts, { recordHar: { path: har } }));\n"
+"  job.contexts.push(ctx);\n"
+"  return ctx;\n"
+"}\n"
+"\n"
+"async function closeJobPages(job) {\n"
+"  const pages = job.pages.splice(0);\n"
+"  if (job.diagnostics) await Promise.all(pages.map(p => captureArtifacts(job, p)));\n"
+"  await Promise.all(pages.map(p => p.close().catch(() => {})));\n"
+"  const contexts = job.contexts.splice(0);\n"
+"  await Promise.all(contexts.map(c => c.close().catch(() => {})));\n"
+"}\n"
+"\n"
+"// Context handed to a script: pages it opens are tracked and closed when the\n"
+"// job ends, while the underlying context (cookies, cache) stays warm.\n"
+"function wrapContext(ctx, job) {\n"
+"  return new Proxy(ctx, {\n"
+"    get(target, prop) {\n"
+"      if (prop === 'newPage') {\n"
+"        return async () => {\n"
+"          const page = await target.newPage();\n"
+"          job.pages.push(page);\n"
+"          return page;\n"
+"        };\n"
+"      }\n"
+"      if (prop === 'close') return () => closeJobPages(job);\n"
+"      const value = target[prop];\n"
+"      return typeof value === 'function' ? value.bind(target) : value;\n"
+"    }\n"
+"  });\n"
+"}\n"
+"\n"
+"// Browser handed to a script in place of chromium.launch(): close() only\n"
+"// releases the job's pages; the real browser keeps running.\n"
+"function makeBrowser(job, opts) {\n"
+"  const contextFor = async (ctxOpts) => wrapContext(await (job.diagnostics\n"
+"    ? diagnosticsContext(job, opts, ctxOpts)\n"
+"    : getSiteContext(job.site, opts, ctxOpts)), job);\n"
+"  return {\n"
+"    newContext: (ctxOpts) => contextFor(ctxOpts),\n"
+"    newPage: async () => (await contextFor()).newPage(),\n"
+"    close: () => closeJobPages(job),\n"
+"    isConnected: () => true,\n"
+"    version: async () => (await getBrowser(opts)).version()\n"
+"  };\n"
+"}\n"
+"\n"
+"function makePlaywright(job) {\n"
+"  if (!playwright) throw new Error(\"Cannot find module 'playwright'\");\n"
+"  const chromium = Object.create(playwright.chromium);\n"
+"  chromium.launch = async (opts) => makeBrowser(job, opts || {});\n"
+"  return Object.assign(Object.create(playwright), { chromium });\n"
+"}\n"
+"\n"
+"// Scripts run through a direct eval so the completion value of the last\n"
+"// statement (usually the async IIFE's promise) tells us when they finish.\n"
+"// V8 caches the compiled code of a repeated eval source, so a registered\n"
+"// script is only parsed on its first run.\n"
+"const runScript = new Function('require', 'process', 'console', 'module', 'exports', '__source',\n"
+"  'return eval(__source);');\n"
+"\n"
+"// Site scripts registered by the app, keyed by site.\n"
+"const scripts = new Map();\n"
+"\n"
+"function registerScript(msg) {\n"
+"  try {\n"
+"    new vm.Script(msg.script, { filename: msg.site + '.js' });  // Syntax check only\n"
+"  } catch (e) {\n"
+"    log('[' + msg.site + '] Script does not compile: ' + e.message);\n"
+"  }\n"
+"  scripts.set(msg.site, msg.script);\n"
+"}\n"
+"\n"
+"// Cancel functions of running jobs, keyed by request id.\n"
+"const runningJobs = new Map();\n"
+"\n"
+"function runJob(msg) {\n"
+"  return new Promise((resolve) => {\n"
+"    const job = { site: msg.site || 'default', pages: [], contexts: [], finished: false, async: false,\n"
+"                  diagnostics: msg.diagnostics || null, captured: 0,\n"
+"                  stamp: new Date().toISOString().replace(/[:.]/g, '-') };\n"
+"    const started = Date.now();\n"
+"    const out = [];\n"
+"    let quietTimer = null;\n"
+"\n"
+"    const finish = (code) => {\n"
+"      if (job.finished) return;\n"
+"      job.finished = true;\n"
+"      runningJobs.delete(msg.id);\n"
+"      clearTimeout(quietTimer);\n"
+"      clearTimeout(hardTimer);\n"
+"      closeJobPages(job).finally(() => resolve({\n"
+"        id: msg.id, ok: code === 0, code, stdout: out.join(''), ms: Date.now() - started\n"
+"      }));\n"
+"    };\n"
+"\n"
+"    const jobLog = (...args) => {\n"
+"      if (job.finished) return;\n"
+"      // Streaming jobs forward each line now instead of in the final reply\n"
+"      if (msg.stream) send({ id: msg.id, out: util.format(...args) + '\\n' });\n"
+"      else out.push(util.format(...args) + '\\n');\n"
+"      // Callback-style scripts (no promise) are done once output goes quiet\n"
+"      if (!job.async) {\n"
+"        clearTimeout(quietTimer);\n"
+"        quietTimer = setTimeout(() => { if (!job.async) finish(0); }, 250);\n"
+"      }\n"
+"    };\n"
+"    const jobErr = (...args) => log('[' + job.site + '] ' + util.format(...args));\n"
+"    const jobConsole = { log: jobLog, info: jobLog, debug: jobLog, error: jobErr, warn: jobErr };\n"
+"\n"
+"    const jobProcess = {\n"
+"      argv: [process.argv[0], job.site + '.js', ...(msg.args || [])],\n"
+"      env: process.env,\n"
+"      platform: process.platform,\n"
+"      exit: (code) => finish(code === undefined ? 0 : code),\n"
+"      nextTick: process.nextTick,\n"
+"      stdout: { write: (s) => { jobLog(String(s).replace(/\\n$/, '')); return true; } },\n"
+"      stderr: process.stderr,\n"
+"      on: () => jobProcess\n"
+"    };\n"
+"\n"
+"    const jobModule = { exports: {} };\n"
+"    const jobRequire = (name) => (name === 'playwright' ? makePlaywright(job) : requireModule(name));\n"
+"    jobRequire.main = jobModule;\n"
+"\n"
+"    const hardTimer = setTimeout(() => {\n"
+"      log('[' + job.site + '] Timed out after ' + (Date.now() - started) + ' ms');\n"
+"      finish(124);\n"
+"    }, msg.timeout_ms || 90000);\n"
+"\n"
+"    // Cancelling closes the job's pages, which aborts any pending page.goto()\n"
+"    runningJobs.set(msg.id, () => {\n"
+"      log('[' + job.site + '] Cancelled after ' + (Date.now() - started) + ' ms');\n"
+"      finish(130);\n"
+"    });\n"
+"\n"
+"    const source = scripts.get(job.site);\n"
+"    if (source === undefined) {\n"
+"      jobErr('No script is registered for this site');\n"
+"      finish(1);\n"
+"      return;\n"
+"    }\n"
+"\n"
+"    let result;\n"
+"    try {\n"
+"      result = runScript(jobRequire, jobProcess, jobConsole, jobModule, jobModule.exports, source);\n"
+"    } catch (e) {\n"
+"      jobErr('Script error:', e);\n"
+"      finish(1);\n"
+"      return;\n"
+"    }\n"
+"    if (result && typeof result.then === 'function') {\n"
+"      job.async = true;\n"
+"      result.then(() => finish(0), (e) => { jobErr('Script error:', e); finish(1); });\n"
+"    }\n"
+"  });\n"
+"}\n"
+"\n"
+"// A stray rejection inside one site script must not take the worker down.\n"
+"process.on('unhandledRejection', (e) => log('Unhandled rejection: ' + (e && e.message ? e.message : e)));\n"
+"process.on('uncaughtException', (e) => log('Uncaught exception: ' + (e && e.stack ? e.stack : e)));\n"
+"\n"
+"let shuttingDown = false;\n"
+"async function shutdown() {\n"
+"  if (shuttingDown) return;\n"
+"  shuttingDown = true;\n"
+"  for (const browser of browsers.values()) {\n"
+"    try { await (await browser).close(); } catch (e) {}\n"
+"  }\n"
+"  process.exit(0);\n"
+"}\n"
+"\n"
+"const rl = readline.createInterface({ input: process.stdin, crlfDelay: Infinity });\n"
+"rl.on('line', (line) => {\n"
+"  if (!line.trim()) return;\n"
+"  let msg;\n"
+"  try {\n"
+"    msg = JSON.parse(line);\n"
+"  } catch (e) {\n"
+"    log('Ignoring malformed request: ' + e.message);\n"
+"    return;\n"
+"  }\n"
+"  if (msg.op === 'run') runJob(msg).then(send);\n"
+"  else if (msg.op === 'register') registerScript(msg);\n"
+"  else if (msg.op === 'cancel') { const cancel = runningJobs.get(msg.id); if (cancel) cancel(); }\n"
+"  else if (msg.op === 'ping') send({ id: msg.id, ok: true, playwright: !!playwright });\n"
+"  else if (msg.op === 'shutdown') shutdown();\n"
+"});\n"
+"rl.on('close', shutdown);\n"
+"\n"
+"send({ id: 0, ok: true, ready: true, playwright: !!playwright });\n"
+"if (playwright) {\n"
+"  getBrowser({ headless: true }).then(() => log('Warm Chromium is ready'),\n"
+"    (e) => log('Chromium launch failed: ' + e.message));\n"
+"}\n";
+
 
-    GString *result = g_string_new(NULL);
-    char *p = input;
+// --------------------------------
 
-    printf("[DEBUG]: Starting function extract_quoted_terms:\n%s\n", search_term);
-    printf("[DEBUG]: Input string address: %p\n\n", (void *)search_term);
 
-    while (*p) {
-        if (*p == '"' || *p == '\'') {
-            printf("[DEBUG] Found quote: %c at position: %td\n", *p, p - input);
-            char quote = *p++;
-            char *start = p;
-            char *end = strchr(start, quote);
-            if (!end) {
-                printf("[DEBUG] No closing quote found. Remaining string: %s\n", start);
-                break;
-            }
+// Handles one reply line from the worker.
+// Looks up the waiting ScrapeJob by id, stores the captured stdout and exit
+// code, and wakes up the parser thread waiting in run_site_script().
+// Streamed output chunks are appended to the job for the waiting thread.
+// Must be called with g_scrape_worker.lock held.
 
-            size_t len = end - start;
-            if (len > 0) {
-                char *term = g_strndup(start, len);
-                char *trimmed = g_strstrip(term);
-                char *processed = g_ascii_strdown(trimmed, -1);
+static void scrape_worker_dispatch_reply(const char *line) {
+    struct json_object *reply = json_tokener_parse(line);
+    if (!reply || !json_object_is_type(reply, json_type_object)) {
+        fprintf(stderr, "[WARNING]: Ignoring malformed scraper worker reply: %.120s\n", line);
+        json_object_put(reply);
+        return;
+    }
 
-                printf("[DEBUG] Found quoted term: %s\n", term);
-                printf("[DEBUG] Processed term: %s\n", processed);
+    struct json_object *id_obj = NULL, *code_obj = NULL, *stdout_obj = NULL, *flag_obj = NULL;
+    guint id = json_object_object_get_ex(reply, "id", &id_obj) ? (guint)json_object_get_int(id_obj) : 0;
 
-                if (result->len > 0)
-                    g_string_append_c(result, ' ');
-                g_string_append(result, processed);
+    if (id == 0) {
+        // Startup announcement
+        gboolean has_playwright = json_object_object_get_ex(reply, "playwright", &flag_obj) &&
+                                  json_object_get_boolean(flag_obj);
+        printf("[INFO]: Scraper worker is ready (Playwright %s).\n",
+               has_playwright ? "loaded" : "NOT available");
+        json_object_put(reply);
+        return;
+    }
 
-                g_free(term);
-                g_free(processed);
-            } else {
-                printf("[DEBUG] Empty quoted string found\n");
-            }
+    ScrapeJob *job = g_hash_table_lookup(g_scrape_worker.pending, GUINT_TO_POINTER(id));
 
-            p = end + 1;
-        } else {
-            p++;
+    // Streamed output chunk of a running job: the waiting thread parses it
+    struct json_object *out_obj = NULL;
+    if (json_object_object_get_ex(reply, "out", &out_obj)) {
+        if (job && job->streamed) {
+            g_string_append(job->streamed, json_object_get_string(out_obj));
+            g_cond_broadcast(&g_scrape_worker.cond);
         }
+        json_object_put(reply);
+        return;
     }
 
-    g_free(input);
-
-    if (result->len > 0) {
-        printf("[DEBUG] Total recipes that matched quoted search term: %zu\n\n", result->len);
-    } else {
-        printf("[DEBUG] No quoted search term found.\n\n");
+    if (job) {
+        g_hash_table_remove(g_scrape_worker.pending, GUINT_TO_POINTER(id));
+        job->exit_code = json_object_object_get_ex(reply, "code", &code_obj) ? json_object_get_int(code_obj) : -1;
+        job->output = g_strdup(json_object_object_get_ex(reply, "stdout", &stdout_obj) ?
+                               json_object_get_string(stdout_obj) : "");
+        job->done = TRUE;
+        g_cond_broadcast(&g_scrape_worker.cond);
     }
 
-    // Caller must g_free() this result.
-    return g_string_free(result, FALSE);
+    json_object_put(reply);
 }
 
 
-// ------------------------------
-
-
-static GList* extract_quoted_phrases(const char *search_term) {
-    if (!search_term) return NULL;
+// --------------------------------
 
-    // Duplicate input to mutable buffer
-    char *input = g_strdup(search_term);
-    normalize_quotes_utf8(input);
 
-    GList *phrases = NULL;
-    char *p = input;
+// Reader thread for the worker's stdout.
+// Reads reply lines until the worker exits (EOF), then fails every job that
+// is still waiting so no parser thread blocks forever, and clears the worker
+// state so the next run_site_script() call can restart it.
 
-    while (*p) {
-        if (*p == '"' || *p == '\'') {
-            char quote = *p++;
-            char *start = p;
-            char *end = strchr(start, quote);
-            if (!end) {
-                // No closing quote; stop processing further
-                break;
-            }
+static gpointer scrape_worker_reader_thread(gpointer data) {
+    GDataInputStream *replies = data;
+    char *line;
 
-            size_t len = end - start;
-            if (len > 0) {
-                char *term = g_strndup(start, len);
-                char *trimmed = g_strstrip(term);
-                char *processed = g_ascii_strdown(trimmed, -1);
+    while ((line = g_data_input_stream_read_line(replies, NULL, NULL, NULL)) != NULL) {
+        g_mutex_lock(&g_scrape_worker.lock);
+        scrape_worker_dispatch_reply(line);
+        g_mutex_unlock(&g_scrape_worker.lock);
+        g_free(line);
+    }
 
-                // Append the full quoted phrase as one string
-                phrases = g_list_append(phrases, processed);
+    g_mutex_lock(&g_scrape_worker.lock);
+    if (g_scrape_worker.replies == replies) {
+        printf("[INFO]: Scraper worker has exited.\n");
 
-                g_free(term);
-                // Note: processed is stored in list, so do not free here
-            }
-            p = end + 1;
-        } else {
-            p++;
+        GHashTableIter iter;
+        gpointer value;
+        g_hash_table_iter_init(&iter, g_scrape_worker.pending);
+        while (g_hash_table_iter_next(&iter, NULL, &value)) {
+            ScrapeJob *job = value;
+            job->exit_code = -1;
+            job->done = TRUE;
         }
+        g_hash_table_remove_all(g_scrape_worker.pending);
+        g_hash_table_remove_all(g_scrape_worker.scripts);  // A new worker starts without scripts
+
+        g_clear_object(&g_scrape_worker.requests);
+        g_clear_object(&g_scrape_worker.replies);
+        g_clear_object(&g_scrape_worker.process);
+        g_cond_broadcast(&g_scrape_worker.cond);
     }
+    g_mutex_unlock(&g_scrape_worker.lock);
 
-    g_free(input);
-    return phrases; // caller must free list and strings
+    g_object_unref(replies);
+    return NULL;
 }
 
 
-// ------------------------------
-
-
+// --------------------------------
 
-// Normalize single and double curly quote marks in-place to ASCII quotes.
-// This can expanded later to handle more UTF-8 symbols if needed.
 
-static void normalize_quotes_utf8(char *str) {
-    if (!str) return;
+// Reads which sites run their scripts in diagnostics mode (off by default):
+// the RECIPE_FINDER_DIAGNOSTICS environment variable if it is set, else the
+// "sites" array of diagnostics.json in the app's config folder. Entries are
+// site keys (e.g. "bbcgoodfood") or "all". Returns the set of entries, or
+// NULL when diagnostics are off.
 
-    for (; *str; ++str) {
-        unsigned char c = (unsigned char)*str;
+static GHashTable *scrape_diagnostics_load(void) {
+    GHashTable *sites = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 
-        switch (c) {
-            // ASCII-compatible replacement for common curly quotes:
-            case 0xE2: {
-                if ((unsigned char)str[1] == 0x80) {
-                    switch ((unsigned char)str[2]) {
-                        case 0x98: // ‘
-                        case 0x99: // ’
-                            *str = '\'';
-                            str[1] = str[2] = ' ';
-                            break;
-                        case 0x9C: // “
-                        case 0x9D: // ”
-                            *str = '"';
-                            str[1] = str[2] = ' ';
-                            break;
+    const char *env_sites = g_getenv(SCRAPE_DIAGNOSTICS_ENV);
+    if (env_sites) {
+        char **entries = g_strsplit_set(env_sites, ", ", -1);
+        for (char **entry = entries; *entry; ++entry) {
+            if (**entry) g_hash_table_add(sites, g_strdup(*entry));
+        }
+        g_strfreev(entries);
+    } else {
+        char *path = g_build_filename(g_get_user_config_dir(), "recipe_finder", SCRAPE_DIAGNOSTICS_FILE, NULL);
+        char *contents = NULL;
+        if (g_file_get_contents(path, &contents, NULL, NULL)) {
+            struct json_object *root = json_tokener_parse(contents);
+            struct json_object *list = NULL;
+            if (root && json_object_object_get_ex(root, "sites", &list) &&
+                json_object_is_type(list, json_type_array)) {
+                size_t n_entries = json_object_array_length(list);
+                for (size_t i = 0; i < n_entries; ++i) {
+                    struct json_object *entry = json_object_array_get_idx(list, i);
+                    if (json_object_is_type(entry, json_type_string)) {
+                        g_hash_table_add(sites, g_strdup(json_object_get_string(entry)));
                     }
                 }
-                break;
+            } else {
+                fprintf(stderr, "[WARNING]: Ignoring %s (expected {\"sites\": [...]}).\n", path);
             }
+            json_object_put(root);
+            g_free(contents);
         }
-    }
-}
-
-
-
-// ------------------------------
-
-
-static QuoteStatus detect_quote_status(const char *search_term) {
-    int single_quotes = 0;
-    int double_quotes = 0;
-
-    for (const char *p = search_term; *p; p++) {
-        if (*p == '\'') single_quotes++;
-        else if (*p == '"') double_quotes++;
-    }
-
-    if ((single_quotes > 0 && single_quotes % 2 == 0) ||
-        (double_quotes > 0 && double_quotes % 2 == 0)) {
-        return QUOTE_PAIR;
+        g_free(path);
     }
 
-    if (single_quotes > 0 || double_quotes > 0) {
-        return QUOTE_SINGLE;
+    if (g_hash_table_size(sites) == 0) {
+        g_hash_table_destroy(sites);
+        return NULL;
     }
-
-    return QUOTE_NONE;
+    printf("[INFO]: Scraper diagnostics enabled for %u site entries.\n", g_hash_table_size(sites));
+    return sites;
 }
 
 
+// --------------------------------
 
-// ---------------------------------------------------------------------------
-// ---------------------------------------------------------------------------
-
-
-// The following two functions work together as a text preprocessing utility
-//   that extracts meaningful keywords from recipe titles, the user's input.
-// These functions are handy to:
-//    - Parse recipe titles or user search queries into keywords.
-//    -  Improve search matching (ignoring filler words).
-//    - Build tags or indexes from recipe names.
-// For example:
-//    User searches for: "The Best Soup in the World"
-//    After filtering: [best soup world] becomes the key search words, which
-//      match recipes more effectively by comparing only meaningful words.
-
-// Stop-Words List
-// Purpose:
-// Checks whether a given word is a stop word (commonly ignored words).
-// Implementation:
-//   It loops through the stop_words[] list.
-//   Uses g_ascii_strcasecmp() (case-insensitive compare).
-//   Returns TRUE if the word matches a stop word, otherwise FALSE.
-
-static const char *stop_words[] = {
-    "a", "an", "the", "and", "or", "with", "of", "in", "on", "at", "to", "for", "by", NULL
-};
 
-// Check if word is stop word (case-insensitive)
-static gboolean is_stop_word(const char *word) {
-    if (!word) return FALSE;
+// Folder that diagnostics artifacts are written to, created if needed
+// (in the user cache folder, next to the result cache).
+// Returns a newly allocated path (caller must g_free).
 
-    for (int i = 0; stop_words[i] != NULL; i++) {
-        if (g_ascii_strcasecmp(word, stop_words[i]) == 0) {
-            return TRUE;
-        }
-    }
-    return FALSE;
+static char *scrape_diagnostics_folder(void) {
+    char *folder_path = g_build_filename(g_get_user_cache_dir(), "recipe_finder", "diagnostics", NULL);
+    g_mkdir_with_parents(folder_path, 0700);
+    return folder_path;
 }
 
 
-// ---------------------------------------------------------------------------
-
-
-// Tokenizes, lowercases, filters stop words, returns GList of tokens
-// Purpose:
-// Takes a full phrase, splits it into words (tokens), lowercases them, removes
-//    stop words, and returns the remaining tokens in a GList.
-//  Implementation:
-//    1. Converts the entire input phrase to lowercase (g_ascii_strdown).
-//    2. Tokenizes by spaces (strtok_r).
-//    3. Skips stop words using is_stop_word().
-//    4.	Adds remaining words to a GList (each word duplicated with g_strdup()so they survive after freeing the input buffer).
-//    5.Returns the GList * of filtered tokens.
+// --------------------------------
 
-GList *tokenize_and_filter_stop_words(const char *phrase) {
-    if (!phrase) return NULL;
 
-    // Duplicate and lowercase input for tokenization
-    char *input = g_ascii_strdown(phrase, -1);
-    GList *filtered_tokens = NULL;
+// Starts the scraper worker if it is not already running.
+// Called once from main() after the dependency check, and again lazily by
+// run_site_script() if the worker has died. Restarts are throttled so a
+// missing Node.js install does not cause a spawn attempt on every search.
+// Returns TRUE if the worker is running.
 
-    // Tokenize by space
-    char *saveptr = NULL;
-    char *token = strtok_r(input, " ", &saveptr);
+static gboolean scrape_worker_start(void) {
+    g_mutex_lock(&g_scrape_worker.lock);
 
-    while (token) {
-        if (!is_stop_word(token)) {
-            // Add to filtered list (dup because input will be freed)
-            filtered_tokens = g_list_append(filtered_tokens, g_strdup(token));
+    // Read the concurrent browser job cap once (environment override first)
+    if (g_scrape_worker.max_active_jobs == 0) {
+        const char *env_cap = g_getenv(SCRAPE_WORKER_MAX_BROWSERS_ENV);
+        guint64 cap = env_cap ? g_ascii_strtoull(env_cap, NULL, 10) : 0;
+        if (cap < 1 || cap > SCRAPE_WORKER_MAX_BROWSER_JOBS_LIMIT) {
+            if (env_cap) {
+                fprintf(stderr, "[WARNING]: Ignoring %s=%s (expected 1-%d).\n",
+                        SCRAPE_WORKER_MAX_BROWSERS_ENV, env_cap, SCRAPE_WORKER_MAX_BROWSER_JOBS_LIMIT);
+            }
+            cap = SCRAPE_WORKER_MAX_BROWSER_JOBS;
         }
-        token = strtok_r(NULL, " ", &saveptr);
+        g_scrape_worker.max_active_jobs = (guint)cap;
+        printf("[INFO]: Running at most %u browser jobs at once.\n", g_scrape_worker.max_active_jobs);
+        g_scrape_worker.diagnostics = scrape_diagnostics_load();
     }
 
-    g_free(input);
-    return filtered_tokens;
-}
+    if (g_scrape_worker.process) {
+        g_mutex_unlock(&g_scrape_worker.lock);
+        return TRUE;
+    }
 
+    gint64 now = g_get_monotonic_time();
+    if (g_scrape_worker.last_start_attempt != 0 &&
+        now - g_scrape_worker.last_start_attempt < SCRAPE_WORKER_RESTART_DELAY_US) {
+        g_mutex_unlock(&g_scrape_worker.lock);
+        return FALSE;
+    }
+    g_scrape_worker.last_start_attempt = now;
 
-// ---------------------------------------------------------------------------
-// ---------------------------------------------------------------------------
+    // Reap the reader thread of a previous worker that has exited
+    if (g_scrape_worker.reader_thread) {
+        g_thread_join(g_scrape_worker.reader_thread);
+        g_scrape_worker.reader_thread = NULL;
+    }
 
+    if (!g_scrape_worker.pending) {
+        g_scrape_worker.pending = g_hash_table_new(g_direct_hash, g_direct_equal);
+        g_scrape_worker.scripts = g_hash_table_new(g_str_hash, g_str_equal);
+    }
 
+    // stderr is inherited so the worker's [JS WORKER] logs appear in the terminal
+    GSubprocessLauncher *launcher = g_subprocess_launcher_new(
+        G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_PIPE);
+    const gchar *argv[] = { runtime_env_node(), "-e", scrape_worker_js_code, NULL };
 
-// Normalizes a recipe title to lowercase.
-// It also checks if the search term (needle) appears anywhere inside the
-// recipe title (haystack).
+    GError *error = NULL;
+    GSubprocess *process = g_subprocess_launcher_spawnv(launcher, argv, &error);
+    g_object_unref(launcher);
 
-static bool contains_word_case_insensitive(const char *haystack, const char *needle) {
-    if (!haystack || !needle) return false;
+    if (!process) {
+        fprintf(stderr, "[WARNING]: Could not start the Node.js scraper worker: %s\n",
+                error ? error->message : "unknown error");
+        g_clear_error(&error);
+        g_mutex_unlock(&g_scrape_worker.lock);
+        return FALSE;
+    }
 
-    char h[512], n[128];
-    strncpy(h, haystack, sizeof(h) - 1);
-    strncpy(n, needle, sizeof(n) - 1);
-    h[sizeof(h) - 1] = '\0';
-    n[sizeof(n) - 1] = '\0';
+    g_scrape_worker.process = process;
+    g_scrape_worker.requests = g_object_ref(g_subprocess_get_stdin_pipe(process));
+    g_scrape_worker.replies = g_data_input_stream_new(g_subprocess_get_stdout_pipe(process));
+    g_scrape_worker.reader_thread = g_thread_new("scrape_worker_reader",
+                                                 scrape_worker_reader_thread,
+                                                 g_object_ref(g_scrape_worker.replies));
 
-    // Convert both to lowercase
-    for (char *p = h; *p; ++p) *p = tolower(*p);
-    for (char *p = n; *p; ++p) *p = tolower(*p);
+    printf("[INFO]: Started the Node.js scraper worker (pid %s).\n",
+           g_subprocess_get_identifier(process) ? g_subprocess_get_identifier(process) : "?");
 
-    return strstr(h, n) != NULL;
+    g_mutex_unlock(&g_scrape_worker.lock);
+    return TRUE;
 }
 
 
-// ------------------------------
+// --------------------------------
+
 
+// Stops the scraper worker at app exit.
+// Asks the worker to close its browsers and exit, waits briefly, and
+// force-kills it if it does not go away on its own.
 
+static void scrape_worker_stop(void) {
+    g_mutex_lock(&g_scrape_worker.lock);
 
-// Helper to recursively extract the visible text from a recipe anchor tag
-static const char* extract_anchor_text(GumboNode *node) {
-    if (node->type == GUMBO_NODE_TEXT)
-        return node->v.text.text;
+    if (g_scrape_worker.process) {
+        static const char shutdown_request[] = "{\"op\":\"shutdown\"}\n";
+        g_output_stream_write_all(g_scrape_worker.requests, shutdown_request,
+                                  sizeof(shutdown_request) - 1, NULL, NULL, NULL);
+        g_output_stream_flush(g_scrape_worker.requests, NULL, NULL);
 
-    if (node->type == GUMBO_NODE_ELEMENT || node->type == GUMBO_NODE_DOCUMENT) {
-        GumboVector *children = &node->v.element.children;
-        for (unsigned int i = 0; i < children->length; ++i) {
-            const char *text = extract_anchor_text(children->data[i]);
-            if (text && *text) return text;
+        gint64 deadline = g_get_monotonic_time() + 3 * G_USEC_PER_SEC;
+        while (g_scrape_worker.process &&
+               g_cond_wait_until(&g_scrape_worker.cond, &g_scrape_worker.lock, deadline))
+            ;
+
+        if (g_scrape_worker.process) {
+            fprintf(stderr, "[WARNING]: Scraper worker did not exit, killing it.\n");
+            g_subprocess_force_exit(g_scrape_worker.process);
         }
     }
-    return NULL;
-}
-
 
+    GThread *reader = g_scrape_worker.reader_thread;
+    g_scrape_worker.reader_thread = NULL;
+    g_mutex_unlock(&g_scrape_worker.lock);
 
-// ------------------------------
+    if (reader) {
+        g_thread_join(reader);
+    }
+}
 
-// Helper: Converts a recipe slug (any format) into a nicely spaced, Title Case-ready string.
-//
-// A recipe slug is the short, URL-friendly identifier for a recipe, typically
-// found at the end of a food webpage URL. It usually contains words from
-// the recipe's title, joined together without spaces or with dashes/underscores.
-// This function:
-// - Trims whitespace
-// - Replaces dashes/underscores with spaces
-// - Inserts a space before capital letters in camelCase or PascalCase slugs
-// - Leaves capitalization untouched; final Title Casing is handled in
-//   the add_link() function
-// Formats handled:
-// - camelCase:     cheesyChickenCasserole
-// - PascalCase:    CheesyChickenCasserole
-// - snake_case:    cheesy_chicken_casserole
-// - kebab-case:    cheesy-chicken-casserole
-// Think of PascalCase as "CamelCase wearing a top hat."
-// Think of camelCase as "PascalCase on casual Friday."
 
-static void slug_to_title(const char *slug, char *out, size_t out_size) {
+// --------------------------------
 
-printf("[DEBUG]: slug_to_title function input slug:%s\n", slug);
 
-    char trimmed_slug[256];
-    trim_whitespace(slug, trimmed_slug, sizeof(trimmed_slug));
+// Runs one site's embedded JavaScript in the scraper worker.
+// This is the single dispatcher used by all JS-backed parsers, replacing the
+// per-parser temp file + popen("node ...") boilerplate.
+//   - site_key:    short site name; selects the registered script and the
+//                  reusable browser context (must be a static string)
+//   - js_code:     the site's embedded *_js_code script, registered with the
+//                  worker on the site's first run
+//   - search_term: passed to the script as process.argv[2]
+//   - exit_code:   optional; receives the script's exit code
+// Blocks the calling (search) thread until the worker replies.
+// At most max_active_jobs scripts run at once, since every job holds a
+// Chromium page; extra callers wait here for a free slot. When the calling
+// search has a deadline (set on "All Sites" site contexts), both the slot
+// wait and the worker's job timeout honour it. Cancelled searches return
+// NULL without running the script, and a search cancelled while its script
+// runs stops waiting at once and has the worker cancel the job (freeing
+// its Chromium pages for the next search).
+// Returns the script's captured stdout (caller must g_free), or NULL if the
+// worker is unavailable or did not reply in time.
+
+static char *run_site_script(SearchContext *search, const char *site_key, const char *js_code, const char *search_term, int *exit_code) {
+    return scrape_worker_run(search, site_key, js_code, search_term, NULL, exit_code);
+}
 
-    bool had_space = false, had_underscore = false, had_dash = false;
 
-    for (size_t i = 0; trimmed_slug[i] != '\0'; ++i) {
-        if (trimmed_slug[i] == ' ') had_space = true;
-        else if (trimmed_slug[i] == '_') had_underscore = true;
-        else if (trimmed_slug[i] == '-') had_dash = true;
-    }
+// --------------------------------
 
-    size_t out_index = 0;
 
-    if (had_space || had_underscore || had_dash) {
-        for (size_t i = 0; trimmed_slug[i] != '\0' && out_index < out_size - 1; ++i) {
-            char c = trimmed_slug[i];
-            if (c == '_' || c == '-') c = ' ';
-            out[out_index++] = c;
-        }
-    } else {
-        // Insert space before capital letters following lowercase letters
-        for (size_t i = 0; trimmed_slug[i] != '\0' && out_index < out_size - 1; ++i) {
-            char c = trimmed_slug[i];
-            if (i > 0 && isupper((unsigned char)c) && islower((unsigned char)trimmed_slug[i - 1])) {
-                if (out_index < out_size - 2)
-                    out[out_index++] = ' ';
-            }
-            out[out_index++] = c;
-        }
-    }
+// Runs one site's embedded JavaScript in the scraper worker like
+// run_site_script(), but streams the script's output: every JSON record it
+// prints (array elements or NDJSON lines) is passed to on_record in the
+// calling thread as soon as it arrives, so the output size is unbounded and
+// links can be used before the script has finished.
+// Returns TRUE if the script ran and its output was well-formed JSON.
 
-    out[out_index] = '\0';
+static gboolean run_site_script_records(SearchContext *search, const char *site_key, const char *js_code, const char *search_term,
+                                        JsonRecordFunc on_record, gpointer user_data, int *exit_code) {
+    JsonRecordStream *stream = json_record_stream_new(on_record, user_data);
+    char *output = scrape_worker_run(search, site_key, js_code, search_term, stream, exit_code);
 
-printf("[DEBUG]: slug_to_title function output title:%s\n", out);
+    gboolean ok = output != NULL && json_record_stream_finish(stream);
+    printf("[INFO]: %s script streamed %.1f KB, %u records.\n",
+           site_key, stream->bytes_fed / 1024.0, stream->records);
 
+    g_free(output);
+    json_record_stream_free(stream);
+    return ok;
 }
 
 
+// --------------------------------
 
-// ----------------------------
 
+// Worker job runner shared by run_site_script() and run_site_script_records().
+// With a stream, the job is sent with "stream":true and its output chunks
+// are fed to the stream while waiting (outside the worker lock); the
+// returned string is then empty. See run_site_script() for the rest.
 
-// Callback for when a recipe button is clicked
-// Safely retrieves the URL stored in the button's data
-static void on_recipe_clicked(GtkWidget *btn, gpointer user_data G_GNUC_UNUSED) {
-    // Get the URL stored in the button
-    const char *url = g_object_get_data(G_OBJECT(btn), "url");
+static char *scrape_worker_run(SearchContext *search, const char *site_key, const char *js_code, const char *search_term,
+                               JsonRecordStream *stream, int *exit_code) {
+    if (exit_code) *exit_code = -1;
 
-    if (!url) {
-        g_warning("Recipe button clicked but URL is missing!");
-        return;
+    if (search_context_is_cancelled(search)) {
+        printf("[INFO]: %s search was cancelled; not running its script.\n", search->site_name);
+        return NULL;
     }
 
-    // Open the URL in the default browser
-    gtk_show_uri_on_window(NULL, url, GDK_CURRENT_TIME, NULL);
-
-    // Note: Do NOT free 'url' here because it's owned by the button
-    // It will be freed automatically when the button is destroyed
-}
+    if (!scrape_worker_start()) {
+        fprintf(stderr, "[WARNING]: Scraper worker is not running; cannot run %s script.\n", site_key);
+        return NULL;
+    }
 
+    ScrapeJob job = { FALSE, NULL, -1, stream ? g_string_new(NULL) : NULL };
 
+    gint64 site_deadline = search_context_deadline(search);
+    gint64 job_deadline = site_deadline ? site_deadline
+                                        : g_get_monotonic_time() + (gint64)SCRAPE_JOB_TIMEOUT_MS * 1000;
 
-// ------------------------------
+    g_mutex_lock(&g_scrape_worker.lock);
 
+    // Wait for a free browser slot (job replies and cancellations broadcast
+    // the condition)
+    while (g_scrape_worker.process &&
+           g_scrape_worker.active_jobs >= g_scrape_worker.max_active_jobs &&
+           !search_context_is_cancelled(search) &&
+           g_cond_wait_until(&g_scrape_worker.cond, &g_scrape_worker.lock, job_deadline))
+        ;
 
-// Helper: This ensures the search box gets the cursor and keyboard focus
-// after the app window is shown
+    if (!g_scrape_worker.process || search_context_is_cancelled(search)) {
+        g_mutex_unlock(&g_scrape_worker.lock);
+        if (job.streamed) g_string_free(job.streamed, TRUE);
+        return NULL;
+    }
 
-static gboolean focus_entry_idle(gpointer user_data) {
-    GtkWidget *entry = GTK_WIDGET(user_data);
-    gtk_widget_grab_focus(entry);
-    // Also explicitly set focus on the window itself
-    GtkWindow *win = GTK_WINDOW(gtk_widget_get_toplevel(entry));
-    gtk_window_set_focus(win, entry);
-    return FALSE;
-}
+    if (g_scrape_worker.active_jobs >= g_scrape_worker.max_active_jobs) {
+        fprintf(stderr, "[WARNING]: No free browser slot for the %s script before its deadline.\n", site_key);
+        g_mutex_unlock(&g_scrape_worker.lock);
+        if (job.streamed) g_string_free(job.streamed, TRUE);
+        return NULL;
+    }
 
-// ------------------------------
+    // Whatever is left of the deadline becomes the worker-side job timeout
+    gint64 timeout_ms = (job_deadline - g_get_monotonic_time()) / 1000;
+    if (timeout_ms < 1000) timeout_ms = 1000;
+    if (timeout_ms > SCRAPE_JOB_TIMEOUT_MS) timeout_ms = SCRAPE_JOB_TIMEOUT_MS;
 
+    g_scrape_worker.active_jobs++;
 
+    guint id = ++g_scrape_worker.next_job_id;
+    if (id == 0) id = ++g_scrape_worker.next_job_id;  // id 0 is reserved for the ready message
 
-// Focus the entry field to automatically get keyboard focus when the window is shown
+    GString *line = g_string_new(NULL);
 
-static void on_window_realize(GtkWidget *widget G_GNUC_UNUSED, gpointer user_data) {
-    g_idle_add(focus_entry_idle, user_data);
-}
+    // Register the site's script first if this worker does not have it yet
+    // (written together with the run request, so the worker sees it first)
+    if (g_hash_table_lookup(g_scrape_worker.scripts, site_key) != js_code) {
+        struct json_object *registration = json_object_new_object();
+        json_object_object_add(registration, "op", json_object_new_string("register"));
+        json_object_object_add(registration, "site", json_object_new_string(site_key));
+        json_object_object_add(registration, "script", json_object_new_string(js_code));
+        g_string_append(line, json_object_to_json_string_ext(registration, JSON_C_TO_STRING_PLAIN));
+        g_string_append_c(line, '\n');
+        json_object_put(registration);
 
+        g_hash_table_insert(g_scrape_worker.scripts, (gpointer)site_key, (gpointer)js_code);
+        printf("[INFO]: Registering the %s script with the scraper worker (%zu bytes).\n",
+               site_key, strlen(js_code));
+    }
 
-// ==================
+    struct json_object *request = json_object_new_object();
+    struct json_object *args = json_object_new_array();
+    json_object_array_add(args, json_object_new_string(search_term ? search_term : ""));
+    json_object_object_add(request, "op", json_object_new_string("run"));
+    json_object_object_add(request, "id", json_object_new_int((int)id));
+    json_object_object_add(request, "site", json_object_new_string(site_key));
+    json_object_object_add(request, "args", args);
+    json_object_object_add(request, "timeout_ms", json_object_new_int((int)timeout_ms));
+    if (stream) {
+        json_object_object_add(request, "stream", json_object_new_boolean(TRUE));
+    }
 
+    // Diagnostics mode makes the worker save this job's page artifacts
+    if (g_scrape_worker.diagnostics &&
+        (g_hash_table_contains(g_scrape_worker.diagnostics, site_key) ||
+         g_hash_table_contains(g_scrape_worker.diagnostics, "all"))) {
+        char *folder = scrape_diagnostics_folder();
+        json_object_object_add(request, "diagnostics", json_object_new_string(folder));
+        printf("[INFO]: %s job runs in diagnostics mode (artifacts in %s).\n", site_key, folder);
+        g_free(folder);
+    }
 
-// This sets up a customized appearance (colors, fonts) via CSS at runtime.
-// It loads a CSS string and applies the CSS styles globally to all of the GTK
-// widgets in the app.
+    g_string_append(line, json_object_to_json_string_ext(request, JSON_C_TO_STRING_PLAIN));
+    g_string_append_c(line, '\n');
+    json_object_put(request);
 
-// CSS errors are captured and reported.
-// This 
+    g_hash_table_insert(g_scrape_worker.pending, GUINT_TO_POINTER(id), &job);
 
-static void register_css_styles(const gchar *css_data) {
-    GtkCssProvider *css_provider = gtk_css_provider_new();
     GError *error = NULL;
+    if (!g_output_stream_write_all(g_scrape_worker.requests, line->str, line->len, NULL, NULL, &error) ||
+        !g_output_stream_flush(g_scrape_worker.requests, NULL, &error)) {
+        fprintf(stderr, "[WARNING]: Failed to send %s job to scraper worker: %s\n",
+                site_key, error ? error->message : "unknown error");
+        g_clear_error(&error);
+        g_hash_table_remove(g_scrape_worker.pending, GUINT_TO_POINTER(id));
+        g_hash_table_remove(g_scrape_worker.scripts, site_key);  // Register again next time
+        g_scrape_worker.active_jobs--;
+        g_cond_broadcast(&g_scrape_worker.cond);
+        g_mutex_unlock(&g_scrape_worker.lock);
+        g_string_free(line, TRUE);
+        if (job.streamed) g_string_free(job.streamed, TRUE);
+        return NULL;
+    }
+    g_string_free(line, TRUE);
+
+    printf("[INFO]: Sent %s job #%u to scraper worker.\n", site_key, id);
+
+    gint64 deadline = g_get_monotonic_time() +
+        (timeout_ms + SCRAPE_JOB_WAIT_SLACK_MS) * 1000;
+    while (!job.done && !search_context_is_cancelled(search)) {
+        // Parse streamed output in this thread, without holding the lock
+        if (job.streamed && job.streamed->len > 0) {
+            GString *chunk = job.streamed;
+            job.streamed = g_string_new(NULL);
+            g_mutex_unlock(&g_scrape_worker.lock);
+            json_record_stream_feed(stream, chunk->str, chunk->len);
+            g_string_free(chunk, TRUE);
+            g_mutex_lock(&g_scrape_worker.lock);
+            continue;
+        }
+        if (!g_cond_wait_until(&g_scrape_worker.cond, &g_scrape_worker.lock, deadline))
+            break;
+    }
 
-    // Try loading CSS data, capture any errors
-    if (!gtk_css_provider_load_from_data(css_provider, css_data, -1, &error)) {
-        // CSS failed to load, print error message
-        fprintf(stderr, "Error loading CSS styles: %s\n", error->message);
-        g_error_free(error);
-        g_object_unref(css_provider);
-        return;
+    if (!job.done) {
+        g_hash_table_remove(g_scrape_worker.pending, GUINT_TO_POINTER(id));
+
+        if (search_context_is_cancelled(search) && g_scrape_worker.requests) {
+            printf("[INFO]: Cancelling %s job #%u.\n", site_key, id);
+            char *cancel_request = g_strdup_printf("{\"op\":\"cancel\",\"id\":%u}\n", id);
+            g_output_stream_write_all(g_scrape_worker.requests, cancel_request, strlen(cancel_request),
+                                      NULL, NULL, NULL);
+            g_output_stream_flush(g_scrape_worker.requests, NULL, NULL);
+            g_free(cancel_request);
+        } else {
+            fprintf(stderr, "[WARNING]: Scraper worker did not answer %s job #%u in time.\n", site_key, id);
+        }
     }
 
-    // Apply CSS globally to default screen
-    GdkScreen *screen = gdk_screen_get_default();
-    if (screen) {
-        gtk_style_context_add_provider_for_screen(
-            screen,
-            GTK_STYLE_PROVIDER(css_provider),
-            GTK_STYLE_PROVIDER_PRIORITY_USER);
-    } else {
-        fprintf(stderr, "Warning: No default screen available to apply CSS styles\n");
+    // Free the browser slot for the next waiting parser
+    g_scrape_worker.active_jobs--;
+    g_cond_broadcast(&g_scrape_worker.cond);
+
+    g_mutex_unlock(&g_scrape_worker.lock);
+
+    // Output that arrived together with the final reply
+    if (job.streamed) {
+        if (job.done) {
+            json_record_stream_feed(stream, job.streamed->str, job.streamed->len);
+        }
+        g_string_free(job.streamed, TRUE);
     }
 
-    g_object_unref(css_provider);
+    if (exit_code) *exit_code = job.exit_code;
+    return job.output;
 }
 
 
-
-// ==================
-// ======================
-// ==================
+// --------------------------------
 
 
 /*
- * show_results populates the GTK listbox with clickable buttons representing
- * filtered recipe results from the matched recipe website links.
- *
- * Displays recipe search results in the GTK listbox widget, applying advanced
- * filtering based on whether the user provided quoted search terms.
- * Filters and displays recipes based on the user's search term, including
- * support for quoted phrases for exact matches and broader "partial" matches.
- * Logic Overview:
- * 1. Clears any existing search results from the listbox.
- * 2. If search_term has quoted phrases:
- *    - Extracts quoted phrases and lowercases them.
- *    - Builds a partial search term by combining phrases and removing stop words.
- *    - Filters recipes:
- *        a) Looser (partial) term tokens appear in the recipe title.
- *        b) Each quoted phrase's keywords are in the recipe title.
- *    - Only recipes passing both checks are included.
- * 3. If no quoted phrases:
- *    - Filters recipes containing all tokens of the search term.
- * 4. For matched recipes:
- *    - Creates RecipeInfo structs and queues them for animated insertion.
- * 5. Animated insertion:
- *    - Inserts one button at a time every 100 ms.
- *    - Yellow buttons for perfect matches.
- *    - Beige buttons for partial matches.
- * 6. Memory safety:
- *    - Frees all temporary RecipeInfo structs and g_strdup strings.
- *
- * Purpose:
- * Improves recall and relevance for quoted queries by broadening searches
- * locally while still highlighting exact matches.
- *
- * Parameters:
- *   listbox: The GTK listbox widget to populate with results.
- *   links: GList of strings containing "title\x1fURL".
- *   search_term: Original user search term (may include quotes).
- *   quote_status: Enum indicating presence of quoted phrases.
+ * STREAMING JSON RECORD NOTES:
  *
- * FUTURE IMPROVEMENTS:
- *   - Add subtle fade effect during removal for smoother visual feedback.
+ * Site scripts print their results as JSON: usually one array of
+ * {"title", "url"} objects, but one object per line (NDJSON) works too.
+ * JsonRecordStream reads that output incrementally:
+ * - Between records it skips whitespace, commas and the brackets of the
+ *   top-level array itself.
+ * - Each record is parsed with json_tokener_parse_ex(), which can be fed
+ *   any number of chunks; json_tokener_get_parse_end() tells where the
+ *   record ended, so the rest of the chunk starts the next record.
+ * - Finished records go to the callback at once and are then released.
+ * The C side therefore never needs a fixed-size buffer for script output,
+ * and a script that prints one record per line has its links added while
+ * it is still running.
  */
 
-/*
-JM NOTES, 8/26/2025:
-AllRecipes.com behavior
-The discrepancy between quoted and unquoted searches is not a bug in your code; it’s the website’s search engine behavior.
-On AllRecipes:
-Unquoted search: the site will return any recipe that contains any of the terms you typed, often with broader matching and ranking.
-Quoted search: the site will try to match the exact phrase, which is much stricter. If a recipe title doesn’t have roasted chicken exactly as a phrase, it may be excluded.
-This explains why your code sees many results for roasted chicken unquoted but only one for "roasted chicken" quoted.
-Effect on this logic:
-Your code is faithfully applying the perfect vs. partial-match rules to whatever data the website returns.
-If the site skews results based on quoted terms, your perfect-match count will naturally be lower.
-Partial-match logic mitigates this a little, because it only requires one token match, which is why your yellow links catch the other recipes.
-Reality check: The site behavior is influencing your “perfect match” count, so the skew is external, not a bug in your app.
-E.g., the AllRecipes.com behavior when doing a recipe search using a browser directly on thier website skews the user experience for quoted searches. 
-Users might be surprised that the quoted search term "roasted chicken" returns zero results while the unquoted search term roasted chicken returns plenty.
-The behavior is site-dependent. AllRecipes is strict with quotes (0 results), while Food Network allows partial matches and returns more.
-This logic's partial-match feature is compensating nicely for sites that return very few results for quoted searches. Users still see relevant recipes highlighted
- in yellow even when the site is restrictive.
-The only “weirdness” comes from how individual food sites handle quoted search terms.
-This code correctly tries to preserve user intent of quoted search terms by giving visual cues of yellow and beige highlighted results.
- */
 
-static void show_results(GtkWidget *listbox_widget, GList *links, const char *search_term, QuoteStatus quote_status) {
+// Creates an incremental JSON record reader that calls on_record for each
+// complete record.
+
+static JsonRecordStream *json_record_stream_new(JsonRecordFunc on_record, gpointer user_data) {
+    JsonRecordStream *stream = g_new0(JsonRecordStream, 1);
+    stream->tok = json_tokener_new();
+    stream->on_record = on_record;
+    stream->user_data = user_data;
+    return stream;
+}
+
+
+// --------------------------------
+
+
+// Frees a record reader (a partial record is discarded).
+
+static void json_record_stream_free(JsonRecordStream *stream) {
+    if (!stream) return;
+    json_tokener_free(stream->tok);
+    g_free(stream);
+}
+
+
+// --------------------------------
+
+
+// Feeds len bytes of output to the reader. Every record completed by these
+// bytes is delivered before the function returns. After a syntax error the
+// rest of the output is ignored (records already delivered stay valid).
+
+static void json_record_stream_feed(JsonRecordStream *stream, const char *data, size_t len) {
+    stream->bytes_fed += len;
+
+    size_t pos = 0;
+    while (pos < len && !stream->failed) {
+        if (!stream->in_record) {
+            char c = data[pos];
+            if (g_ascii_isspace(c) || c == ',') {
+                pos++;
+                continue;
+            }
+            if (c == '[' && !stream->in_array) {
+                stream->in_array = TRUE;
+                pos++;
+                continue;
+            }
+            if (c == ']' && stream->in_array) {
+                stream->in_array = FALSE;
+                pos++;
+                continue;
+            }
+            stream->in_record = TRUE;  // This byte starts a record
+        }
+
+        size_t chunk = MIN(len - pos, (size_t)INT_MAX);
+        struct json_object *record = json_tokener_parse_ex(stream->tok, data + pos, (int)chunk);
+        enum json_tokener_error error = json_tokener_get_error(stream->tok);
+
+        if (error == json_tokener_continue) {
+            pos += chunk;  // Whole chunk consumed; the record continues
+            continue;
+        }
 
-    printf("\n[INFO]: Entering show_results() function\n");
-    printf("[INFO]: Input search_term:\n%s\n", search_term);
+        if (error != json_tokener_success) {
+            fprintf(stderr, "[WARNING]: Invalid JSON in script output after %u records: %s\n",
+                    stream->records, json_tokener_error_desc(error));
+            stream->failed = TRUE;
+            break;
+        }
 
-    GtkListBox *listbox = GTK_LIST_BOX(listbox_widget);
+        pos += json_tokener_get_parse_end(stream->tok);
+        json_tokener_reset(stream->tok);
+        stream->in_record = FALSE;
+        stream->records++;
 
-    // Step 1: Refresh UI
-    gtk_widget_queue_draw(GTK_WIDGET(listbox));
-    while (gtk_events_pending())
-        gtk_main_iteration();
+        stream->on_record(record, stream->user_data);
+        json_object_put(record);
+    }
+}
 
-    // Step 2: Clear existing listbox children
-    GList *children = gtk_container_get_children(GTK_CONTAINER(listbox));
-    for (GList *iter = children; iter; iter = iter->next)
-        gtk_widget_destroy(GTK_WIDGET(iter->data));
-    g_list_free(children);
 
-    // Step 3: Handle quoted search logic
-    GList *quoted_phrases = NULL;
-    char *partial_search_term = NULL;
+// --------------------------------
 
-    if (quote_status == QUOTE_PAIR) {
-        quoted_phrases = extract_quoted_phrases(search_term);
-
-        if (quoted_phrases) {
-            printf("[INFO]: Extracted quoted phrases:\n");
-            for (GList *iter = quoted_phrases; iter; iter = iter->next)
-                printf("%s \n", (char *)iter->data);
-
-            // Build combined string of phrases
-            GString *combined = g_string_new("");
-            for (GList *iter = quoted_phrases; iter; iter = iter->next) {
-                if (combined->len > 0) g_string_append_c(combined, ' ');
-                g_string_append(combined, (char *)iter->data);
-            }
 
-            // Tokenize and filter stop words
-            GList *partial_tokens = tokenize_and_filter_stop_words(combined->str);
-            g_string_free(combined, TRUE);
+// Ends the output. Returns FALSE if it had a syntax error or stopped in the
+// middle of a record.
 
-            if (partial_tokens) {
-                GString *builder = g_string_new("");
-                for (GList *iter = partial_tokens; iter; iter = iter->next) {
-                    if (builder->len > 0) g_string_append_c(builder, ' ');
-                    g_string_append(builder, (char *)iter->data);
-                }
-                partial_search_term = g_string_free(builder, FALSE);
-                g_list_free_full(partial_tokens, g_free);
-            }
-        }
+static gboolean json_record_stream_finish(JsonRecordStream *stream) {
+    if (stream->in_record && !stream->failed) {
+        fprintf(stderr, "[WARNING]: Script output ended in the middle of a JSON record.\n");
+        stream->failed = TRUE;
     }
+    return !stream->failed;
+}
 
-    // Display which search term is actually used
-    if (quote_status == QUOTE_PAIR && partial_search_term)
-        printf("[INFO]: Using decisive search term (partial_search_term):\n%s\n\n", partial_search_term);
-    else
-        printf("[INFO]: Using decisive search term (raw search_term):\n%s\n\n", search_term);
 
-    // Step 4: Prepare queue of matching recipes
-    GQueue *recipe_queue = g_queue_new();
+// --------------------------------
 
-    for (GList *l = links; l; l = l->next) {
-        char *entry = l->data;
-        char *sep = strchr(entry, '\x1f');
-        if (!sep) continue;
 
-        *sep = '\0';
-        char *title = entry;
-        char *url = sep + 1;
+// TRUE if a script marked a record as its fallback link ("fallback": true),
+// i.e. the search page it prints when it found no recipes.
 
-        char *lower_title = g_ascii_strdown(title, -1);
-        gboolean perfect_match = FALSE;
-        gboolean partial_match = FALSE;
-        int total_tokens = 0;
-        int matched_tokens = 0;
+static gboolean json_record_is_fallback(struct json_object *record) {
+    struct json_object *flag = NULL;
+    return json_object_object_get_ex(record, "fallback", &flag) && json_object_get_boolean(flag);
+}
 
-        // Match logic for quoted search
-        if (quote_status == QUOTE_PAIR && quoted_phrases && partial_search_term) {
-            GList *tokens = tokenize_and_filter_stop_words(partial_search_term);
-            if (tokens) {
-                total_tokens = g_list_length(tokens);
-                for (GList *ti = tokens; ti; ti = ti->next) {
-                    if (strstr(lower_title, (char *)ti->data))
-                        matched_tokens++;
-                }
-                g_list_free_full(tokens, g_free);
 
-                if (matched_tokens == total_tokens)
-                    perfect_match = TRUE;
-                else if (matched_tokens > 0)
-                    partial_match = TRUE;
-            }
-        }
+// --------------------------------
 
-        g_free(lower_title);
 
-        // Skip non-matching recipe if quote filter is active
-        if (quote_status == QUOTE_PAIR && !perfect_match && !partial_match)
-            continue;
+// Shared record callback of the JavaScript parsers: adds a
+// {"title": ..., "url": ...} record with add_link(), or with
+// add_fallback_link() if the script marked it "fallback": true. Records
+// without both fields are counted but otherwise ignored.
 
-        // Add matching recipe to queue
-        RecipeInfo *ri = g_new0(RecipeInfo, 1);
-        ri->title = g_strdup(title);
-        ri->url = g_strdup(url);
-        ri->perfect_match = perfect_match;
-        ri->partial_match = partial_match;
-        ri->matched_tokens = matched_tokens;
-        ri->total_tokens = total_tokens;
+static void site_record_add_link(struct json_object *record, gpointer user_data) {
+    SiteRecordContext *ctx = user_data;
+    struct json_object *title_obj = NULL, *url_obj = NULL;
 
-        g_queue_push_tail(recipe_queue, ri);
+    ctx->records++;
+
+    if (!json_object_is_type(record, json_type_object) ||
+        !json_object_object_get_ex(record, "title", &title_obj) ||
+        !json_object_object_get_ex(record, "url", &url_obj)) {
+        return;
     }
 
-    // Cleanup
-    if (quoted_phrases) g_list_free_full(quoted_phrases, g_free);
-    if (partial_search_term) g_free(partial_search_term);
+    const char *title = json_object_get_string(title_obj);
+    const char *url = json_object_get_string(url_obj);
+    if (!title || !url) return;
 
-    // Step 5: Animate recipe insertion
-    InsertAnimationData *anim_data = g_new0(InsertAnimationData, 1);
-    anim_data->listbox = listbox;
-    anim_data->recipe_queue = recipe_queue;
-    anim_data->partial_buttons = g_queue_new();
+    if (json_record_is_fallback(record)) {
+        add_fallback_link(ctx->out, title, url, ctx->search);
+    } else if (ctx->split_title_digits) {
+        char *fixed_title = split_title_and_digits(title);
+        add_link(ctx->out, fixed_title ? fixed_title : title, ctx->base_url, url, ctx->search);
+        free(fixed_title);
+    } else {
+        add_link(ctx->out, title, ctx->base_url, url, ctx->search);
+    }
+}
 
-    g_timeout_add(100, insert_next_button, anim_data);
 
-}
+// ==========================================================================
+// ==========================================================================
 
 
-// ==================
+// ==========================================================================
+//  ***  NATIVE HTML EXTRACTION (CSS SELECTORS OVER GUMBO)  ***
+// ==========================================================================
 
+/*
+NOTES ON NATIVE HTML EXTRACTION:
+
+Some site scripts were nothing but an axios GET plus a few cheerio
+selectors: no JavaScript runs on those pages, yet every search paid for a
+Node.js job and needed the axios/cheerio npm packages. Such sites are now
+SITE_NEEDS_PREFETCHED_DOM parsers: run_site_parser() downloads the search
+page through the shared HTTP engine and parses it with Gumbo, and the
+parser walks the tree with the same selectors the script used.
+
+Supported selector subset (enough for these scrapers, deliberately small):
+  - type selectors (a, h2, article) and the universal selector *
+  - .class (whitespace-separated class list match)
+  - #id
+  - [attr], [attr=value], [attr*=value], [attr^=value], [attr$=value]
+    (value unquoted or quoted)
+  - :not() around one attribute test, e.g. a:not([href*="/video/"])
+  - descendant combinator (whitespace)
+Child/sibling combinators, selector lists (",") and other pseudo-classes
+are rejected by css_selector_new() with a warning.
+
+Matching runs right to left: an element must match the last compound, then
+each earlier compound is looked for among its ancestors, nearest first.
+With descendant combinators only, taking the nearest matching ancestor
+never misses a match.
+
+Many pages that render their result cards in the browser still describe
+the results in a JSON-LD block (<script type="application/ld+json">),
+usually an ItemList for search pages or Recipe objects, possibly inside an
+"@graph" array. html_extract_json_ld_links() reads those with json-c.
+Next.js sites instead ship the server-side page state as JSON in
+<script id="__NEXT_DATA__">; html_extract_next_data_links() walks its
+props.pageProps for objects with a title and a link, keeping the links that
+look like the site's recipe URLs (SiteEscalation.url_match). Together they
+are the second tier of run_site_escalation(), after the CSS selector: one
+GET and a linear scan instead of a scroll-and-wait browser session.
+*/
 
-// Helper: Insert one recipe link button at a time into the GTK listbox UI
-// Applies CSS styling according to the search type:
-//   - Default links: standard white/black button
-//   - Partial matches: beige background button
-//   - Perfect matches: yellow background button with blue glowing border
-// Delayed appearance ensures buttons are fully realized in the UI before
-//   any further styling is applied.
-// The "visible" class triggers a minor delayed appearance after the
-//    buttons are realized.
-
-static gboolean insert_next_button(gpointer user_data) {
-    InsertAnimationData *data = (InsertAnimationData *)user_data;
-
-    // Stop if there are no more recipes
-    if (g_queue_is_empty(data->recipe_queue)) {
-        g_queue_free(data->partial_buttons);
-        g_free(data);
-        return FALSE;
+
+// Frees one compiled compound selector (GDestroyNotify for CssSelector.steps).
+
+static void css_compound_free(gpointer data) {
+    CssCompound *compound = data;
+    if (!compound) return;
+
+    for (guint i = 0; i < compound->attrs->len; ++i) {
+        CssAttrTest *test = &g_array_index(compound->attrs, CssAttrTest, i);
+        g_free(test->name);
+        g_free(test->value);
     }
+    g_array_free(compound->attrs, TRUE);
+    g_ptr_array_free(compound->classes, TRUE);
+    g_free(compound->tag_name);
+    g_free(compound);
+}
 
-    // Pop the next recipe link from the queue into the UI
-    RecipeInfo *ri = g_queue_pop_head(data->recipe_queue);
 
-    // Create a button with the recipe title
-    GtkWidget *btn = gtk_button_new_with_label(ri->title);
+// --------------------------------
 
-    // Store URL safely in the button object; freed when button is destroyed
-    g_object_set_data_full(G_OBJECT(btn), "url", g_strdup(ri->url), g_free);
 
-    // Connect click signal to open recipe
-    g_signal_connect(btn, "clicked", G_CALLBACK(on_recipe_clicked), NULL);
+// Reads a CSS identifier (letters, digits, '-', '_') at *p and advances.
+// Returns NULL if there is none.
 
-    // Apply CSS style class based on match type
-    GtkStyleContext *ctx = gtk_widget_get_style_context(btn);
-    if (ri->perfect_match) {
-        gtk_style_context_add_class(ctx, "recipe-perfect");
-        // Schedule "visible" class to ensure button is realized before appearance
-        g_idle_add((GSourceFunc)add_visible_class, btn);
-        printf("[INFO] INSERTING PERFECT MATCH (YELLOW): %s (%d/%d tokens)\n",
-               ri->title, ri->matched_tokens, ri->total_tokens);
-    } else if (ri->partial_match) {
-        gtk_style_context_add_class(ctx, "recipe-partial");
-        printf("[INFO] INSERTING PARTIAL MATCH (BEIGE): %s (%d/%d tokens)\n",
-               ri->title, ri->matched_tokens, ri->total_tokens);
-    } else {
-        gtk_style_context_add_class(ctx, "recipe-button");
-        printf("[INFO] INSERTING RECIPE LINK: %s\n", ri->title);
-    }
+static char *css_read_ident(const char **p) {
+    const char *start = *p;
+    while (g_ascii_isalnum(**p) || **p == '-' || **p == '_') (*p)++;
+    return *p > start ? g_strndup(start, *p - start) : NULL;
+}
+
+
+// --------------------------------
 
-    // Insert button into listbox and show it
-    gtk_list_box_insert(data->listbox, btn, -1);
-    gtk_widget_show_all(GTK_WIDGET(data->listbox));
 
-    // Free temporary recipe info
-    g_free(ri->title);
-    g_free(ri->url);
-    g_free(ri);
+// Reads an attribute test ("[attr]", "[attr*=value]", ...) at *p into
+// *test and advances past the ']'. Returns FALSE, with nothing to free in
+// *test, if it is malformed.
+
+static gboolean css_read_attr_test(const char **p, CssAttrTest *test) {
+    const char *q = *p;
+    if (*q != '[') return FALSE;
+    q++;
+    while (*q == ' ') q++;
+    char *name = css_read_ident(&q);
+    while (*q == ' ') q++;
+    if (!name) return FALSE;
+
+    *test = (CssAttrTest){ g_ascii_strdown(name, -1), NULL, CSS_ATTR_EXISTS, FALSE };
+    g_free(name);
+    if (*q == '=' || (*q && strchr("*^$", *q) && q[1] == '=')) {
+        test->op = *q == '=' ? CSS_ATTR_EQUALS :
+                   *q == '*' ? CSS_ATTR_CONTAINS :
+                   *q == '^' ? CSS_ATTR_PREFIX : CSS_ATTR_SUFFIX;
+        q += test->op == CSS_ATTR_EQUALS ? 1 : 2;
+        while (*q == ' ') q++;
+        if (*q == '"' || *q == '\'') {
+            const char *end = strchr(q + 1, *q);
+            if (end) {
+                test->value = g_strndup(q + 1, end - q - 1);
+                q = end + 1;
+            }
+        } else {
+            test->value = css_read_ident(&q);
+        }
+        while (*q == ' ') q++;
+    }
 
+    if (*q != ']' || (test->op != CSS_ATTR_EXISTS && !test->value)) {
+        g_free(test->name);
+        g_free(test->value);
+        return FALSE;
+    }
+    *p = q + 1;
     return TRUE;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Helper: Add the "visible" class to a widget once.
-// Runs on the next GTK idle cycle to ensure the widget is realized.
+// Compiles a selector of the supported subset (see the NOTES above).
+// Returns NULL, with a warning naming the selector, on anything else.
 
-static gboolean add_visible_class(gpointer widget) {
-    if (!widget) {
-        printf("[WARNING]: the add_visible_class function was called with a NULL widget pointer\n");
-        return FALSE; // stop callback if widget is invalid
-    }
+static CssSelector *css_selector_new(const char *selector) {
+    CssSelector *compiled = g_new0(CssSelector, 1);
+    compiled->steps = g_ptr_array_new_with_free_func(css_compound_free);
 
-    GtkStyleContext *ctx = gtk_widget_get_style_context(GTK_WIDGET(widget));
-    gtk_style_context_add_class(ctx, "visible");
+    const char *p = selector;
+    while (*p) {
+        while (g_ascii_isspace(*p)) p++;
+        if (!*p) break;
 
-    printf("[*** INFO]: Added 'visible' class to widget %p\n", widget);
+        CssCompound *compound = g_new0(CssCompound, 1);
+        compound->tag = GUMBO_TAG_UNKNOWN;
+        compound->classes = g_ptr_array_new_with_free_func(g_free);
+        compound->attrs = g_array_new(FALSE, FALSE, sizeof(CssAttrTest));
+        g_ptr_array_add(compiled->steps, compound);
 
-    return FALSE; // run once
-}
+        // Type selector (optional)
+        if (*p == '*') {
+            p++;
+        } else if (g_ascii_isalpha(*p)) {
+            char *name = css_read_ident(&p);
+            compound->tag_name = g_ascii_strdown(name, -1);
+            compound->tag = gumbo_tag_enum(compound->tag_name);
+            g_free(name);
+        }
 
+        // Classes, id and attribute tests
+        gboolean ok = TRUE;
+        while (ok && *p && !g_ascii_isspace(*p)) {
+            if (*p == '.' || *p == '#') {
+                gboolean is_class = *p == '.';
+                p++;
+                char *ident = css_read_ident(&p);
+                if (!ident) { ok = FALSE; break; }
+                if (is_class) {
+                    g_ptr_array_add(compound->classes, ident);
+                } else {
+                    CssAttrTest test = { g_strdup("id"), ident, CSS_ATTR_EQUALS, FALSE };
+                    g_array_append_val(compound->attrs, test);
+                }
+            } else if (*p == '[' || g_str_has_prefix(p, ":not([")) {
+                gboolean negate = *p == ':';
+                if (negate) p += strlen(":not(");
+
+                CssAttrTest test;
+                if (!css_read_attr_test(&p, &test)) { ok = FALSE; break; }
+                test.negate = negate;
+                g_array_append_val(compound->attrs, test);  // Freed with the compound
+                if (negate && *p++ != ')') { ok = FALSE; break; }
+            } else {
+                ok = FALSE;  // Combinators other than descendant, lists, other pseudo-classes
+            }
+        }
 
-// ==================
-// ==================
-// ==================
+        if (!ok) {
+            fprintf(stderr, "[WARNING]: Unsupported CSS selector: %s\n", selector);
+            css_selector_free(compiled);
+            return NULL;
+        }
+    }
 
+    if (compiled->steps->len == 0) {
+        css_selector_free(compiled);
+        return NULL;
+    }
+    return compiled;
+}
 
 
-// Thread entry point -- search logic only (no UI)
-// This function runs in a separate thread to:
-//  - Read a recipe search query from a UI input.
-//  - Construct a URL for the selected recipe site.
-//  - Download and parse the HTML results.
-//  - Extract and store recipe data.
-//  - Schedule a callback (search_complete_cb) to update the UI with
-//     the results.
-//  It is designed to be non-blocking, thread-safe, and modular:
-//    each site can have its own parser logic via parse_site.
+// --------------------------------
 
-static gpointer search_thread_func(gpointer data) {
 
-    // Reset recipe limit counter
-    recipe_result_total = 0; // reset before starting a new search
+// Frees a compiled selector (NULL is ignored).
 
-    AppWidgets *w = data;
-    SearchResultData *result = g_new0(SearchResultData, 1);
-    result->w = w;
-    result->success = FALSE;
+static void css_selector_free(CssSelector *selector) {
+    if (!selector) return;
+    g_ptr_array_free(selector->steps, TRUE);
+    g_free(selector);
+}
 
-    // Prep
-    const char *q = gtk_entry_get_text(GTK_ENTRY(w->entry));
 
-//    printf("\n[DEBUG]: Function search_thread_func received this input:\n%s\n\n", q);
+// --------------------------------
 
-    if (!q || !*q) {
-        result->status_message = g_strdup("      Please enter a recipe search term (like roast chicken, or chili)");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
-    }
 
-    int index = gtk_combo_box_get_active(GTK_COMBO_BOX(w->combo));
-    if (index < 0 || index >= (int)(sizeof(g_recipe_site_table) / sizeof(g_recipe_site_table[0]))) {
-        result->status_message = g_strdup("Please select a valid recipe site.");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
+// TRUE if the element's whitespace-separated class list contains 'name'.
+
+static gboolean css_has_class(const char *class_list, const char *name) {
+    size_t len = strlen(name);
+    for (const char *p = class_list; *p; ) {
+        while (*p && g_ascii_isspace(*p)) p++;
+        const char *start = p;
+        while (*p && !g_ascii_isspace(*p)) p++;
+        if ((size_t)(p - start) == len && memcmp(start, name, len) == 0)
+            return TRUE;
     }
+    return FALSE;
+}
 
-    const RecipeSiteInfo *site = &g_recipe_site_table[index];
-    g_free(g_current_website_name);
-    g_current_website_name = g_strdup(site->name);
 
-    char *enc = g_uri_escape_string(q, NULL, FALSE);
-    if (!enc) {
-        result->status_message = g_strdup("Failed to encode search term.");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
-    }
+// --------------------------------
 
-    result->url = g_strdup_printf(site->url_pattern, enc);
-    g_free(enc);
 
-    if (!result->url) {
-        result->status_message = g_strdup("Failed to build URL.");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
-    }
+// TRUE if one element matches one compound selector.
 
-    result->html = download_html(result->url);
-    if (!result->html) {
-        result->status_message = g_strdup("Failed to fetch recipes.");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
-    }
+static gboolean css_compound_matches(const CssCompound *compound, const GumboNode *node) {
+    if (node->type != GUMBO_NODE_ELEMENT && node->type != GUMBO_NODE_TEMPLATE)
+        return FALSE;
+    const GumboElement *element = &node->v.element;
 
-    result->output = gumbo_parse(result->html);
-    if (!result->output) {
-        result->status_message = g_strdup("Failed to parse HTML from site.");
-        g_idle_add(search_complete_cb, result);
-        return NULL;
+    if (compound->tag_name) {
+        if (compound->tag != GUMBO_TAG_UNKNOWN) {
+            if (element->tag != compound->tag) return FALSE;
+        } else {
+            // Custom elements: compare the tag name as written
+            GumboStringPiece name = element->original_tag;
+            gumbo_tag_from_original_text(&name);
+            if (element->tag != GUMBO_TAG_UNKNOWN || name.length != strlen(compound->tag_name) ||
+                g_ascii_strncasecmp(name.data, compound->tag_name, name.length) != 0) {
+                return FALSE;
+            }
+        }
     }
 
-    GHashTable *link_set = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
-    if (site->parse_site) {
-        site->parse_site(result->output->root, &result->results, link_set, q);
-        result->success = TRUE;
+    if (compound->classes->len > 0) {
+        GumboAttribute *class_attr = gumbo_get_attribute(&element->attributes, "class");
+        if (!class_attr) return FALSE;
+        for (guint i = 0; i < compound->classes->len; ++i) {
+            if (!css_has_class(class_attr->value, g_ptr_array_index(compound->classes, i)))
+                return FALSE;
+        }
     }
 
-    g_hash_table_destroy(link_set);
-    g_idle_add(search_complete_cb, result);
-    return NULL;
+    for (guint i = 0; i < compound->attrs->len; ++i) {
+        const CssAttrTest *test = &g_array_index(compound->attrs, CssAttrTest, i);
+        GumboAttribute *attr = gumbo_get_attribute(&element->attributes, test->name);
+        gboolean passes = attr != NULL;
+        if (passes && test->op == CSS_ATTR_EQUALS) passes = strcmp(attr->value, test->value) == 0;
+        if (passes && test->op == CSS_ATTR_CONTAINS) passes = strstr(attr->value, test->value) != NULL;
+        if (passes && test->op == CSS_ATTR_PREFIX) passes = g_str_has_prefix(attr->value, test->value);
+        if (passes && test->op == CSS_ATTR_SUFFIX) passes = g_str_has_suffix(attr->value, test->value);
+        if (passes == test->negate) return FALSE;
+    }
 
+    return TRUE;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Finalizes the UI after the background recipe search completes.
-// Stops the pulsing progress bar animation, restores UI interactivity,
-// and displays either the search results or an appropriate fallback message.
-// Runs in the GTK main thread via g_idle_add().
+// TRUE if an element matches a compiled selector: it matches the last
+// compound, and the earlier ones match some chain of its ancestors.
 
-static gboolean search_complete_cb(gpointer data) {
+static gboolean css_selector_matches(const CssSelector *selector, const GumboNode *node) {
+    guint step = selector->steps->len - 1;
+    if (!css_compound_matches(g_ptr_array_index(selector->steps, step), node))
+        return FALSE;
 
-    SearchResultData *result = data;
+    for (const GumboNode *ancestor = node->parent; step > 0 && ancestor; ancestor = ancestor->parent) {
+        if (css_compound_matches(g_ptr_array_index(selector->steps, step - 1), ancestor))
+            step--;
+    }
+    return step == 0;
+}
 
-// JM: Display function info in the terminal. Uses a  ternary operator
-//         as a conditional expression rather than a full if statement.
-//         This avoids calling g_list_length on a NULL pointer.
-printf(
-    "\n[INFO]: Function search_complete_cb() was called.\n"
-    "        callback success flag = %d\n"
-    "        memory address of GList containing recipe links: %p\n"
-    "        number of recipe links in GList: %d\n\n",
-    result->success,
-    result->results,
-    result->results ? g_list_length(result->results) : 0
-);
-fflush(stdout);
 
+// --------------------------------
 
-    AppWidgets *w = result->w;
 
-    // STOP the progress bar timer first
-    if (w->pulse_timer_id != 0) {
-        g_source_remove(w->pulse_timer_id);
-        w->pulse_timer_id = 0;
-    }
+// Walks the elements below 'scope' in document order (depth first, with an
+// explicit stack so deeply nested pages cannot overflow the thread stack)
+// and appends the ones matching the selector to 'matches'. With
+// 'first_only', stops at the first match.
 
-    // Hide progress bar and re-enable UI
-    // Restores the busy/wait cursor to the normal arrow
-    gtk_widget_hide(w->progress_bar);
-    set_cursor(gtk_widget_get_toplevel(w->search_button), GDK_LEFT_PTR);
-    set_ui_enabled(w, TRUE);
+static void css_select_walk(GumboNode *scope, const CssSelector *selector, GPtrArray *matches, gboolean first_only) {
+    GPtrArray *stack = g_ptr_array_new();
+    g_ptr_array_add(stack, scope);
 
-    // Clear previous results before showing new ones
-    clear_recipe_results(w->listbox);
+    while (stack->len > 0) {
+        GumboNode *node = g_ptr_array_remove_index(stack, stack->len - 1);
+        if (node != scope && css_selector_matches(selector, node)) {
+            g_ptr_array_add(matches, node);
+            if (first_only) break;
+        }
 
-    // Show results or fallback
-    if (result->success && result->results) {
-        const char *q = gtk_entry_get_text(GTK_ENTRY(w->entry));
-        show_results(w->listbox, result->results, q, w->quote_status);
-        gtk_label_set_text(GTK_LABEL(w->status_label), "");
-    } else if (result->url && !result->results) {
-        insert_fallback_link(w->listbox, result->url, "Matching recipes not found. Click to open the main food website.");
-        gtk_label_set_text(GTK_LABEL(w->status_label), "");
-    } else {
-        gtk_label_set_text(GTK_LABEL(w->status_label),
-                           result->status_message ? result->status_message : "Search failed.");
+        const GumboVector *children = NULL;
+        if (node->type == GUMBO_NODE_ELEMENT || node->type == GUMBO_NODE_TEMPLATE) {
+            children = &node->v.element.children;
+        } else if (node->type == GUMBO_NODE_DOCUMENT) {
+            children = &node->v.document.children;
+        }
+        for (guint i = children ? children->length : 0; i > 0; --i) {
+            GumboNode *child = children->data[i - 1];
+            if (child->type == GUMBO_NODE_ELEMENT || child->type == GUMBO_NODE_TEMPLATE) {
+                g_ptr_array_add(stack, child);
+            }
+        }
     }
 
-    // Clean up
-    gumbo_destroy_output(&kGumboDefaultOptions, result->output);
-    g_list_free_full(result->results, g_free);
-    g_free(result->html);
-    g_free(result->url);
-    g_free(result->status_message);
-    g_free(result);
-
-    return G_SOURCE_REMOVE;
+    g_ptr_array_free(stack, TRUE);
 }
 
 
-
-// ==================
+// --------------------------------
 
 
+// Appends the elements below 'scope' that match the selector to 'matches'
+// (document order, like cheerio's $(scope).find(selector)).
 
-// Callback for GTK timer
-// Pulses the progress bar widget inside AppWidgets every 100ms.  The
-// 100 ms interval comes from the timer set up with g_timeout_add(100, ...)
-// Keeps the progress bar animation running while a background task is
-// in progress.
-// Returns G_SOURCE_CONTINUE to keep the timer active.
-static gboolean pulse_progress_bar(gpointer data) {
-    AppWidgets *w = data;
-    gtk_progress_bar_pulse(GTK_PROGRESS_BAR(w->progress_bar));
-    return G_SOURCE_CONTINUE; // Keep the timeout running
+static void css_select(GumboNode *scope, const CssSelector *selector, GPtrArray *matches) {
+    if (scope && selector) css_select_walk(scope, selector, matches, FALSE);
 }
 
 
+// --------------------------------
 
 
-// ==================
-// ==================
-// ==================
+// First element below 'scope' that matches the selector, or NULL.
 
+static GumboNode *css_select_first(GumboNode *scope, const CssSelector *selector) {
+    if (!scope || !selector) return NULL;
 
+    GPtrArray *matches = g_ptr_array_new();
+    css_select_walk(scope, selector, matches, TRUE);
+    GumboNode *first = matches->len > 0 ? g_ptr_array_index(matches, 0) : NULL;
+    g_ptr_array_free(matches, TRUE);
+    return first;
+}
 
-// Search for matching recipes!
-// Initial immediate search button handler -- sets up UI and defers real work
 
-static void initialize_on_search(GtkButton *btn G_GNUC_UNUSED, gpointer ud) {
-    AppWidgets *w = ud;
+// --------------------------------
 
-    // Ensure there is a search term to use
-    const char *q = gtk_entry_get_text(GTK_ENTRY(w->entry));
-    if (!q || !*q) {
-    // Don't proceed with empty input
-        gtk_label_set_text(GTK_LABEL(w->status_label),
-            "      Please enter a recipe search term (like:  roast chicken, or chili, or Peking Duck)");
-        printf("\n\n=========================================================\n");
-        printf("\nUSER SEARCH TERM WAS EMPTY!\n");
-        return;
-    }
 
-    printf("\n\n=========================================================\n");
-    printf("    <<<   N E W     R E C I P E     S E A R C H   >>>\n");
-    printf("=========================================================\n");
-    printf("\nUSER SEARCH TERM:\n%s\n", q);
-    printf("\n------------------------------------------------\n");
+// Text content of a node (like cheerio's .text()), with runs of whitespace
+// collapsed to one space and the ends trimmed. Caller must g_free.
 
-    // Detect quote status and store it in the widgets struct for later use
-    QuoteStatus quote_status = detect_quote_status(q);
-    w->quote_status = quote_status;
+static char *html_node_text(const GumboNode *node) {
+    GString *text = g_string_new(NULL);
+    GPtrArray *stack = g_ptr_array_new();
+    g_ptr_array_add(stack, (gpointer)node);
 
-    // Prepare user-facing status message based on quote usage
-    const char *status_msg = NULL;
-    switch (quote_status) {
-        case QUOTE_PAIR:
-            status_msg = "    Quoted searches behave differently on each website!  Searching, please wait …";
-            break;
-        case QUOTE_SINGLE:
-            status_msg = "   Searching for recipes (Note: Please check your unmatched quote marks) ...";
-            break;
-        case QUOTE_NONE:
-        default:
-            status_msg = "   Searching for matching recipes. Please wait ...";
-            break;
+    while (stack->len > 0) {
+        const GumboNode *current = g_ptr_array_remove_index(stack, stack->len - 1);
+        if (current->type == GUMBO_NODE_TEXT || current->type == GUMBO_NODE_WHITESPACE ||
+            current->type == GUMBO_NODE_CDATA) {
+            for (const char *p = current->v.text.text; *p; ++p) {
+                if (g_ascii_isspace(*p)) {
+                    if (text->len > 0 && text->str[text->len - 1] != ' ')
+                        g_string_append_c(text, ' ');
+                } else {
+                    g_string_append_c(text, *p);
+                }
+            }
+        } else if (current->type == GUMBO_NODE_ELEMENT || current->type == GUMBO_NODE_TEMPLATE) {
+            const GumboVector *children = &current->v.element.children;
+            for (guint i = children->length; i > 0; --i) {
+                g_ptr_array_add(stack, children->data[i - 1]);
+            }
+        }
     }
 
-    // Set busy cursor
-    GtkWidget *toplevel = gtk_widget_get_toplevel(w->search_button);
-    set_cursor(toplevel, GDK_WATCH);
+    g_ptr_array_free(stack, TRUE);
+    if (text->len > 0 && text->str[text->len - 1] == ' ')
+        g_string_truncate(text, text->len - 1);
+    return g_string_free(text, FALSE);
+}
 
-    // Disable all UI during search
-    set_ui_enabled(w, FALSE);
 
-    // Clear any previous results
-    clear_recipe_results(w->listbox);
+// --------------------------------
 
-    // Show status and progress bar
-    gtk_label_set_text(GTK_LABEL(w->status_label), status_msg);
-    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(w->progress_bar), 0.0);
-    gtk_widget_show(w->progress_bar);
 
-    // Process GTK events before launching the thread
-    while (gtk_events_pending())
-        gtk_main_iteration_do(FALSE);
+// TRUE if url_match is NULL or appears in the link as the browser would
+// resolve it (relative links get base_url), so that a match on the site's
+// domain also holds for relative hrefs.
 
-    // Start pulsing progress bar
-    w->pulse_timer_id = g_timeout_add(100, (GSourceFunc)pulse_progress_bar, w);
+static gboolean html_link_matches(const char *base_url, const char *url, const char *url_match) {
+    if (!url_match) return TRUE;
 
-    // launch search thread
-    g_thread_new("recipe_search_thread", search_thread_func, w);
+    gboolean absolute = g_str_has_prefix(url, "http://") || g_str_has_prefix(url, "https://");
+    if (absolute || !base_url || !*base_url) return strstr(url, url_match) != NULL;
 
+    char *resolved = g_strconcat(base_url, url, NULL);
+    gboolean matches = strstr(resolved, url_match) != NULL;
+    g_free(resolved);
+    return matches;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Helper: Set busy or normal cursor on the toplevel window
-static void set_cursor(GtkWidget *widget, GdkCursorType cursor_type) {
-    GdkDisplay *display = gdk_display_get_default();
-    GdkCursor *cursor = (cursor_type != GDK_BLANK_CURSOR)
-        ? gdk_cursor_new_for_display(display, cursor_type)
-        : NULL;
-    GdkWindow *window = gtk_widget_get_window(widget);
-    if (window)
-        gdk_window_set_cursor(window, cursor);
-    if (cursor)
-        g_object_unref(cursor);
+// Native version of the common cheerio scraper loop:
+//     $(item_selector).each(... $(elem).find(link_selector) ...)
+// For every element matching item_selector, the first link_selector match
+// inside it gives the title (its text) and the URL (its href; relative
+// links get base_url). With a NULL link_selector the items are the links.
+// Links that do not contain url_match (NULL: any) are skipped, and nothing
+// is added unless at least min_links items gave a link: a page where the
+// selector only hits a stray anchor or two is not a results page.
+// Returns the number of links handed to add_link().
+
+static guint html_scrape_links(GumboNode *root, const char *item_selector, const char *link_selector,
+                               const char *base_url, const char *url_match, guint min_links,
+                               GList **out, SearchContext *search) {
+    CssSelector *items_sel = css_selector_new(item_selector);
+    CssSelector *link_sel = link_selector ? css_selector_new(link_selector) : NULL;
+    guint found = 0;
+
+    if (root && items_sel && (link_sel || !link_selector)) {
+        GPtrArray *items = g_ptr_array_new();
+        css_select(root, items_sel, items);
+
+        // Collect first, so a page under min_links adds nothing
+        GPtrArray *titles = g_ptr_array_new_with_free_func(g_free);
+        GPtrArray *hrefs = g_ptr_array_new();  // Point into the Gumbo tree
+        for (guint i = 0; i < items->len && !search_context_is_cancelled(search); ++i) {
+            GumboNode *item = g_ptr_array_index(items, i);
+            GumboNode *link = link_sel ? css_select_first(item, link_sel) : item;
+            GumboAttribute *href = link ? gumbo_get_attribute(&link->v.element.attributes, "href") : NULL;
+            if (!href || !*href->value || !html_link_matches(base_url, href->value, url_match)) continue;
+
+            char *title = html_node_text(link);
+            if (*title) {
+                g_ptr_array_add(titles, title);
+                g_ptr_array_add(hrefs, (gpointer)href->value);
+            } else {
+                g_free(title);
+            }
+        }
+
+        if (titles->len >= min_links) {
+            for (guint i = 0; i < titles->len; ++i) {
+                const char *url = g_ptr_array_index(hrefs, i);
+                gboolean absolute = g_str_has_prefix(url, "http://") || g_str_has_prefix(url, "https://");
+                add_link(out, g_ptr_array_index(titles, i), absolute ? "" : base_url, url, search);
+            }
+            found = titles->len;
+        }
+
+        printf("[INFO]: %s: %u items match \"%s\", %u links%s.\n",
+               search->site_name, items->len, item_selector, titles->len,
+               found < titles->len ? " (too few, not used)" : "");
+        g_ptr_array_free(hrefs, TRUE);
+        g_ptr_array_free(titles, TRUE);
+        g_ptr_array_free(items, TRUE);
+    }
+
+    css_selector_free(items_sel);
+    css_selector_free(link_sel);
+    return found;
 }
 
 
+// --------------------------------
 
-// ==================
 
+// Raw contents of a <script> element (Gumbo keeps them as one text
+// child), or NULL if it is empty.
 
-// Helper function to clear the previous recipe search results
-static void clear_recipe_results(GtkWidget *listbox) {
-    gtk_widget_freeze_child_notify(listbox);
-    GList *children = gtk_container_get_children(GTK_CONTAINER(listbox));
-    for (GList *iter = children; iter != NULL; iter = iter->next)
-        gtk_widget_destroy(GTK_WIDGET(iter->data));
-    g_list_free(children);
-    gtk_widget_thaw_child_notify(listbox);
-    gtk_widget_queue_draw(listbox);  // Force redraw in case anything is left over
+static const char *html_script_text(const GumboNode *script) {
+    const GumboVector *children = &script->v.element.children;
+    if (children->length == 0) return NULL;
+
+    const GumboNode *text = children->data[0];
+    if (text->type != GUMBO_NODE_TEXT && text->type != GUMBO_NODE_WHITESPACE &&
+        text->type != GUMBO_NODE_CDATA) {
+        return NULL;
+    }
+    return text->v.text.text;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Scroll-blocking filter
-// Note: G_GNUC_UNUSED is added to prevent compiler warnings.
-// GTK signal handlers must match a specific function signature, even if
-// you don't use the parameters. As an example, for this scroll-event,
-// GTK expects a function like:
-//   gboolean handler(GtkWidget *widget, GdkEventScroll *event, gpointer user_data);
-// Even if the parameters widget, event, and user_data are unused, you still
-// need to include them in the function signature, or GTK will not connect
-// the signal properly.
+// String member 'key' of a JSON object, or NULL if it is missing or not a string.
 
-static gboolean block_scroll(GtkWidget *widget G_GNUC_UNUSED,
-                             GdkEventScroll *event G_GNUC_UNUSED,
-                             gpointer user_data G_GNUC_UNUSED) {
-    return search_in_progress;  // Block scroll events while search is running
+static const char *json_ld_string(struct json_object *object, const char *key) {
+    struct json_object *value = NULL;
+    if (!json_object_is_type(object, json_type_object) ||
+        !json_object_object_get_ex(object, key, &value) ||
+        !json_object_is_type(value, json_type_string)) {
+        return NULL;
+    }
+    return json_object_get_string(value);
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Unified UI enable/disable function:
+// TRUE if a JSON-LD object's "@type" (a string or an array of strings) is 'type'.
 
-static void set_ui_enabled(const AppWidgets *w, gboolean enabled) {
-    search_in_progress = !enabled;
+static gboolean json_ld_has_type(struct json_object *object, const char *type) {
+    struct json_object *types = NULL;
+    if (!json_object_object_get_ex(object, "@type", &types)) return FALSE;
 
-    gtk_widget_set_sensitive(w->search_button, enabled);
-    gtk_widget_set_sensitive(w->entry, enabled);
-    gtk_widget_set_sensitive(w->combo, enabled);
-    gtk_widget_set_sensitive(w->listbox, enabled);
+    if (json_object_is_type(types, json_type_string))
+        return strcmp(json_object_get_string(types), type) == 0;
+
+    if (json_object_is_type(types, json_type_array)) {
+        size_t n_types = json_object_array_length(types);
+        for (size_t i = 0; i < n_types; ++i) {
+            struct json_object *entry = json_object_array_get_idx(types, i);
+            if (json_object_is_type(entry, json_type_string) &&
+                strcmp(json_object_get_string(entry), type) == 0) {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
 
-    gtk_editable_set_editable(GTK_EDITABLE(w->entry), enabled);
 
-    gtk_widget_set_can_focus(w->search_button, enabled);
-    gtk_widget_set_can_focus(w->entry, enabled);
-    gtk_widget_set_can_focus(w->combo, enabled);
-    gtk_widget_set_can_focus(w->listbox, enabled);
+// --------------------------------
+
+
+// Adds one JSON-LD entry as a link. A ListItem either carries the name and
+// url itself or wraps the listed thing in "item" (an object, or its URL).
+// Links that do not contain url_match (NULL: any) are skipped.
+// Returns 1 if a link was handed to add_link(), else 0.
+
+static guint json_ld_add_link(struct json_object *entry, const char *base_url, const char *url_match,
+                              GList **out, SearchContext *search) {
+    struct json_object *item = NULL;
+    const char *title = NULL, *url = NULL;
+
+    if (json_object_object_get_ex(entry, "item", &item)) {
+        if (json_object_is_type(item, json_type_string)) {
+            url = json_object_get_string(item);
+        } else {
+            title = json_ld_string(item, "name");
+            url = json_ld_string(item, "url");
+        }
+    }
+    if (!title) title = json_ld_string(entry, "name");
+    if (!url) url = json_ld_string(entry, "url");
+    if (!title || !*title || !url || !*url || !html_link_matches(base_url, url, url_match)) return 0;
+
+    gboolean absolute = g_str_has_prefix(url, "http://") || g_str_has_prefix(url, "https://");
+    add_link(out, title, absolute ? "" : base_url, url, search);
+    return 1;
 }
 
 
-// ==================
+// --------------------------------
 
 
-// Fallback recipe link handler
-// Adds a manual recipe link button to the combo box if the selected site
-// has no direct matching recipes.
-// The fallback link tries to provide a webpage that in itself has various
-// matching recipes on the food site. Worst case the fallback link will
-// be the main page of the food website.
-// Uses the same main result renderer to consistently format the link button.
+// Walks one parsed JSON-LD value: arrays and "@graph" members are
+// descended into (at most JSON_LD_MAX_DEPTH levels), ItemList entries and
+// Recipe objects become links. Returns the number of links added.
 
-void insert_fallback_link(GtkWidget *listbox, const char *url, const char *description) {
-    // Create a fallback button styled like the others
-    GtkWidget *btn = gtk_button_new_with_label(description);
-    gtk_style_context_add_class(gtk_widget_get_style_context(btn), "recipe-button");
+static guint json_ld_collect(struct json_object *node, const char *base_url, const char *url_match,
+                             GList **out, SearchContext *search, int depth) {
+    if (!node || depth > JSON_LD_MAX_DEPTH || search_context_is_cancelled(search)) return 0;
+    guint found = 0;
+
+    if (json_object_is_type(node, json_type_array)) {
+        size_t n_entries = json_object_array_length(node);
+        for (size_t i = 0; i < n_entries; ++i) {
+            found += json_ld_collect(json_object_array_get_idx(node, i), base_url, url_match, out, search, depth + 1);
+        }
+        return found;
+    }
+    if (!json_object_is_type(node, json_type_object)) return 0;
 
-    // Store the URL and connect the click handler
-    g_object_set_data_full(G_OBJECT(btn), "url", g_strdup(url), g_free);
-    g_signal_connect(btn, "clicked", G_CALLBACK(on_recipe_clicked),
-                     g_object_get_data(G_OBJECT(btn), "url"));
+    struct json_object *member = NULL;
+    if (json_object_object_get_ex(node, "@graph", &member)) {
+        found += json_ld_collect(member, base_url, url_match, out, search, depth + 1);
+    }
+
+    if (json_ld_has_type(node, "ItemList") &&
+        json_object_object_get_ex(node, "itemListElement", &member) &&
+        json_object_is_type(member, json_type_array)) {
+        size_t n_entries = json_object_array_length(member);
+        for (size_t i = 0; i < n_entries && !search_context_is_cancelled(search); ++i) {
+            found += json_ld_add_link(json_object_array_get_idx(member, i), base_url, url_match, out, search);
+        }
+    } else if (json_ld_has_type(node, "Recipe")) {
+        found += json_ld_add_link(node, base_url, url_match, out, search);
+    }
 
-    gtk_list_box_insert(GTK_LIST_BOX(listbox), btn, -1);
-    gtk_widget_show_all(btn);
+    return found;
 }
 
 
+// --------------------------------
 
 
-// ================================================================
-//  ***  CSS STYLES  ***
-// ================================================================
+// Adds the results the page lists in its JSON-LD blocks (see the NOTES
+// above), keeping the links that contain url_match (NULL: any). Blocks
+// that fail to parse are skipped. Returns the number of links handed to
+// add_link().
+
+static guint html_extract_json_ld_links(GumboNode *root, const char *base_url, const char *url_match,
+                                        GList **out, SearchContext *search) {
+    CssSelector *script_sel = css_selector_new("script[type=\"application/ld+json\"]");
+    GPtrArray *scripts = g_ptr_array_new();
+    css_select(root, script_sel, scripts);
+
+    guint found = 0;
+    for (guint i = 0; i < scripts->len && !search_context_is_cancelled(search); ++i) {
+        const char *json = html_script_text(g_ptr_array_index(scripts, i));
+        struct json_object *block = json ? json_tokener_parse(json) : NULL;
+        if (block) {
+            found += json_ld_collect(block, base_url, url_match, out, search, 0);
+            json_object_put(block);
+        }
+    }
 
-// Load and register the app's custom GTK CSS style rules to enhance the UI.
-// CSS stands for Cascading Style Sheets.
-// CSS styles affect the appearance of GTK elements (combo boxes, buttons,
-// entry fields, and labels), without changing their actual functionality.
-// This includes colors, fonts, spacing, borders, layouts, and animations.
+    printf("[INFO]: %s: %u JSON-LD blocks, %u links.\n", search->site_name, scripts->len, found);
+    g_ptr_array_free(scripts, TRUE);
+    css_selector_free(script_sel);
+    return found;
+}
 
-static void load_app_css_styles(void) {
-    const gchar *css =
-        // =====================
-        // Search Entry Field Styles
-        //   (Yellow Background)
-        // =====================
-        "entry.search-entry {"
-        "  background-color: #fff7b3;"
-        "  font-weight: bold;"
-        "  font-size: 18pt;"
-        "  border: 1px solid #aaa;"
-        "  border-radius: 6px;"
-        "  padding: 8px;"
-        "}\n"
 
-        // =======================
-        // Combo Box Parent Styles
-        //   (Blue Background)
-        // =======================
-        ".site-combo {"
-        "  background-color: #b3d7ff;"
-        "  color: #222222;"
-        "  font-weight: bold;"
-        "  font-size: 13pt;"
-        "  min-height: 12px;"
-        "  padding-top: 0px;"
-        "  padding-bottom: 0px;"
-        "  margin-top: 0px;"
-        "  margin-bottom: 0px;"
-        "}\n"
+// --------------------------------
 
-        // ================================================
-        // Combo Box Children Styles (elements inside box)
-        // ================================================
-        ".site-combo > * {"
-        "  background-color: #b3d7ff;"
-        "  color: #222222;"
-        "  font-weight: bold;"
-        "  font-size: 13pt;"
-        "  min-height: 12px;"
-        "  padding-top: 0px;"
-        "  padding-bottom: 0px;"
-        "  margin-top: 0px;"
-        "  margin-bottom: 0px;"
-        "}\n"
 
-        // ===================================
-        // Status Label (status and error messages)
-        // ===================================
-        ".status-label {"
-        "  color: red;"
-        "  font-weight: bold;"
-        "  font-size: 12pt;"
-        "}\n"
+// Walks Next.js page state below 'node' for result-like objects: a title
+// ("title", "headline" or "name") next to a link ("url", "href" or "link")
+// that contains url_match (any link if NULL). Matched objects are not
+// descended into; everything else is, at most NEXT_DATA_MAX_DEPTH levels.
+// Returns the number of links handed to add_link().
 
-        // ===================
-        // Search Button Styles
-        // ===================
-        ".search-button {"
-        "  background-image: none;"
-        "  background-color: #a2f6a9;"
-        "  color: black;"
-        "  font-weight: bold;"
-        "  font-size: 18px;"
-        "  border: 2px solid #388E3C;"
-        "  border-radius: 5px;"
-        "  padding: 12px 16px;"
-        "}\n"
-        ".search-button:hover {"
-        "  background-color: #b2f2bb;"
-        "}\n"
+static guint next_data_collect(struct json_object *node, const char *base_url, const char *url_match,
+                               GList **out, SearchContext *search, int depth) {
+    if (!node || depth > NEXT_DATA_MAX_DEPTH || search_context_is_cancelled(search)) return 0;
+    guint found = 0;
 
-        // ========================
-        // Combo Box List Row Styles
-        // ========================
-        "combobox box list row,"
-        "combobox menuitem {"
-        "  padding: 4px 12px;"
-        "  min-height: 28px;"
-        "  font-size: 13pt;"
-        "}\n"
+    if (json_object_is_type(node, json_type_array)) {
+        size_t n_entries = json_object_array_length(node);
+        for (size_t i = 0; i < n_entries; ++i) {
+            found += next_data_collect(json_object_array_get_idx(node, i), base_url, url_match, out, search, depth + 1);
+        }
+        return found;
+    }
+    if (!json_object_is_type(node, json_type_object)) return 0;
 
-        // ======================================
-        // Standard Recipe Link Button Styles
-        // ======================================
-        "button.recipe-button {"
-        "  background-image: none;"
-        "  background-color: #FFFBE7;"
-        "  box-shadow: 0 1px 2px rgba(0, 0, 0, 0.1);"
-        "  color: #000000;"
-        "  font-weight: bold;"
-        "  font-size: 12pt;"
-        "  border: 1px solid #E0C080;"
-        "  border-radius: 6px;"
-        "  padding: 6px 10px;"
-        "}\n"
-        "button.recipe-button:hover {"
-        "  border-color: #888888;"            /* dark gray hover */
-        "  background-color: #FFFBE7;"        /* subtle lighten */
-        "}\n"
+    static const char *const title_keys[] = { "title", "headline", "name" };
+    static const char *const url_keys[] = { "url", "href", "link" };
+    const char *title = NULL, *url = NULL;
+    for (size_t i = 0; i < G_N_ELEMENTS(title_keys) && !title; ++i) title = json_ld_string(node, title_keys[i]);
+    for (size_t i = 0; i < G_N_ELEMENTS(url_keys) && !url; ++i) url = json_ld_string(node, url_keys[i]);
 
-        // ======================================
-        // Partial Match Recipe Styles (Light Beige + Hover)
-        // ======================================
-        "button.recipe-partial {"
-        "  background-image: none;"
-        "  background-color: #FFF8E1;"
-        "  color: #000000;"
-        "  font-weight: bold;"
-        "  font-size: 12pt;"
-        "  border: 1px solid #E0C080;"
-        "  border-radius: 6px;"
-        "  padding: 6px 10px;"
-        "}\n"
-        "button.recipe-partial:hover {"
-        "  border-color: #AFA89A;"            /* warm gray hover */
-        "  background-color: #FFFBE7;"        /* subtle lighten */
-        "}\n"
+    if (title && *title && url && *url && html_link_matches(base_url, url, url_match)) {
+        gboolean absolute = g_str_has_prefix(url, "http://") || g_str_has_prefix(url, "https://");
+        add_link(out, title, absolute ? "" : base_url, url, search);
+        return 1;
+    }
 
-        // =================================================
-        // Perfect Match Recipe Styles (Bright Yellow + Blue Hover)
-        // =================================================
-        "button.recipe-perfect {"
-        "  background-image: none;"
-        "  background-color: #fff7b3;"
-        "  color: #000000;"
-        "  font-weight: bold;"
-        "  font-size: 12pt;"
-        "  border: 2px solid #FFD700;"
-        "  border-radius: 6px;"
-        "  padding: 6px 10px;"
-        "}\n"
-        "button.recipe-perfect:hover {"
-        "  border-color: #4A90E2;"            /* blue glow effect on hover */
-        "  background-color: #fffb90;"        /* subtle lighten */
-        "}\n";
+    json_object_object_foreach(node, key, value) {
+        (void)key;
+        found += next_data_collect(value, base_url, url_match, out, search, depth + 1);
+    }
+    return found;
+}
+
+
+// --------------------------------
+
+
+// Adds the results held in a Next.js page's server-side state
+// (<script id="__NEXT_DATA__">), starting at props.pageProps where the
+// search results live. Returns the number of links handed to add_link().
 
-    register_css_styles(css);
+static guint html_extract_next_data_links(GumboNode *root, const char *base_url, const char *url_match,
+                                          GList **out, SearchContext *search) {
+    CssSelector *script_sel = css_selector_new("script#__NEXT_DATA__");
+    GumboNode *script = css_select_first(root, script_sel);
+    css_selector_free(script_sel);
+
+    const char *json = script ? html_script_text(script) : NULL;
+    struct json_object *state = json ? json_tokener_parse(json) : NULL;
+    if (!state) return 0;
+
+    struct json_object *props = NULL, *page_props = NULL;
+    struct json_object *start = state;
+    if (json_object_object_get_ex(state, "props", &props) &&
+        json_object_object_get_ex(props, "pageProps", &page_props)) {
+        start = page_props;
+    }
+
+    guint found = next_data_collect(start, base_url, url_match, out, search, 0);
+    printf("[INFO]: %s: __NEXT_DATA__ state gave %u links.\n", search->site_name, found);
+    json_object_put(state);
+    return found;
 }
 
 
+// ==========================================================================
+// ==========================================================================
+
 
 // ==========================================================================
 //  ***  BEGINNING OF JAVASCRIPT AND C RECIPE PARSERS  ***
@@ -3488,10 +10731,9 @@ NOTES ON THE JAVASCRIPT CODE BELOW:
 
 This app uses embedded JavaScript parsers, stored as long C string
 variables that are customized for specific recipe websites.
-These JavaScript snippets form the contents of temporary external
-'.js' files generated by the app. The temporary files are dynamically
-written to disk and executed by website-specific C logic using Node.js
-and the Playwright library.
+These JavaScript snippets are sent by website-specific C logic to the
+persistent Node.js scraper worker (see run_site_script()), which runs
+them against a warm Playwright browser without writing them to disk.
 
 Purpose:
   - Automates a headless browser (Chromium) to search for recipes on
@@ -3576,7 +10818,8 @@ static const char *allrecipes_js_code =
 "  if (!recipes || recipes.length === 0) {\n"
 "    recipes = [{\n"
 "      title: 'Click to see AllRecipes Search Page',\n"
-"      url: 'https://www.allrecipes.com/recipes/'\n"
+"      url: 'https://www.allrecipes.com/recipes/',\n"
+"      fallback: true\n"
 "    }];\n"
 "  }\n"
 "\n"
@@ -3588,96 +10831,17 @@ static const char *allrecipes_js_code =
 // --------------------------------
 
 // AllRecipes.com C recipe scraper scaffolding function (for embedded execution via Node.js)
-static void parse_allrecipes(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_allrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "ar", 0, temp_filename)) {
-        fprintf(stderr, "Failed to create temporary JS filename.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "Failed to open temp JS file for writing.\n");
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/allrecipes_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);  // ".js"
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("fdopen");
-        close(fd);
-        return;
-    }
-#endif
-
-    // Write embedded JavaScript to temp file
-    fputs(allrecipes_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    char command[1024];
-
-#ifdef _WIN32
-    // Use %APPDATA%\npm\node_modules for NODE_PATH
-    const char *node_path = getenv("APPDATA");
-    if (!node_path) {
-        fprintf(stderr, "APPDATA environment variable not set.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", node_path);
-    snprintf(command, sizeof(command),
-        "cmd /c \"set NODE_PATH=%s&& \"C:\\\\Program Files\\\\nodejs\\\\node.exe\" \"%s\" \"%s\"\"",
-        node_path_full, temp_filename, search_term);
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";  // Change as needed for Mac and Linux
-    snprintf(command, sizeof(command),
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term);
-#endif
-
-    FILE *fp = popen(command, "r");
-    if (!fp) {
-        fprintf(stderr, "Failed to run Node.js scraper command.\n");
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-        return;
-    }
-
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    pclose(fp);
-
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
+    // Run the embedded script in the persistent scraper worker; its records
+    // are added as they are parsed (titles get their digits split off)
+    SiteRecordContext records = { out, search, "", TRUE, 0 };
+    gboolean ok = run_site_script_records(search, "allrecipes", allrecipes_js_code, search_term,
+                                          site_record_add_link, &records, NULL);
 
     // check for installed prerequisite software
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
+    if (!ok && records.records == 0) {
         fprintf(stderr,
         "\n[Recipe Finder Error]\n"
         "The recipe search script failed to run or returned no valid results.\n\n"
@@ -3692,30 +10856,12 @@ static void parse_allrecipes(GumboNode *unused, GList **out, GHashTable *link_se
         "Defaulting to the AllRecipes generic search page ...\n"
     );
 
-    add_link(out, "Click to see AllRecipes Search Page", "", "https://www.allrecipes.com/recipes/", link_set);
+    add_fallback_link(out, "Click to see AllRecipes Search Page", "https://www.allrecipes.com/recipes/", search);
     return;
 }
 
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj, *url_obj;
-
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-           const char *url = json_object_get_string(url_obj);
-           char *fixed_title = split_title_and_digits(title);
-           if (!fixed_title) fixed_title = strdup(title); // fallback
-           add_link(out, fixed_title, "", url, link_set);
-           free(fixed_title);
-        }
-    }
-
-    json_object_put(parsed_json);
-
     if (*out == NULL) {
-        add_link(out, "Click to see AllRecipes Search Page", "", "https://www.allrecipes.com/recipes/", link_set);
+        add_fallback_link(out, "Click to see AllRecipes Search Page", "https://www.allrecipes.com/recipes/", search);
     }
 }
 
@@ -3754,29 +10900,20 @@ static const char *bbcgoodfood_js_code =
 "  try {\n"
 "    const searchUrl = `https://www.bbcgoodfood.com/search/recipes?q=${encodeURIComponent(searchTerm)}`;\n"
 "    debugLog('Navigating to BBC Good Food search page');\n"
-"    await page.goto(searchUrl, { waitUntil: 'networkidle' });\n"
+"    await page.goto(searchUrl, { waitUntil: 'domcontentloaded', timeout: 30000 });\n"
+"    await page.waitForSelector('article', { timeout: 10000 }).catch(() => debugLog('No <article> yet'));\n"
 "\n"
 "    const consentSelector = '[data-testid=\"consent-banner-accept\"]';\n"
 "    if (await page.$(consentSelector)) {\n"
 "      debugLog('No consent banner visible');\n"
 "    }\n"
 "\n"
-"    for (let i = 1; i <= 7; i++) {\n"
+"    for (let i = 1; i <= 3; i++) {\n"
 "      debugLog(`Scrolled ${i}`);\n"
 "      await page.evaluate(() => window.scrollBy(0, window.innerHeight));\n"
-"      await page.waitForTimeout(1000);\n"
+"      await page.waitForTimeout(300);\n"
 "    }\n"
 "\n"
-"    const screenshotPath = 'C:\\\\MSYS64\\\\PROJECTS\\\\after_scroll.png';\n"
-"    const htmlPath = 'C:\\\\MSYS64\\\\PROJECTS\\\\page_content.html';\n"
-"    await page.screenshot({ path: screenshotPath, fullPage: true });\n"
-"    debugLog(`Saved screenshot to ${screenshotPath}`);\n"
-"\n"
-"    const htmlContent = await page.content();\n"
-"    const fs = require('fs');\n"
-"    fs.writeFileSync(htmlPath, htmlContent, 'utf-8');\n"
-"    debugLog(`Wrote full HTML content to ${htmlPath}`);\n"
-"\n"
 "    debugLog('Attempting to extract recipes using updated logic');\n"
 "\n"
 "    const recipes = [];\n"
@@ -3842,137 +10979,26 @@ static const char *bbcgoodfood_js_code =
 
 
 // BBC Good Food C Parser
-void parse_bbcgoodfood(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+void parse_bbcgoodfood(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "BBC GOODFOOD PARSER Failed to get temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "bbc", 0, temp_filename)) {
-        fprintf(stderr, "BBC GOODFOOD PARSER Failed to create temp JS file.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "BBC GOODFOOD PARSER Failed to open temp JS file.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/bbcgoodfood_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);  // ".js"
-    if (fd == -1) {
-        perror("[BBC GOODFOOD PARSER] mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("BBC GOODFOOD PARSER fdopen");
-        close(fd);
-        return;
-    }
-#endif
-
-    fputs(bbcgoodfood_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    char *command = NULL;
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    const char *program_files = getenv("ProgramFiles");
-
-    if (!appdata || !program_files) {
-        fprintf(stderr, "BBC GOODFOOD PARSER Missing APPDATA or ProgramFiles environment variables.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
-
-    char node_exe[MAX_PATH];
-    snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-
-    char quoted_term[1024];
-    snprintf(quoted_term, sizeof(quoted_term), "\"%s\"", search_term);
-
-    // Dynamically calculate required size
-    size_t needed = snprintf(NULL, 0,
-        "cmd /c \"set NODE_PATH=%s&& %s \"%s\" %s\"",
-        node_path_full, node_exe, temp_filename, quoted_term) + 1;
-
-    command = malloc(needed);
-    if (!command) {
-        fprintf(stderr, "BBC GOODFOOD PARSER Failed to allocate memory for command string.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    snprintf(command, needed,
-        "cmd /c \"set NODE_PATH=%s&& %s \"%s\" %s\"",
-        node_path_full, node_exe, temp_filename, quoted_term);
-
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-
-    size_t needed = snprintf(NULL, 0,
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term) + 1;
-
-    command = malloc(needed);
-    if (!command) {
-        perror("BBC GOODFOOD PARSER malloc");
-        unlink(temp_filename);
-        return;
-    }
-
-    snprintf(command, needed,
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term);
-#endif
-
-    printf("BBC GOODFOOD PARSER Executing command: %s\n", command);
-
-    FILE *fp = popen(command, "r");
-    free(command);  // Free right after spawning process
-    if (!fp) {
+    // Run the embedded script in the persistent scraper worker
+    int status = 0;
+    printf("BBC GOODFOOD PARSER Running JS script in scraper worker.\n");
+    char *output = run_site_script(search, "bbcgoodfood", bbcgoodfood_js_code, search_term, &status);
+    if (!output) {
         fprintf(stderr, "BBC GOODFOOD PARSER Failed to run JS script.\n");
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-        add_link(out, "Click to see BBC Good Food Recipes", "", "https://www.bbcgoodfood.com/search", link_set);
+        add_fallback_link(out, "Click to see BBC Good Food Recipes", "https://www.bbcgoodfood.com/search", search);
         return;
     }
 
-    char line[2048];
-    GString *full_output = g_string_new("");
-
-    while (fgets(line, sizeof(line), fp)) {
-        printf("[JS OUTPUT] %s", line);
-        g_string_append(full_output, line);
-    }
-
-    int status = pclose(fp);
     if (status != 0) {
         fprintf(stderr, "BBC GOODFOOD PARSER JS script exited with status %d\n", status);
     }
 
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
+    GString *full_output = g_string_new(output);
+    g_free(output);
+    printf("[JS OUTPUT] %s", full_output->str);
 
     printf("BBC GOODFOOD PARSER JS script complete. Output length: %zu bytes\n", full_output->len);
 
@@ -3981,7 +11007,7 @@ void parse_bbcgoodfood(GumboNode *unused, GList **out, GHashTable *link_set, con
         fprintf(stderr,
                 "[Recipe Finder Error] BBC Good Food script failed or returned invalid JSON.\n"
                 "BBC GOODFOOD PARSER Raw JS output:\n%s\n", full_output->str);
-        add_link(out, "Click to see BBC Good Food Recipes", "", "https://www.bbcgoodfood.com/search", link_set);
+        add_fallback_link(out, "Click to see BBC Good Food Recipes", "https://www.bbcgoodfood.com/search", search);
         g_string_free(full_output, TRUE);
         return;
     }
@@ -4009,7 +11035,7 @@ void parse_bbcgoodfood(GumboNode *unused, GList **out, GHashTable *link_set, con
             if (question_mark) *question_mark = '\0';
 
             printf("BBC GOODFOOD PARSER: Adding recipe: %s -> %s\n", title, clean_url);
-            add_link(out, title, "", clean_url, link_set);
+            add_link(out, title, "", clean_url, search);
             free(clean_url);
         } else {
             printf("BBC GOODFOOD PARSER  JSON item missing title or url\n");
@@ -4027,7 +11053,7 @@ void parse_bbcgoodfood(GumboNode *unused, GList **out, GHashTable *link_set, con
                  "https://www.bbcgoodfood.com/search?q=%s",
                  curl_escape(search_term, 0));
 
-        add_link(out, "Click to see BBC Good Food Recipes", "", fallback_url, link_set);
+        add_fallback_link(out, "Click to see BBC Good Food Recipes", fallback_url, search);
     }
 }
 
@@ -4070,338 +11096,67 @@ static const char *bonappetit_js_code =
 "});\n";
 
 
-// --------------------------------
-
-// Bon Appetit Parser
-static void parse_bonappetit(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "ba", 0, temp_filename)) {
-        fprintf(stderr, "Failed to get Windows temp file name.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "Failed to create temp JS file.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/bonappetit_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);  // ".js"
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("fdopen");
-        close(fd);
-        return;
-    }
-#endif
-
-    fputs(bonappetit_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    char *command = NULL;
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    if (!appdata) {
-        fprintf(stderr, "APPDATA environment variable not set.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
-
-    char node_exe[MAX_PATH] = "node";
-    const char *program_files = getenv("ProgramFiles");
-    if (program_files) {
-        snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-    }
-
-    // Dynamically size the command string
-    size_t needed = snprintf(NULL, 0,
-        "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-        node_path_full, node_exe, temp_filename, search_term) + 1;
-
-    command = malloc(needed);
-    if (!command) {
-        fprintf(stderr, "Failed to allocate memory for command string.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    snprintf(command, needed,
-        "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-        node_path_full, node_exe, temp_filename, search_term);
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-    size_t needed = snprintf(NULL, 0,
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term) + 1;
-
-    command = malloc(needed);
-    if (!command) {
-        perror("malloc");
-        unlink(temp_filename);
-        return;
-    }
-
-    snprintf(command, needed,
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term);
-#endif
-
-    FILE *fp = popen(command, "r");
-    free(command); // Free command immediately after use
-    if (!fp) {
-        fprintf(stderr,
-            "\n[Recipe Finder Error]\n"
-            "Bon Appetit parser failed to run Node.js command.\n"
-#ifdef _WIN32
-            "Please ensure:\n"
-            "  - Node.js is installed (https://nodejs.org)\n"
-            "  - Playwright is installed (`npm install -g playwright`)\n"
-            "  - Browsers are installed (`playwright install`)\n"
-            "  - Node.exe is available in PATH or installed in %%ProgramFiles%%\\nodejs\\node.exe\n\n"
-#else
-            "Please ensure:\n"
-            "  - Node.js is installed (https://nodejs.org)\n"
-            "  - Playwright is installed (`npm install -g playwright`)\n"
-            "  - Browsers are installed (`playwright install`)\n"
-            "  - Node is available in PATH\n\n"
-#endif
-            "Defaulting to Bon Appetit search page...\n\n");
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-        add_link(out, "Click to see Bon Appetit Recipes Search Page", "", "https://www.bonappetit.com/recipes", link_set);
-        return;
-    }
-
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    pclose(fp);
-
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr,
-            "\n[Recipe Finder Error]\n"
-            "Bon Appetit parser failed or returned invalid data.\n\n"
-            "Please ensure:\n"
-            "  - Node.js is installed (https://nodejs.org)\n"
-            "  - Playwright is installed (`npm install -g playwright`)\n"
-            "  - Browsers are installed (`playwright install`)\n"
-            "  - Node is available in PATH\n\n"
-            "Defaulting to Bon Appetit search page...\n\n");
-
-        add_link(out, "Click to see Bon Appetit Recipes Search Page", "", "https://www.bonappetit.com/recipes", link_set);
-        return;
-    }
-
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj, *url_obj;
-
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-            const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
-        }
-    }
-
-    json_object_put(parsed_json);
-
-    if (*out == NULL) {
-        add_link(out, "Click to see Bon Appetit Recipes Search Page", "", "https://www.bonappetit.com/recipes", link_set);
-    }
-}
-
-
-// ==================
-// ==================
-
-
-
-// Budget Bytes JavaScript
-// Has dynamic fallback behavior that injects the UI search term into the fallback website page.
-
-static const char *budgetbytes_js_code =
-"const https = require('https');\n"
-"const term = process.argv[2] || 'chicken';\n"
-"const url = `https://search.slickstream.com/search?site=budgetbytes.com&q=${encodeURIComponent(term)}`;\n"
-"\n"
-"https.get(url, (res) => {\n"
-"  let data = '';\n"
-"  res.on('data', chunk => data += chunk);\n"
-"  res.on('end', () => {\n"
-"    try {\n"
-"      const json = JSON.parse(data);\n"
-"      const results = json.results.map(r => ({ title: r.title, url: r.url }));\n"
-"      if (!results.length) throw new Error('Empty results');\n"
-"      console.log(JSON.stringify(results, null, 2));\n"
-"    } catch (e) {\n"
-"      const fallbackTitle = `Search for \\\"${term}\\\" on Budget Bytes`;\n"
-"      const fallbackURL = `https://www.budgetbytes.com/?s=${encodeURIComponent(term)}`;\n"
-"      console.error('[Debug] Fallback triggered:', e.message);\n"
-"      console.log(JSON.stringify([{ title: fallbackTitle, url: fallbackURL }]));\n"
-"      process.exit(1);\n"
-"    }\n"
-"  });\n"
-"}).on('error', (e) => {\n"
-"  const fallbackTitle = `Search for \\\"${term}\\\" on the BudgetBytes.com Website`;\n"
-"  const fallbackURL = `https://www.budgetbytes.com/?s=${encodeURIComponent(term)}`;\n"
-"  console.error('This HTTP error was triggered:', e.message);\n"
-"  console.error('Creating BudgetBytes fallback recipe link.');\n"
-"  console.log(JSON.stringify([{ title: fallbackTitle, url: fallbackURL }]));\n"
-"  process.exit(1);\n"
-"});\n";
-
-
-// --------------------------------
-
-
-// Budget Bytes C Parser:
-static void parse_budgetbytes(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-    if (!GetTempFileNameA(temp_path, "bb", 0, temp_filename)) {
-        fprintf(stderr, "Failed to get Windows temp file name.\n");
-        return;
-    }
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "Failed to create temp JS file.\n");
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/budgetbytes_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("fdopen");
-        close(fd);
-        return;
-    }
-#endif
-
-    fputs(budgetbytes_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    char command[1024];
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    if (!appdata) {
-        fprintf(stderr, "APPDATA environment variable not set.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    char node_exe[MAX_PATH] = "node";
-    const char *program_files = getenv("ProgramFiles");
-    if (program_files) {
-        snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-    }
+// --------------------------------
 
-    snprintf(command, sizeof(command),
-             "cmd /c \"set NODE_PATH=%s\\npm\\node_modules&& %s \"%s\" \"%s\"\"",
-             appdata, node_exe, temp_filename, search_term);
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-    snprintf(command, sizeof(command),
-             "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-             node_path, temp_filename, search_term);
-#endif
+// Bon Appetit Parser
+static void parse_bonappetit(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
+    // Run the embedded script in the persistent scraper worker
+    SiteRecordContext records = { out, search, "", FALSE, 0 };
+    gboolean ok = run_site_script_records(search, "bonappetit", bonappetit_js_code, search_term,
+                                          site_record_add_link, &records, NULL);
+    if (!ok && records.records == 0) {
         fprintf(stderr,
-                "[Recipe Finder Error] Budget Bytes parser failed to run Node.js command.\n");
+            "\n[Recipe Finder Error]\n"
+            "Bon Appetit parser failed to run its Node.js script or returned invalid data.\n"
 #ifdef _WIN32
-        DeleteFileA(temp_filename);
+            "Please ensure:\n"
+            "  - Node.js is installed (https://nodejs.org)\n"
+            "  - Playwright is installed (`npm install -g playwright`)\n"
+            "  - Browsers are installed (`playwright install`)\n"
+            "  - Node.exe is available in PATH or installed in %%ProgramFiles%%\\nodejs\\node.exe\n\n"
 #else
-        unlink(temp_filename);
+            "Please ensure:\n"
+            "  - Node.js is installed (https://nodejs.org)\n"
+            "  - Playwright is installed (`npm install -g playwright`)\n"
+            "  - Browsers are installed (`playwright install`)\n"
+            "  - Node is available in PATH\n\n"
 #endif
-        add_link(out, "Click to see Budget Bytes Search Page", "", "https://www.budgetbytes.com/recipes", link_set);
+            "Defaulting to Bon Appetit search page...\n\n");
+        add_fallback_link(out, "Click to see Bon Appetit Recipes Search Page", "https://www.bonappetit.com/recipes", search);
         return;
     }
 
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    pclose(fp);
+    if (*out == NULL) {
+        add_fallback_link(out, "Click to see Bon Appetit Recipes Search Page", "https://www.bonappetit.com/recipes", search);
+    }
+}
 
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
 
-    struct json_object *parsed_json = json_tokener_parse(buffer);
+// ==================
+// ==================
 
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr, "[Recipe Finder Error] Budget Bytes parser returned invalid data.\n");
-        add_link(out, "Click to see Budget Bytes Search Page", "", "https://www.budgetbytes.com/recipes", link_set);
-        return;
-    }
 
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj, *url_obj;
 
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-            const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
-        }
-    }
+// Budget Bytes C Parser:
+// Budget Bytes is a SITE_JSON_ENDPOINT site: run_site_parser() reads its
+// Slickstream search API natively (see budgetbytes_json_endpoint), so no
+// Node.js job is needed. This only adds a link to the site's own search
+// page when the API found nothing.
 
-    json_object_put(parsed_json);
+static void parse_budgetbytes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
     if (*out == NULL) {
-        add_link(out, "Click to see Budget Bytes Search Page", "", "https://www.budgetbytes.com/recipes", link_set);
+        char *encoded = url_encode(search_term ? search_term : "");
+        char *fallback_url = g_strdup_printf("https://www.budgetbytes.com/?s=%s", encoded);
+        char *fallback_title = g_strdup_printf("Search for \"%s\" on the BudgetBytes.com Website",
+                                               search_term ? search_term : "");
+        add_fallback_link(out, fallback_title, fallback_url, search);
+        g_free(fallback_title);
+        g_free(fallback_url);
+        g_free(encoded);
     }
 }
 
@@ -4417,16 +11172,15 @@ static void parse_budgetbytes(GumboNode *unused, GList **out, GHashTable *link_s
 //   main recipe category page.
 // This removes any dependency on Node.js or scraping, and guarantees a valid link every time.
 
-static void parse_chowhound(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_chowhound(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
     (void)search_term;
 
     // Always add a single fallback link to Chowhound recipes page
-    add_link(out,
-             "Click to see main Chowhound Recipe Page",
-             "",
-             "https://www.chowhound.com/category/recipes/",
-             link_set);
+    add_fallback_link(out,
+                      "Click to see main Chowhound Recipe Page",
+                      "https://www.chowhound.com/category/recipes/",
+                      search);
 }
 
 
@@ -4467,7 +11221,8 @@ static const char *cooksillustrated_js_code =
 "  if (links.length === 0) {\n"
 "    console.log(JSON.stringify([{\n"
 "      title: \"No recipes found - try another search\",\n"
-"      url: `https://www.americastestkitchen.com/search?q=${encodeURIComponent(term)}`\n"
+"      url: `https://www.americastestkitchen.com/search?q=${encodeURIComponent(term)}`,\n"
+"      fallback: true\n"
 "    }], null, 2));\n"
 "    await browser.close();\n"
 "    return;\n"
@@ -4506,123 +11261,26 @@ static const char *cooksillustrated_js_code =
 
 // Cook's Illustrated / America's Test Kitchen C Parser (supplied by DeepSeek)
 
-static void parse_cooksillustrated(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_cooksillustrated(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "ci", 0, temp_filename)) {
-        fprintf(stderr, "Failed to get Windows temp file name.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "Failed to create temp JS file.\n");
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/cooksillustrated_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);  // ".js"
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("fdopen");
-        close(fd);
-        return;
-    }
-#endif
-
-    fputs(cooksillustrated_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    char command[2048];  // Increased buffer size for safety
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    if (!appdata) {
-        fprintf(stderr, "APPDATA environment variable not set.\n");
-        return;
-    }
-
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
-
-    char node_exe[MAX_PATH];
-    snprintf(node_exe, sizeof(node_exe), "node");
-
-    const char *program_files = getenv("ProgramFiles");
-    if (program_files) {
-        snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-    }
-
-    snprintf(command, sizeof(command),
-        "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-        node_path_full, node_exe, temp_filename, search_term);
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-    snprintf(command, sizeof(command),
-        "timeout 60 NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, search_term);
-#endif
-
-    FILE *fp = popen(command, "r");
-    if (!fp) {
-        fprintf(stderr, "Error running Node.js script.\n");
-        add_link(out, "Click to see America's Test Kitchen Recipes", "", "https://www.americastestkitchen.com/recipes", link_set);
-        return;
-    }
-
-    char buffer[32768] = {0};
-    size_t total_len = 0;
-    char chunk[1024];
-    while (fgets(chunk, sizeof(chunk), fp) != NULL && total_len < sizeof(buffer) - 1) {
-        strncpy(buffer + total_len, chunk, sizeof(buffer) - total_len - 1);
-        total_len += strlen(chunk);
-    }
-    pclose(fp);
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr, "Failed to parse results from Node.js.\n");
-        add_link(out, "Click to see America's Test Kitchen Recipes", "", "https://www.americastestkitchen.com/recipes", link_set);
+    // Run the embedded script in the persistent scraper worker
+    SiteRecordContext records = { out, search, "", FALSE, 0 };
+    gboolean ok = run_site_script_records(search, "cooksillustrated", cooksillustrated_js_code, search_term,
+                                          site_record_add_link, &records, NULL);
+    if (!ok && records.records == 0) {
+        fprintf(stderr, "Error running Node.js script or parsing its results.\n");
+        add_fallback_link(out, "Click to see America's Test Kitchen Recipes", "https://www.americastestkitchen.com/recipes", search);
         return;
     }
 
-    size_t n = json_object_array_length(parsed_json);
-    if (n == 0) {
+    if (records.records == 0) {
         fprintf(stderr, "No results found for search term: %s\n", search_term);
-        add_link(out, "No recipes found for your search term", "", "https://www.americastestkitchen.com/recipes", link_set);
-    } else {
-        for (size_t i = 0; i < n; ++i) {
-            struct json_object *item = json_object_array_get_idx(parsed_json, i);
-            struct json_object *title_obj, *url_obj;
-
-            if (json_object_object_get_ex(item, "title", &title_obj) &&
-                json_object_object_get_ex(item, "url", &url_obj)) {
-                const char *title = json_object_get_string(title_obj);
-                const char *url = json_object_get_string(url_obj);
-                add_link(out, title, "", url, link_set);
-            }
-        }
+        add_fallback_link(out, "No recipes found for your search term", "https://www.americastestkitchen.com/recipes", search);
     }
 
-    json_object_put(parsed_json);
-
     if (*out == NULL) {
-        add_link(out, "Click to see Cook's Illustrated / ATK Recipes", "", "https://www.americastestkitchen.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Cook's Illustrated / ATK Recipes", "https://www.americastestkitchen.com/recipes", search);
     }
 }
 
@@ -4665,102 +11323,40 @@ static const char *delish_js_code =
 
 // Delish parser C function
 
-// Dynamically determines the global installation path of the Playwright
-// module using `npm root -g`. This approach ensures portability by
-// auto-detecting the actual install location, making the script resilient
-// to different system configurations by avoiding hard-coded paths.
+// Runs the Delish script in the persistent scraper worker, which already
+// resolved the global Playwright install when it started. The script output
+// is logged, and a Delish search link is always added.
 
-static void parse_delish(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_delish(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
-    char temp_filename[512];
-    FILE *tmp_fp;
-    char command[2048];
     char fallback[1024];
     char link_text[256];
-    int fd;  // Declare fd here, so it can be used across all platforms.
     // Log the search term being passed in
     printf("[INFO]: Parsing Delish using search term: %s\n", search_term);
 
-//  Windows -----------------
-
-#ifndef _WIN32
-    strcpy(temp_filename, "/tmp/delish_XXXXXX.js");
-    fd = mkstemps(temp_filename, 3);
-    if (fd == -1) {
-        printf("[WARNING]: Error creating Delish temp file\n");
-        return;
-    }
-    printf("[INFO]: Temporary JS file created: %s\n", temp_filename);
-#else
-    // Windows setup
-    char temp_path[MAX_PATH];
-    DWORD temp_length = GetTempPathA(MAX_PATH, temp_path);
-    if (temp_length == 0) {
-        printf("[WARNING]: Error getting Delish temp path on Windows.\n");
-        return;
-    }
-    snprintf(temp_filename, sizeof(temp_filename), "%s\\delish_temp.js", temp_path);
-    printf("[INFO]: Temporary Delish JS file created at: %s\n", temp_filename);
-    // Create temp file on Windows
-    tmp_fp = fopen(temp_filename, "w");
-    if (tmp_fp == NULL) {
-        printf("[WARNING]: Error creating temp Delish file on Windows.\n");
-        return;
-    }
-    fd = fileno(tmp_fp);  // Get the file descriptor for Windows
-#endif
-    tmp_fp = fdopen(fd, "w");
-    if (tmp_fp == NULL) {
-        printf("[WARNING]: Error opening temporary Delish file for writing\n");
-        return;
-    }
-    printf("[INFO]: Writing Delish JavaScript code to temporary file...\n");
-    fputs(delish_js_code, tmp_fp);
-    fclose(tmp_fp);
-    printf("[INFO]: Delish JavaScript code temporary file was closed.\n");
-
-//  macOS/Linux -----------------
-
-#ifndef _WIN32
-    // Dynamically detect NODE_PATH on macOS/Linux ---
-    char node_path[512] = "/usr/local/lib/node_modules"; // default fallback
-    FILE *np = popen("npm root -g", "r");
-    if (np) {
-        if (fgets(node_path, sizeof(node_path), np)) {
-            node_path[strcspn(node_path, "\n")] = 0; // strip newline
-        }
-        pclose(np);
-    }
-    // -------------------------------------------------------------
-    snprintf(command, sizeof(command),
-             "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-             node_path, temp_filename, search_term);
-#else
-    // Windows: NODE_PATH not needed if Playwright installed globally
-    snprintf(command, sizeof(command),
-             "node \"%s\" \"%s\"",
-             temp_filename, search_term);
-#endif
-    printf("[INFO]: Delish parser executing command: %s\n", command);
     snprintf(fallback, sizeof(fallback),
              "https://www.delish.com/search/?q=%s", search_term);
     snprintf(link_text, sizeof(link_text),
              "Click to see %s recipes on the Delish website", search_term);
     printf("[INFO]: Fallback Delish URL: %s\n", fallback);
     printf("[INFO]: Delish link text: %s\n", link_text);
-    // Run the script
-    int ret = system(command);
-    if (ret != 0) {
+
+    // Run the embedded script in the persistent scraper worker
+    int ret = 0;
+    char *output = run_site_script(search, "delish", delish_js_code, search_term, &ret);
+    if (!output || ret != 0) {
         // Handle fallback in case of failure
-        printf("[ALERT]: Delish parser error executing NODE_PATH command.\n");
+        printf("[ALERT]: Delish parser error running the JS script.\n");
         printf("         Return code: %d\n", ret);
         printf("         Creating a Delish fallback recipe link.\n");
-        add_link(out, link_text, "", fallback, link_set);
+        g_free(output);
+        add_fallback_link(out, link_text, fallback, search);
         return;
     }
     // Log success and continue processing
-    printf("[INFO]: Delish parser JavaScript executed successfully.\n");
-    add_link(out, link_text, "", fallback, link_set);
+    printf("[INFO]: Delish parser JavaScript executed successfully.\n%s", output);
+    g_free(output);
+    add_fallback_link(out, link_text, fallback, search);
 }
 
 
@@ -4823,193 +11419,26 @@ static const char *eatingwell_js_code =
 // --------------------------------
 
 // Eating Well C parser
-// Enhanced to auto-detect NODE_PATH on macOS, verifies Playwright
-// via Node require(), and prints debug info for
-// npm root -g output + resolved NODE_PATH
+// Runs the Eating Well script in the persistent scraper worker and falls
+// back to an Eating Well search link when no recipes come back.
 
-static void parse_eatingwell(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_eatingwell(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
     const char *term = (search_term && *search_term) ? search_term : "chicken";
 
-    char temp_filename[512];
-    FILE *tmp_fp = NULL;
-    char command[1024];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(sizeof(temp_path), temp_path)) {
-        fprintf(stderr, "[ERROR] GetTempPath failed\n");
-        return;
-    }
-    if (!GetTempFileNameA(temp_path, "ew", 0, temp_filename)) {
-        fprintf(stderr, "[ERROR] GetTempFileName failed\n");
-        return;
-    }
-    tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        perror("[ERROR] fopen failed");
-        return;
-    }
-#else
-    strcpy(temp_filename, "/tmp/eatingwell_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);
-    if (fd == -1) {
-        perror("[ERROR] mkstemps failed");
-        return;
-    }
-    tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("[ERROR] fdopen failed");
-        close(fd);
-        unlink(temp_filename);
-        return;
-    }
-#endif
-
-    fputs(eatingwell_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-#ifdef _WIN32
-    // Windows: no NODE_PATH override
-    snprintf(command, sizeof(command),
-        "cmd /c \"node \"%s\" \"%s\"\"",
-        temp_filename, term);
-#else
-    // macOS/Linux: detect global Node module path
-    char node_path[512] = {0};
-    char npm_output[512] = {0};
-    FILE *pathfp = popen("npm root -g 2>&1", "r"); // capture stderr too
-    if (pathfp) {
-        if (fgets(npm_output, sizeof(npm_output), pathfp)) {
-            npm_output[strcspn(npm_output, "\n")] = '\0';
-            strncpy(node_path, npm_output, sizeof(node_path) - 1);
-        }
-        pclose(pathfp);
-    }
-
-    if (node_path[0] == '\0') {
-#ifdef __APPLE__
-        strcpy(node_path, "/opt/homebrew/lib/node_modules"); // Apple Silicon Homebrew default
-#else
-        strcpy(node_path, "/usr/local/lib/node_modules");
-#endif
-    }
-
-    // Debug: print both npm root output and resolved NODE_PATH
-    fprintf(stderr, "[INFO]:  npm root -g output: %s\n", npm_output[0] ? npm_output : "(empty)");
-    fprintf(stderr, "[RESOLVED]:  Using NODE_PATH: %s\n", node_path);
-
-    // Check Playwright availability via Node require()
-    char check_cmd[1024];
-    snprintf(check_cmd, sizeof(check_cmd),
-        "NODE_PATH=\"%s\" node -e \"require('playwright'); console.log('OK')\" 2>/dev/null",
-        node_path);
-
-    FILE *check_fp = popen(check_cmd, "r");
-    int playwright_ok = 0;
-    if (check_fp) {
-        char check_buf[32] = {0};
-        if (fgets(check_buf, sizeof(check_buf), check_fp)) {
-            if (strstr(check_buf, "OK")) {
-                playwright_ok = 1;
-            }
-        }
-        pclose(check_fp);
-    }
-
-    if (!playwright_ok) {
-        fprintf(stderr, "[WARNING]: Playwright could not be required using NODE_PATH=%s\n", node_path);
-        fprintf(stderr, "           Try installing it globally. Run: npm install -g playwright\n");
-
-        char fallback[1024], link_text[256];
-        snprintf(fallback, sizeof(fallback), "https://www.eatingwell.com/search/?q=%s", term);
-        snprintf(link_text, sizeof(link_text), "Click to see \"%s\" recipes on Eating Well", term);
-        add_link(out, link_text, "", fallback, link_set);
-
-#ifndef _WIN32
-        unlink(temp_filename);
-#else
-        DeleteFileA(temp_filename);
-#endif
-        return;
-    }
-
-    snprintf(command, sizeof(command),
-        "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-        node_path, temp_filename, term);
-#endif
-
-    FILE *fp = popen(command, "r");
-    if (!fp) {
-        fprintf(stderr, "[Eating Well] Failed to run Node.js.\n");
-
-        char fallback[1024], link_text[256];
-        snprintf(fallback, sizeof(fallback), "https://www.eatingwell.com/search/?q=%s", term);
-        snprintf(link_text, sizeof(link_text), "Click to see \"%s\" recipes on Eating Well", term);
-        add_link(out, link_text, "", fallback, link_set);
-
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-        return;
-    }
-
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    pclose(fp);
-
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
-
-    if (len == 0) {
-        char fallback[1024], link_text[256];
-        snprintf(fallback, sizeof(fallback), "https://www.eatingwell.com/search/?q=%s", term);
-        snprintf(link_text, sizeof(link_text), "Click to see \"%s\" recipes on Eating Well", term);
-        add_link(out, link_text, "", fallback, link_set);
-        return;
-    }
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr, "[Eating Well] Failed to parse JSON.\n");
-
-        char fallback[1024], link_text[256];
-        snprintf(fallback, sizeof(fallback), "https://www.eatingwell.com/search/?q=%s", term);
-        snprintf(link_text, sizeof(link_text), "Click to see \"%s\" recipes on Eating Well", term);
-        add_link(out, link_text, "", fallback, link_set);
-
-        json_object_put(parsed_json);
-        return;
-    }
-
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        if (!item) continue;
-
-        struct json_object *title_obj = NULL, *url_obj = NULL;
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-            const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
-        }
+    // Run the embedded script in the persistent scraper worker
+    SiteRecordContext records = { out, search, "", FALSE, 0 };
+    if (!run_site_script_records(search, "eatingwell", eatingwell_js_code, term,
+                                 site_record_add_link, &records, NULL)) {
+        fprintf(stderr, "[Eating Well] Failed to run Node.js script or parse its JSON.\n");
     }
 
-    json_object_put(parsed_json);
-
     if (*out == NULL) {
         char fallback[1024], link_text[256];
         snprintf(fallback, sizeof(fallback), "https://www.eatingwell.com/search/?q=%s", term);
         snprintf(link_text, sizeof(link_text), "Click to see \"%s\" recipes on Eating Well", term);
-        add_link(out, link_text, "", fallback, link_set);
+        add_fallback_link(out, link_text, fallback, search);
     }
 }
 
@@ -5019,61 +11448,61 @@ static void parse_eatingwell(GumboNode *unused, GList **out, GHashTable *link_se
 // ==================
 
 
-// Epicurious wrapper (no JavaScript)
+// Epicurious parser (no JavaScript)
+// Streams the Epicurious search page through the anchor scanner and keeps
+// the recipe links as they arrive, instead of downloading the whole page
+// and walking a Gumbo DOM.
 
-static void parse_epicurious_wrapper(GumboNode *root, GList **out, GHashTable *link_set, const char *search_term) {
-    bool found_any = false;
-    parse_epicurious(root, out, link_set, search_term, &found_any);
+static void parse_epicurious_wrapper(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-    if (!found_any) {
-        char *encoded = url_encode(search_term);
+    AnchorParseContext ctx = { out, search, search_term, FALSE };
+
+    char *encoded = url_encode(search_term);
+    char url[512];
+    snprintf(url, sizeof(url), "https://www.epicurious.com/search/%s", encoded);
+
+    http_stream_anchors(url, 15L, search, epicurious_anchor_cb, &ctx);
+
+    if (!ctx.found_any) {
         char fallback_url[512];
         snprintf(fallback_url, sizeof(fallback_url),
                  "https://www.epicurious.com/search?q=%s",
                  encoded);
-        g_free(encoded);
 
         char fallback_title[256];
         snprintf(fallback_title, sizeof(fallback_title),
                  "Click to see \"%s\" on Epicurious", search_term);
 
-        add_link(out, fallback_title, "", fallback_url, link_set);
+        add_fallback_link(out, fallback_title, fallback_url, search);
     }
-}
 
-// Epicurious actual parsing logic
-static void parse_epicurious(GumboNode *node, GList **out, GHashTable *link_set, const char *search_term, bool *found_any) {
-    if (node->type != GUMBO_NODE_ELEMENT) return;
+    g_free(encoded);
+}
 
-    GumboElement *elem = &node->v.element;
+// Epicurious actual parsing logic (called for each streamed anchor)
+static void epicurious_anchor_cb(const AnchorLink *link, gpointer user_data) {
+    AnchorParseContext *ctx = user_data;
 
-    if (elem->tag == GUMBO_TAG_A) {
-        GumboAttribute *href = gumbo_get_attribute(&elem->attributes, "href");
-        if (href && strstr(href->value, "/recipes/food/views/")) {
-            const char *title = extract_anchor_text(node);
-            if (!title || !*title) {
-                title = "Epicurious Recipe";
-            }
+    if (!strstr(link->href, "/recipes/food/views/"))
+        return;
 
-            char full_url[512];
-            if (strncmp(href->value, "http", 4) == 0) {
-                strncpy(full_url, href->value, sizeof(full_url));
-            } else {
-                snprintf(full_url, sizeof(full_url),
-                         "https://www.epicurious.com%s", href->value);
-            }
+    const char *title = link->first_text;
+    if (!title || !*title) {
+        title = "Epicurious Recipe";
+    }
 
-            if (!g_hash_table_contains(link_set, full_url)) {
-                add_link(out, title, "", full_url, link_set);
-                *found_any = true;
-            }
-        }
+    char full_url[512];
+    if (strncmp(link->href, "http", 4) == 0) {
+        snprintf(full_url, sizeof(full_url), "%s", link->href);
+    } else {
+        snprintf(full_url, sizeof(full_url),
+                 "https://www.epicurious.com%s", link->href);
     }
 
-    // Recurse into children
-    GumboVector *children = &elem->children;
-    for (unsigned i = 0; i < children->length; ++i) {
-        parse_epicurious((GumboNode *)children->data[i], out, link_set, search_term, found_any);
+    if (!search_context_has_link(ctx->search, full_url)) {
+        add_link(ctx->out, title, "", full_url, ctx->search);
+        ctx->found_any = TRUE;
     }
 }
 
@@ -5184,129 +11613,38 @@ static const char *food52_js_code =
 "});";
 
 
-// --------------------------------
-
-
-// Food52 C Parser
-void parse_food52(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "[C DEBUG] Failed to get temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "f52", 0, temp_filename)) {
-        fprintf(stderr, "[C DEBUG] Failed to create temp JS file.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "[C DEBUG] Failed to open temp JS file.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    // Ensure buffer is not overrun
-    if (snprintf(temp_filename, sizeof(temp_filename), "/tmp/food52_XXXXXX.js") >= (int)sizeof(temp_filename)) {
-        fprintf(stderr, "[C DEBUG] temp_filename buffer too small.\n");
-        return;
-    }
-
-    int fd = mkstemps(temp_filename, 3);  // ".js"
-    if (fd == -1) {
-        perror("[C DEBUG] mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("[C DEBUG] fdopen");
-        close(fd);
-        unlink(temp_filename);
-        return;
-    }
-#endif
-
-    fputs(food52_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    // Command buffer for invoking Node.js
-    char command[2048];  // Large enough to avoid truncation
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    const char *program_files = getenv("ProgramFiles");
-
-    if (!appdata || !program_files) {
-        fprintf(stderr, "[C DEBUG] Missing APPDATA or ProgramFiles environment variables.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
+// --------------------------------
 
-    char node_exe[MAX_PATH];
-    snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
 
-    if (snprintf(command, sizeof(command),
-                 "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-                 node_path_full, node_exe, temp_filename, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "[C DEBUG] Command too long.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-    if (snprintf(command, sizeof(command),
-                 "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-                 node_path, temp_filename, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "[C DEBUG] Command too long.\n");
-        unlink(temp_filename);
-        return;
-    }
-#endif
+// Food52 C Parser
+void parse_food52(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
+    // Run the embedded script in the persistent scraper worker
+    char *output = run_site_script(search, "food52", food52_js_code, search_term, NULL);
+    if (!output) {
         fprintf(stderr, "[C DEBUG] Failed to run JS script.\n");
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-        add_link(out, "Click to see Food52 Recipes", "", "https://food52.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Food52 Recipes", "https://food52.com/recipes", search);
         return;
     }
 
-    char line[2048];
-    GString *full_output = g_string_new("");
+    GString *full_output = g_string_new(output);
     GString *json_candidate = g_string_new("");
+    g_free(output);
 
-    // Read output line by line, keep the last non-empty one
-    while (fgets(line, sizeof(line), fp)) {
-        printf("[JS LOG] %s", line);
-        g_string_assign(json_candidate, line);
-        g_string_append(full_output, line);
+    // Walk the output line by line, keep the last non-empty one
+    gchar **lines = g_strsplit(full_output->str, "\n", -1);
+    for (gchar **line = lines; *line; ++line) {
+        if (**line == '\0') continue;
+        printf("[JS LOG] %s\n", *line);
+        g_string_assign(json_candidate, *line);
     }
-    pclose(fp);
-
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
+    g_strfreev(lines);
 
     struct json_object *parsed_json = json_tokener_parse(json_candidate->str);
     if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
         fprintf(stderr, "[C DEBUG] JSON parsing failed or wrong type.\n");
-        add_link(out, "Click to see Food52 Recipes", "", "https://food52.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Food52 Recipes", "https://food52.com/recipes", search);
         g_string_free(full_output, TRUE);
         g_string_free(json_candidate, TRUE);
         return;
@@ -5314,7 +11652,7 @@ void parse_food52(GumboNode *unused, GList **out, GHashTable *link_set, const ch
 
     size_t n = json_object_array_length(parsed_json);
     if (n == 0) {
-        add_link(out, "Click to see Food52 Recipes", "", "https://food52.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Food52 Recipes", "https://food52.com/recipes", search);
     } else {
         for (size_t i = 0; i < n; ++i) {
             struct json_object *item = json_object_array_get_idx(parsed_json, i);
@@ -5327,7 +11665,7 @@ void parse_food52(GumboNode *unused, GList **out, GHashTable *link_set, const ch
                 const char *url = json_object_get_string(url_obj);
 
                 if (title && url && strlen(title) > 0 && strlen(url) > 0) {
-                    add_link(out, title, "", url, link_set);
+                    add_link(out, title, "", url, search);
                 }
             }
         }
@@ -5411,7 +11749,7 @@ static const char *foodnetwork_js_code =
 // ------------------------------
 
 // FoodNetwork C Parser 
-static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_foodnetwork(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
     const char *alt_terms[] = {
@@ -5430,116 +11768,14 @@ static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_s
     for (int i = 0; i < num_terms; ++i) {
         const char *term = use_alternates ? alt_terms[i] : search_term;
 
-        char temp_filename[512];
-
-#ifdef _WIN32
-        char temp_path[MAX_PATH];
-        if (!GetTempPathA(MAX_PATH, temp_path)) {
-            fprintf(stderr, "Failed to get Windows temp path.\n");
-            continue;
-        }
-
-        if (!GetTempFileNameA(temp_path, "fn", 0, temp_filename)) {
-            fprintf(stderr, "Failed to get Windows temp file name.\n");
-            continue;
-        }
-
-        FILE *tmp_fp = fopen(temp_filename, "w");
-        if (!tmp_fp) {
-            fprintf(stderr, "Failed to create temp JS file.\n");
-            DeleteFileA(temp_filename);
-            continue;
-        }
-#else
-        if (snprintf(temp_filename, sizeof(temp_filename), "/tmp/foodnetwork_XXXXXX.js") >= (int)sizeof(temp_filename)) {
-            fprintf(stderr, "Temp filename buffer too small.\n");
-            continue;
-        }
-
-        int fd = mkstemps(temp_filename, 3);  // ".js"
-        if (fd == -1) {
-            perror("mkstemps");
-            continue;
-        }
-
-        FILE *tmp_fp = fdopen(fd, "w");
-        if (!tmp_fp) {
-            perror("fdopen");
-            close(fd);
-            unlink(temp_filename);
-            continue;
-        }
-#endif
-
-        fputs(foodnetwork_js_code, tmp_fp);
-        fclose(tmp_fp);
-
-        char command[2048];
-
-#ifdef _WIN32
-        const char *appdata = getenv("APPDATA");
-        if (!appdata) {
-            fprintf(stderr, "APPDATA environment variable not set.\n");
-            DeleteFileA(temp_filename);
-            continue;
-        }
-
-        const char *program_files = getenv("ProgramFiles");
-
-        char node_path_full[MAX_PATH];
-        char node_exe[MAX_PATH];
-
-        snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
-        if (program_files) {
-            snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-        } else {
-            snprintf(node_exe, sizeof(node_exe), "node");
-        }
-
-        int written = snprintf(command, sizeof(command),
-            "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-            node_path_full, node_exe, temp_filename, term);
-
-        if (written < 0 || written >= (int)sizeof(command)) {
-            fprintf(stderr, "Command buffer too small or error during formatting.\n");
-            DeleteFileA(temp_filename);
-            continue;
-        }
-#else
-        const char *node_path = "/opt/homebrew/lib/node_modules";
-        int written = snprintf(command, sizeof(command),
-            "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-            node_path, temp_filename, term);
-
-        if (written < 0 || written >= (int)sizeof(command)) {
-            fprintf(stderr, "Command buffer too small or error during formatting.\n");
-            unlink(temp_filename);
-            continue;
-        }
-#endif
-
-        FILE *fp = popen(command, "r");
-        if (!fp) {
-#ifdef _WIN32
-            DeleteFileA(temp_filename);
-#else
-            unlink(temp_filename);
-#endif
+        // Run the embedded script in the persistent scraper worker
+        char *output = run_site_script(search, "foodnetwork", foodnetwork_js_code, term, NULL);
+        if (!output) {
             continue;
         }
 
-        char buffer[8192];
-        size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-        buffer[len] = '\0';
-        pclose(fp);
-
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-
-        struct json_object *parsed_json = json_tokener_parse(buffer);
+        struct json_object *parsed_json = json_tokener_parse(output);
+        g_free(output);
         if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
             json_object_put(parsed_json);
             continue;
@@ -5557,7 +11793,7 @@ static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_s
 
                 if (title && url && strlen(title) > 0 && strlen(url) > 0 &&
                     !g_hash_table_contains(seen_links, url)) {
-                    add_link(out, title, "", url, link_set);
+                    add_link(out, title, "", url, search);
                     g_hash_table_insert(seen_links, g_strdup(url), GINT_TO_POINTER(1));
                 }
             }
@@ -5567,7 +11803,7 @@ static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_s
     }
 
     if (*out == NULL) {
-        add_link(out, "Click to see FoodNetwork Search Page", "", "https://www.foodnetwork.com/search/", link_set);
+        add_fallback_link(out, "Click to see FoodNetwork Search Page", "https://www.foodnetwork.com/search/", search);
     }
 
     g_hash_table_destroy(seen_links);
@@ -5597,7 +11833,6 @@ static void parse_foodnetwork(GumboNode *unused, GList **out, GHashTable *link_s
 
 static const char *thekitchn_combined_js_code =
 "const { chromium } = require('playwright');\n"
-"const fs = require('fs');\n"
 "(async () => {\n"
 "  try {\n"
 "    const term = process.argv[2] || 'chili';\n"
@@ -5678,7 +11913,7 @@ static const char *thekitchn_combined_js_code =
 "    const term = process.argv[2] || 'chili';\n"
 "    const fallbackURL = `https://www.thekitchn.com/search?q=${encodeURIComponent(term)}`;\n"
 "    const fallbackTitle = `Search for \\\"${term}\\\" on TheKitchn.com Website`;\n"
-"    console.log(JSON.stringify([{ title: fallbackTitle, url: fallbackURL }]));\n"
+"    console.log(JSON.stringify([{ title: fallbackTitle, url: fallbackURL, fallback: true }]));\n"
 "    process.exit(1);\n"
 "  }\n"
 "})();\n";
@@ -5698,13 +11933,12 @@ static const char *thekitchn_combined_js_code =
 //           fingerprint differences, GPU rendering, or event timing on macOS.
 //   - Linux: Untested, but uses the same hidden, headful Chromium approach.
 // Implementation details:
-//   1. Creates a temporary JS file containing the combined scraper code.
-//   2. Sets NODE_PATH dynamically via 'npm root -g' to resolve global modules.
-//   3. Prints PATH and Node.js version for debug.
-//   4. Launches Chromium in non-headless mode to avoid bot detection, keeping
-//      the window hidden.
-//   5. Detects and interacts with "Press and Hold" challenges where possible.
-//   6. Parses JSON output from Node.js; on error, falls back to search link.
+//   1. Sends the combined scraper code to the persistent scraper worker,
+//      which resolves global Node modules once at startup.
+//   2. Launches Chromium in non-headless mode to avoid bot detection, keeping
+//      the window hidden (the worker keeps this headful browser warm too).
+//   3. Detects and interacts with "Press and Hold" challenges where possible.
+//   4. Parses JSON output from Node.js; on error, falls back to search link.
 // Failure handling:
 //   - If Node.js is missing, PATH is wrong, dependencies are not installed,
 //     or JSON is invalid, a fallback search link is returned.
@@ -5728,133 +11962,15 @@ static const char *thekitchn_combined_js_code =
 // into human-readable info for crash logs and debug traces, and they
 // provide insights into application stability and bugs.
 
-static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_thekitchn(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
-    char js_path[1024];
-    char command[2048];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "tkp", 0, js_path)) {
-        fprintf(stderr, "Failed to get temp file name for script.\n");
-        return;
-    }
-
-    FILE *fp = fopen(js_path, "w");
-    if (!fp) {
-        fprintf(stderr, "Failed to create JS temp file.\n");
-        DeleteFileA(js_path);
-        return;
-    }
-#else
-    if (snprintf(js_path, sizeof(js_path), "/tmp/thekitchn_XXXXXX.js") >= (int)sizeof(js_path)) {
-        fprintf(stderr, "JS path buffer too small.\n");
-        return;
-    }
-
-    int fd = mkstemps(js_path, 3);
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-
-    FILE *fp = fdopen(fd, "w");
-    if (!fp) {
-        perror("fdopen");
-        close(fd);
-        unlink(js_path);
-        return;
-    }
-#endif
-
-    // Write combined scraper JS to temp file
-    fputs(thekitchn_combined_js_code, fp);
-    fclose(fp);
-
-    // === Automatic Node.js environment setup ===
-
-    // Get global npm root directory and set NODE_PATH
-    char node_path[512] = {0};
-    FILE *npm_fp = popen("npm root -g", "r");
-    if (npm_fp) {
-        if (fgets(node_path, sizeof(node_path), npm_fp)) {
-            size_t len = strlen(node_path);
-            if (len > 0 && node_path[len - 1] == '\n')
-                node_path[len - 1] = '\0'; // strip newline
-
-#ifdef _WIN32
-            if (_putenv_s("NODE_PATH", node_path) != 0) {
-                fprintf(stderr, "[WARNING]: Failed to set NODE_PATH on Windows\n");
-            } else {
-                fprintf(stderr, "[C Info]: NODE_PATH set to: %s\n", node_path);
-            }
-#else
-            if (setenv("NODE_PATH", node_path, 1) != 0) {
-                perror("[WARNING]: Failed to set NODE_PATH");
-            } else {
-                fprintf(stderr, "[Info]: NODE_PATH set to: %s\n", node_path);
-            }
-#endif
-        } else {
-            fprintf(stderr, "[WARNING]: Could not read output from 'npm root -g'\n");
-        }
-        pclose(npm_fp);
-    } else {
-        fprintf(stderr, "[WARNING]: Could not determine global npm root for NODE_PATH\n");
-    }
-
-    // Debug current PATH environment variable
-    const char *path_env = getenv("PATH");
-    if (path_env) {
-        fprintf(stderr, "[C Info]: Current PATH: %s\n", path_env);
-    } else {
-        fprintf(stderr, "[WARNING]: PATH environment variable not set\n");
-    }
-
-    // Verify Node.js version
-    FILE *node_version_fp = popen("node --version", "r");
-    if (node_version_fp) {
-        char node_version[128];
-        if (fgets(node_version, sizeof(node_version), node_version_fp)) {
-            size_t len = strlen(node_version);
-            if (len > 0 && node_version[len - 1] == '\n') {
-                node_version[len - 1] = '\0'; // strip newline
-            }
-            fprintf(stderr, "[Info]: Node.js version: %s\n", node_version);
-        } else {
-            fprintf(stderr, "[WARNING]: Could not read Node.js version output\n");
-        }
-        pclose(node_version_fp);
-    } else {
-        fprintf(stderr, "[WARNING]: Failed to run 'node --version'\n");
-    }
-
-    // Build Node.js command to run the combined script with search_term argument
-#ifdef _WIN32
-    if (snprintf(command, sizeof(command), "cmd /c node \"%s\" \"%s\"", js_path, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "Command buffer too small.\n");
-        DeleteFileA(js_path);
-        return;
-    }
-#else
-    if (snprintf(command, sizeof(command), "node \"%s\" \"%s\"", js_path, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "Command buffer too small.\n");
-        unlink(js_path);
-        return;
-    }
-#endif
-
-    FILE *pipe = popen(command, "r");
-    if (!pipe) {
+    // Run the embedded script in the persistent scraper worker
+    char *output = run_site_script(search, "thekitchn", thekitchn_combined_js_code, search_term, NULL);
+    if (!output) {
         fprintf(stderr,
             "\n[Recipe Finder Error]\n"
-            "TheKitchn recipe parser failed to run Node.js command.\n"
+            "TheKitchn recipe parser failed to run its Node.js script.\n"
             "Requirements:\n"
             "  - Node.js installed\n"
             "  - Playwright installed: npm install -g playwright\n"
@@ -5868,35 +11984,19 @@ static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set
         snprintf(fallback_url, sizeof(fallback_url),
                  "https://www.thekitchn.com/search?q=%s", search_term);
 
-        add_link(out, fallback_title, "", fallback_url, link_set);
-
-#ifdef _WIN32
-        DeleteFileA(js_path);
-#else
-        unlink(js_path);
-#endif
+        add_fallback_link(out, fallback_title, fallback_url, search);
         return;
     }
 
-    char buffer[32768];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, pipe);
-    buffer[len] = '\0';
-    pclose(pipe);
-
-#ifdef _WIN32
-    DeleteFileA(js_path);
-#else
-    unlink(js_path);
-#endif
-
     // Parse JSON results
-    struct json_object *parsed_json = json_tokener_parse(buffer);
+    struct json_object *parsed_json = json_tokener_parse(output);
     if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
         fprintf(stderr,
             "\n[Recipe Finder Error]\n"
             "TheKitchn parser returned invalid JSON.\n"
             "Node.js output was:\n%s\n"
-            "Defaulting to TheKitchn search page...\n", buffer);
+            "Defaulting to TheKitchn search page...\n", output);
+        g_free(output);
 
         char fallback_title[256];
         char fallback_url[512];
@@ -5905,10 +12005,12 @@ static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set
         snprintf(fallback_url, sizeof(fallback_url),
                  "https://www.thekitchn.com/search?q=%s", search_term);
 
-        add_link(out, fallback_title, "", fallback_url, link_set);
+        add_fallback_link(out, fallback_title, fallback_url, search);
         return;
     }
 
+    g_free(output);
+
     // Process parsed JSON array to add individual recipe links
     size_t n = json_object_array_length(parsed_json);
     for (size_t i = 0; i < n; ++i) {
@@ -5919,7 +12021,11 @@ static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set
             json_object_object_get_ex(item, "url", &url_obj)) {
             const char *title = json_object_get_string(title_obj);
             const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
+            if (json_record_is_fallback(item)) {
+                add_fallback_link(out, title, url, search);
+            } else {
+                add_link(out, title, "", url, search);
+            }
         }
     }
 
@@ -5934,7 +12040,7 @@ static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set
         snprintf(fallback_url, sizeof(fallback_url),
                  "https://www.thekitchn.com/search?q=%s", search_term);
 
-        add_link(out, fallback_title, "", fallback_url, link_set);
+        add_fallback_link(out, fallback_title, fallback_url, search);
     }
 }
 
@@ -5946,7 +12052,7 @@ static void parse_thekitchn(GumboNode *unused, GList **out, GHashTable *link_set
 
 // NY Times Cooking Recipe C Parser (does not need JavaScript)
 
-static void parse_nyt(GumboNode *root, GList **links, GHashTable *link_set, const char *search_term) {
+static void parse_nyt(GumboNode *root, GList **links, SearchContext *search, const char *search_term) {
     (void)root;
 
     // Default to "chicken" if no search term provided
@@ -5960,103 +12066,53 @@ static void parse_nyt(GumboNode *root, GList **links, GHashTable *link_set, cons
     char search_url[512];
     snprintf(search_url, sizeof(search_url), "https://cooking.nytimes.com/search?q=%s", encoded_term);
 
-    // Call external Node.js scraper script with term as argument
-    // (Assuming you have a Node script like thekitchn does, for NYT)
-    // For demonstration, assume command string:
-    char command[1024];
-#ifdef _WIN32
-    snprintf(command, sizeof(command), "cmd /c node nyt_cooking_scraper.js \"%s\"", term);
-#else
-    snprintf(command, sizeof(command), "node nyt_cooking_scraper.js \"%s\"", term);
-#endif
+    // Run the external Node.js scraper script with the term as its own
+    // argument (no shell, so quotes or $(...) in a search are just text).
+    // Node is the executable resolved at startup (see runtime_env_init)
+    const gchar *argv[] = { runtime_env_node(), "nyt_cooking_scraper.js", term, NULL };
+    gchar *output = NULL;
+    gint status = 0;
+    GError *error = NULL;
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
+    if (!g_spawn_sync(NULL, (gchar **)argv, NULL, G_SPAWN_SEARCH_PATH, NULL, NULL,
+                      &output, NULL, &status, &error)) {
         fprintf(stderr,
-            "[ERROR] Failed to run Node.js scraper for NYT Cooking.\n"
-            "Please ensure Node.js and dependencies are installed.\n");
+            "[ERROR] Failed to run Node.js scraper for NYT Cooking: %s\n"
+            "Please ensure Node.js and dependencies are installed.\n", error->message);
+        g_error_free(error);
 
         // Fallback with search term included
-        const char *term = (search_term && *search_term) ? search_term : "chicken";
-        char *fallback_link = g_strdup_printf(
-            "Click to see %s recipes on the NY Times Cooking Website\x1f%s",
-            term, search_url);
-        *links = g_list_prepend(*links, fallback_link);
+        char *fallback_title = g_strdup_printf("Click to see %s recipes on the NY Times Cooking Website", term);
+        add_fallback_link(links, fallback_title, search_url, search);
+        g_free(fallback_title);
         g_free(encoded_term);
         return;
     }
 
-    char buffer[32768];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    int status = pclose(fp);
+    // Read the scraper's output through the record reader; there is no
+    // limit on how much the script may print
+    SiteRecordContext records = { links, search, "https://cooking.nytimes.com", FALSE, 0 };
+    JsonRecordStream *stream = json_record_stream_new(site_record_add_link, &records);
+
+    size_t total = output ? strlen(output) : 0;
+    json_record_stream_feed(stream, output, total);
+    g_free(output);
+    gboolean valid = json_record_stream_finish(stream);
+    json_record_stream_free(stream);
 
-    if (status != 0 || len == 0) {
+    if (status != 0 || total == 0) {
         fprintf(stderr, "[WARNING] Node.js scraper returned no data or failed.\n");
-    // Fallback link with search term included in the button text
-    char *fallback_link = g_strdup_printf(
-        "Click to see %s on the NY Times Cooking Website\x1f%s",
-        search_term,
-        search_url);
-    *links = g_list_prepend(*links, fallback_link);
-    g_free(encoded_term);
-    return;
     }
-
-
-    // Parse JSON output from Node.js scraper
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
+    if (!valid) {
         fprintf(stderr, "[WARNING] Invalid JSON output from Node.js scraper.\n");
-        char *fallback_link = g_strdup_printf(
-            "Click to see %s\x1f%s",
-            " on the NY Times Cooking Website", search_url);
-        *links = g_list_prepend(*links, fallback_link);
-        g_free(encoded_term);
-        if (parsed_json) json_object_put(parsed_json);
-        return;
-    }
-
-    // Extract recipe titles and URLs from JSON array
-    size_t n = json_object_array_length(parsed_json);
-    fprintf(stderr, "[DEBUG] Found %zu NYT recipe results\n", n);
-
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj = NULL, *url_obj = NULL;
-
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-
-            const char *title = json_object_get_string(title_obj);
-            const char *url_path = json_object_get_string(url_obj);
-            if (!title || !url_path) continue;
-
-            char *full_url = g_strdup_printf("https://cooking.nytimes.com%s", url_path);
-
-            if (!g_hash_table_contains(link_set, full_url)) {
-                char *link_data = g_strdup_printf("%s\x1f%s", title, full_url);
-                *links = g_list_prepend(*links, link_data);
-                g_hash_table_add(link_set, g_strdup(full_url));
-                fprintf(stderr, "[DEBUG] Added NYT recipe: \"%s\" [%s]\n", title, full_url);
-                g_free(link_data);
-            }
-
-            g_free(full_url);
-        }
     }
-
-    json_object_put(parsed_json);
+    fprintf(stderr, "[DEBUG] Found %u NYT recipe results\n", records.records);
 
     if (*links == NULL) {
         fprintf(stderr, "[INFO] No NY Times links found, adding fallback.\n");
-        char *fallback_link = g_strdup_printf(
-            "Click to see %s\x1f%s",
-            " on the NY Times Cooking Website", search_url);
-        *links = g_list_prepend(*links, fallback_link);
+        add_fallback_link(links, "Click to see recipes on the NY Times Cooking Website", search_url, search);
     }
 
-    *links = g_list_reverse(*links);
     g_free(encoded_term);
 }
 
@@ -6095,7 +12151,7 @@ static char *url_encode(const char *str) {
 // This function uses a plural-to-singular search-term conversion to increase
 // the chances of getting recipe hits on Saveur.
 
-static void parse_saveur(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_saveur(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
     printf("\nStarting parse_saveur()\n");
@@ -6112,33 +12168,12 @@ static void parse_saveur(GumboNode *unused, GList **out, GHashTable *link_set, c
     snprintf(url, sizeof(url), "https://www.saveur.com/search/%s", encoded_term);
     free(encoded_term);
 
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        fprintf(stderr, "Failed to initialize curl.\n");
-        return;
-    }
-
-    char *html = calloc(1, 1);  // Empty string to start
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_saveur_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &html);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
-
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-
-    if (res != CURLE_OK || !html || strlen(html) == 0) {
+    // Stream the page through the anchor scanner (no full-page buffer or DOM)
+    AnchorParseContext ctx = { out, search, term, FALSE };
+    if (!http_stream_anchors(url, 10L, search, saveur_anchor_cb, &ctx)) {
         fprintf(stderr, "Failed to fetch Saveur page.\n");
-        free(html);
-        return;
     }
 
-    GumboOutput *output = gumbo_parse(html);
-    search_for_saveur_links(output->root, out, link_set);
-    gumbo_destroy_output(&kGumboDefaultOptions, output);
-    free(html);
-
     if (*out == NULL) {
         char *encoded_term_fallback = url_encode(term);
         char fallback_url[1024];
@@ -6148,7 +12183,7 @@ static void parse_saveur(GumboNode *unused, GList **out, GHashTable *link_set, c
         char link_text[256];
         snprintf(link_text, sizeof(link_text), "Search Saveur.com for %s recipes", term);
 
-        add_link(out, link_text, "", fallback_url, link_set);
+        add_fallback_link(out, link_text, fallback_url, search);
     }
 
     printf("Finished parse_saveur()\n");
@@ -6156,77 +12191,54 @@ static void parse_saveur(GumboNode *unused, GList **out, GHashTable *link_set, c
 
 // --------------------
 
-// Saveur Helper: Write libcurl data into a dynamic buffer.
-// This handles chunks of data as they are received from an HTTP request.
-// It accumulates chunks of downloaded HTML data from libcurl into a
-// dynamically growing C string buffer that resizes as more data is received.
-
-static size_t write_saveur_callback(void *contents, size_t size, size_t nmemb, void *userp) {
-    size_t realsize = size * nmemb;
-    char **response_ptr = (char **)userp;
-
-    char *new_buffer = realloc(*response_ptr, strlen(*response_ptr) + realsize + 1);
-    if (!new_buffer) return 0;
-
-    *response_ptr = new_buffer;
-    strncat(*response_ptr, contents, realsize);
-    return realsize;
-}
-
-// --------------------
-
 
-// Saveur Helper: Recursively search GumboNode tree for recipe/article links
-static void search_for_saveur_links(GumboNode *node, GList **out, GHashTable *link_set) {
-    if (node->type != GUMBO_NODE_ELEMENT) return;
+// Saveur Helper: Handle one streamed anchor and keep recipe/article links
+static void saveur_anchor_cb(const AnchorLink *link, gpointer user_data) {
+    AnchorParseContext *ctx = user_data;
+    const char *url = link->href;
 
-    if (node->v.element.tag == GUMBO_TAG_A) {
-        GumboAttribute *href = gumbo_get_attribute(&node->v.element.attributes, "href");
-        if (href && (strstr(href->value, "/recipe/") || strstr(href->value, "/article/"))) {
-            const char *url = href->value;
-
-            // Extract visible text (if any)
-            GString *title_buf = g_string_new(NULL);
-            extract_saveur_text(node, title_buf);
-
-            const char *title = NULL;
-            if (title_buf->len > 0) {
-                title = g_strstrip(title_buf->str);
-            } else {
-                // Fallback: extract slug from URL
-                const char *last_slash = strrchr(url, '/');
-                if (last_slash && *(last_slash + 1) == '\0') {
-                    // URL ends with '/', so move back to previous slash
-                    const char *prev = last_slash - 1;
-                    while (prev > url && *prev != '/') prev--;
-                    last_slash = prev;
-                }
+    if (!strstr(url, "/recipe/") && !strstr(url, "/article/"))
+        return;
 
-                if (last_slash) {
-                    char slug[256];
-                    snprintf(slug, sizeof(slug), "%s", last_slash + 1);
+    // Visible text of the anchor (already trimmed by the scanner)
+    GString *title_buf = g_string_new(link->text);
 
-                    // Strip trailing slash from slug
-                    size_t len = strlen(slug);
-                    if (len > 0 && slug[len - 1] == '/') {
-                        slug[len - 1] = '\0';
-                    }
+    const char *title = NULL;
+    if (title_buf->len > 0) {
+        title = title_buf->str;
+    } else {
+        // Fallback: extract slug from URL
+        const char *last_slash = strrchr(url, '/');
+        if (last_slash && *(last_slash + 1) == '\0') {
+            // URL ends with '/', so move back to previous slash
+            const char *prev = last_slash - 1;
+            while (prev > url && *prev != '/') prev--;
+            last_slash = prev;
+        }
 
-                    // Replace dashes with spaces
-                    for (char *p = slug; *p; p++) {
-                        if (*p == '-') *p = ' ';
-                    }
+        if (last_slash) {
+            char slug[256];
+            snprintf(slug, sizeof(slug), "%s", last_slash + 1);
 
-                    // Capitalize first letter of each word
-                    bool capitalize_next = true;
-                    for (char *p = slug; *p; p++) {
-                    if (capitalize_next && isalpha((unsigned char)*p)) {
-                        *p = toupper((unsigned char)*p);
-                          capitalize_next = false;
+            // Strip trailing slash from slug
+            size_t len = strlen(slug);
+            if (len > 0 && slug[len - 1] == '/') {
+                slug[len - 1] = '\0';
+            }
 
-                    } else {
+            // Replace dashes with spaces
+            for (char *p = slug; *p; p++) {
+                if (*p == '-') *p = ' ';
+            }
 
-                          *p = tolower((unsigned char)*p);
+            // Capitalize first letter of each word
+            bool capitalize_next = true;
+            for (char *p = slug; *p; p++) {
+                if (capitalize_next && isalpha((unsigned char)*p)) {
+                    *p = toupper((unsigned char)*p);
+                    capitalize_next = false;
+                } else {
+                    *p = tolower((unsigned char)*p);
                 }
 
                 if (*p == ' ') {
@@ -6234,55 +12246,32 @@ static void search_for_saveur_links(GumboNode *node, GList **out, GHashTable *li
                 }
             }
 
-                    title = slug;
-                    g_string_assign(title_buf, slug);
+            // Keep the title in title_buf; slug goes out of scope here
+            g_string_assign(title_buf, slug);
+            title = title_buf->str;
 
-                } else {
+        } else {
 
-                    // Fallback title if URL can't be parsed
-                    title = "Untitled";
-                }
-            }
+            // Fallback title if URL can't be parsed
+            title = "Untitled";
+        }
+    }
 
     // Debug prints
     printf("[SAVEUR DEBUG -- RAW URL]: \"%s\"\n", url);
     printf("[SAVEUR DEBUG -- ENHANCED TITLE]: \"%s\"\n", title);
 
-            // Normalize and add the URL
-            if (strstr(url, "https://") || strstr(url, "http://")) {
-                add_link(out, title, "", url, link_set);
-            } else {
-                char full_url[1024];
-                snprintf(full_url, sizeof(full_url), "https://www.saveur.com%s", url);
-                add_link(out, title, "", full_url, link_set);
-            }
-
-            g_string_free(title_buf, TRUE);
-        }
-    }
-
-    // Recurse into children
-    GumboVector *children = &node->v.element.children;
-    for (unsigned int i = 0; i < children->length; ++i) {
-        search_for_saveur_links(children->data[i], out, link_set);
+    // Normalize and add the URL
+    if (strstr(url, "https://") || strstr(url, "http://")) {
+        add_link(ctx->out, title, "", url, ctx->search);
+    } else {
+        char full_url[1024];
+        snprintf(full_url, sizeof(full_url), "https://www.saveur.com%s", url);
+        add_link(ctx->out, title, "", full_url, ctx->search);
     }
-}
-
-
-// --------------------
-
 
-// Saveur Helper: Recursively extract visible text from a GumboNode
-//  (e.g. inside <a>)  to build proper recipe link titles.
-static void extract_saveur_text(GumboNode *node, GString *out) {
-    if (node->type == GUMBO_NODE_TEXT) {
-        g_string_append(out, node->v.text.text);
-    } else if (node->type == GUMBO_NODE_ELEMENT || node->type == GUMBO_NODE_TEMPLATE) {
-        GumboVector *children = &node->v.element.children;
-        for (unsigned int i = 0; i < children->length; ++i) {
-            extract_saveur_text(children->data[i], out);
-        }
-    }
+    g_string_free(title_buf, TRUE);
+    ctx->found_any = TRUE;
 }
 
 
@@ -6332,106 +12321,22 @@ static const char *seriouseats_js_code =
 "  });\n"
 "\n"
 "  console.log(JSON.stringify(results, null, 2));\n"
-"  await browser.close();\n"
-"})().catch(() => process.exit(1));\n";
-
-
-// --------------------------------
-
-// Serious Eats Parser
-static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char temp_filename[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-
-    if (!GetTempFileNameA(temp_path, "se", 0, temp_filename)) {
-        fprintf(stderr, "Failed to get Windows temp file name.\n");
-        return;
-    }
-
-    FILE *tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        fprintf(stderr, "Failed to create temp JS file.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    if (snprintf(temp_filename, sizeof(temp_filename), "/tmp/seriouseats_XXXXXX.js") >= (int)sizeof(temp_filename)) {
-        fprintf(stderr, "Temp filename buffer too small.\n");
-        return;
-    }
-
-    int fd = mkstemps(temp_filename, 3); // ".js"
-    if (fd == -1) {
-        perror("mkstemps");
-        return;
-    }
-
-    FILE *tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("fdopen");
-        close(fd);
-        unlink(temp_filename);
-        return;
-    }
-#endif
-
-    fputs(seriouseats_js_code, tmp_fp);
-    fclose(tmp_fp);
-
-    // Command buffer to execute Node.js
-    char command[2048];
-
-#ifdef _WIN32
-    const char *appdata = getenv("APPDATA");
-    if (!appdata) {
-        fprintf(stderr, "APPDATA environment variable not set.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-
-    const char *program_files = getenv("ProgramFiles");
+"  await browser.close();\n"
+"})().catch(() => process.exit(1));\n";
 
-    char node_path_full[MAX_PATH];
-    snprintf(node_path_full, sizeof(node_path_full), "%s\\npm\\node_modules", appdata);
 
-    char node_exe[MAX_PATH];
-    if (program_files) {
-        snprintf(node_exe, sizeof(node_exe), "\"%s\\nodejs\\node.exe\"", program_files);
-    } else {
-        snprintf(node_exe, sizeof(node_exe), "node");
-    }
+// --------------------------------
 
-    if (snprintf(command, sizeof(command),
-                 "cmd /c \"set NODE_PATH=%s&& %s \"%s\" \"%s\"\"",
-                 node_path_full, node_exe, temp_filename, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "Command buffer too small.\n");
-        DeleteFileA(temp_filename);
-        return;
-    }
-#else
-    const char *node_path = "/opt/homebrew/lib/node_modules";
-    if (snprintf(command, sizeof(command),
-                 "NODE_PATH=\"%s\" node \"%s\" \"%s\"",
-                 node_path, temp_filename, search_term) >= (int)sizeof(command)) {
-        fprintf(stderr, "Command buffer too small.\n");
-        unlink(temp_filename);
-        return;
-    }
-#endif
+// Serious Eats Parser
+static void parse_seriouseats(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
+    // Run the embedded script in the persistent scraper worker
+    char *output = run_site_script(search, "seriouseats", seriouseats_js_code, search_term, NULL);
+    if (!output) {
         fprintf(stderr,
             "\n[Recipe Finder Error]\n"
-            "Serious Eats parser failed to run Node.js command.\n"
+            "Serious Eats parser failed to run its Node.js script.\n"
 #ifdef _WIN32
             "Please ensure:\n"
             "  - Node.js is installed (https://nodejs.org)\n"
@@ -6447,28 +12352,12 @@ static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_s
 #endif
             "Defaulting to Serious Eats search page...\n\n");
 
-#ifdef _WIN32
-        DeleteFileA(temp_filename);
-#else
-        unlink(temp_filename);
-#endif
-
-        add_link(out, "Click to see Serious Eats Search Page", "", "https://www.seriouseats.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Serious Eats Search Page", "https://www.seriouseats.com/recipes", search);
         return;
     }
 
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-    pclose(fp);
-
-#ifdef _WIN32
-    DeleteFileA(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
+    struct json_object *parsed_json = json_tokener_parse(output);
+    g_free(output);
     if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
         fprintf(stderr,
             "\n[Recipe Finder Error]\n"
@@ -6480,7 +12369,7 @@ static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_s
             "  - Node is available in PATH\n\n"
             "Defaulting to Serious Eats search page...\n\n");
 
-        add_link(out, "Click to see Serious Eats Search Page", "", "https://www.seriouseats.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Serious Eats Search Page", "https://www.seriouseats.com/recipes", search);
         return;
     }
 
@@ -6495,7 +12384,7 @@ static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_s
             const char *url = json_object_get_string(url_obj);
 
             if (title && url && strlen(title) > 0 && strlen(url) > 0) {
-                add_link(out, title, "", url, link_set);
+                add_link(out, title, "", url, search);
             }
         }
     }
@@ -6503,7 +12392,7 @@ static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_s
     json_object_put(parsed_json);
 
     if (*out == NULL) {
-        add_link(out, "Click to see Serious Eats Search Page", "", "https://www.seriouseats.com/recipes", link_set);
+        add_fallback_link(out, "Click to see Serious Eats Search Page", "https://www.seriouseats.com/recipes", search);
     }
 }
 
@@ -6514,33 +12403,33 @@ static void parse_seriouseats(GumboNode *unused, GList **out, GHashTable *link_s
 
 
 // SimplyRecipes recipe parser (No JavaScript used)
-// Adds recipe links found in anchor tags with href containing
-//    "simplyrecipes.com/recipes/"
-// Adds fallback link once per search via added_fallback flag from caller.
+// Streams the search page and adds recipe links found in anchor tags with
+//    href containing "simplyrecipes.com/recipes/"
+
+static void parse_simplyrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-static void parse_simplyrecipes(GumboNode *n, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)search_term;  // Silence unused parameter warning
+    AnchorParseContext ctx = { out, search, search_term, FALSE };
 
-    if (n->type != GUMBO_NODE_ELEMENT)
-        return;
+    char *encoded = url_encode(search_term ? search_term : "");
+    char url[512];
+    snprintf(url, sizeof(url), "https://www.simplyrecipes.com/search?q=%s", encoded);
+    g_free(encoded);
 
-    if (n->v.element.tag == GUMBO_TAG_A) {
-        GumboAttribute *href = gumbo_get_attribute(&n->v.element.attributes, "href");
-        if (href && strstr(href->value, "simplyrecipes.com/recipes/")) {
-            const char *title = href->value;
-            if (n->v.element.children.length > 0) {
-                GumboNode *c = (GumboNode *)n->v.element.children.data[0];
-                if (c->type == GUMBO_NODE_TEXT)
-                    title = c->v.text.text;
-            }
-            add_link(out, title, "", href->value, link_set);
-        }
-    }
+    http_stream_anchors(url, 15L, search, simplyrecipes_anchor_cb, &ctx);
+}
 
-    // Recurse through children
+// SimplyRecipes Helper: Handle one streamed anchor.
+// The title is the anchor's text when that text is its first child,
+//    otherwise the URL itself.
+static void simplyrecipes_anchor_cb(const AnchorLink *link, gpointer user_data) {
+    AnchorParseContext *ctx = user_data;
 
-    for (unsigned i = 0; i < n->v.element.children.length; ++i)
-        parse_simplyrecipes((GumboNode *)n->v.element.children.data[i], out, link_set, search_term);
+    if (strstr(link->href, "simplyrecipes.com/recipes/")) {
+        const char *title = link->direct_text ? link->direct_text : link->href;
+        add_link(ctx->out, title, "", link->href, ctx->search);
+        ctx->found_any = TRUE;
+    }
 }
 
 
@@ -6550,155 +12439,22 @@ static void parse_simplyrecipes(GumboNode *n, GList **out, GHashTable *link_set,
 
 
 
-// Smitten Kitchen JavaScript
-
-const char *smittenkitchen_js_code =
-"const axios = require('axios');\n"
-"const cheerio = require('cheerio');\n"
-"\n"
-"async function searchSmittenKitchen(term) {\n"
-"  const url = `https://smittenkitchen.com/?s=${encodeURIComponent(term)}`;\n"
-"  try {\n"
-"    const { data } = await axios.get(url);\n"
-"    const $ = cheerio.load(data);\n"
-"    const results = [];\n"
-"\n"
-"    $('.post-list article').each((i, elem) => {\n"
-"      const title = $(elem).find('h2.entry-title a').text().trim();\n"
-"      const url = $(elem).find('h2.entry-title a').attr('href');\n"
-"      if (title && url) {\n"
-"        results.push({ title, url });\n"
-"      }\n"
-"    });\n"
-"\n"
-"    return results;\n"
-"  } catch (e) {\n"
-"    console.error('[SmittenKitchen] Search failed:', e.message);\n"
-"    return [];\n"
-"  }\n"
-"}\n"
-"\n"
-"if (require.main === module) {\n"
-"  const term = process.argv[2] || '';\n"
-"  searchSmittenKitchen(term).then(results => {\n"
-"    console.log(JSON.stringify(results));\n"
-"  });\n"
-"}\n";
-
-
-// --------------------------------
-
-
 // Smitten Kitchen C function
+// The search page is plain server-rendered HTML, so it is read from the
+// prefetched Gumbo tree with the selectors the old axios + cheerio script
+// used (no Node.js job).
 
-static void parse_smittenkitchen(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char script_path[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-    if (!GetTempFileNameA(temp_path, "smk", 0, script_path)) {
-        fprintf(stderr, "Failed to get temp file name for smittenkitchen script.\n");
-        return;
-    }
-    FILE *fp = fopen(script_path, "w");
-    if (!fp) {
-        fprintf(stderr, "Failed to create temp JS file for smittenkitchen.\n");
-        return;
-    }
-    fputs(smittenkitchen_js_code, fp);
-    fclose(fp);
-    char command[1024];
-    snprintf(command, sizeof(command), "cmd /c node \"%s\" \"%s\"", script_path, search_term);
-#else
-    strcpy(script_path, "/tmp/smittenkitchen_XXXXXX.js");
-    int fd = mkstemps(script_path, 3);
-    if (fd == -1) {
-        perror("mkstemps (smittenkitchen)");
-        return;
-    }
-    FILE *fp = fdopen(fd, "w");
-    if (!fp) {
-        perror("fdopen (smittenkitchen)");
-        close(fd);
-        return;
-    }
-    fputs(smittenkitchen_js_code, fp);
-    fclose(fp);
-    char command[1024];
-    snprintf(command, sizeof(command), "node \"%s\" \"%s\"", script_path, search_term);
-#endif
-
-    FILE *pipe = popen(command, "r");
-    if (!pipe) {
-        fprintf(stderr, "[SmittenKitchen] Failed to run Node.js command.\n");
-
-        char fallback_url[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://smittenkitchen.com/?s=%s", search_term);
-        char fallback_title[512];
-        snprintf(fallback_title, sizeof(fallback_title), "Search for %s on Smitten Kitchen Website", search_term);
-        add_link(out, fallback_title, "", fallback_url, link_set);
-
-#ifdef _WIN32
-        DeleteFileA(script_path);
-#else
-        unlink(script_path);
-#endif
-        return;
-    }
-
-    char buffer[32768];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, pipe);
-    buffer[len] = '\0';
-    pclose(pipe);
-
-#ifdef _WIN32
-    DeleteFileA(script_path);
-#else
-    unlink(script_path);
-#endif
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr, "[SmittenKitchen] Invalid JSON returned.\n");
-
-        char fallback_url[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://smittenkitchen.com/?s=%s", search_term);
-        char fallback_title[512];
-        snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Smitten Kitchen Website", search_term);
-        add_link(out, fallback_title, "", fallback_url, link_set);
-
-        if (parsed_json) json_object_put(parsed_json);
-        return;
-    }
-
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj, *url_obj;
-
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-            const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
-        }
-    }
-
-    json_object_put(parsed_json);
+static void parse_smittenkitchen(GumboNode *root, GList **out, SearchContext *search, const char *search_term) {
+    html_scrape_links(root, ".post-list article", "h2.entry-title a", "https://smittenkitchen.com", NULL, 1, out, search);
 
     if (*out == NULL) {
+        char *encoded = url_encode(search_term);
         char fallback_url[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://smittenkitchen.com/?s=%s", search_term);
+        snprintf(fallback_url, sizeof(fallback_url), "https://smittenkitchen.com/?s=%s", encoded);
         char fallback_title[512];
-       snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Smitten Kitchen Website", search_term);
-       add_link(out, fallback_title, "", fallback_url, link_set);
-
+        snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Smitten Kitchen Website", search_term);
+        add_fallback_link(out, fallback_title, fallback_url, search);
+        g_free(encoded);
     }
 }
 
@@ -6743,7 +12499,7 @@ static const char *spruce_js_code =
 
 // --------------------------------
 
-static void parse_spruceeats(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
+static void parse_spruceeats(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
     (void)unused;
 
     printf("Starting parse_spruceeats()\n");
@@ -6751,135 +12507,43 @@ static void parse_spruceeats(GumboNode *unused, GList **out, GHashTable *link_se
     const char *term = (search_term && *search_term) ? search_term : "chicken";
     printf("Search term: %s\n", term);
 
-    char temp_filename[512];
-    FILE *tmp_fp = NULL;
-    char command[1024];
-
-#ifdef _WIN32
-    // Create temporary JS file on Windows
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(sizeof(temp_path), temp_path)) {
-        fprintf(stderr, "[WARN] Failed to get temporary path.\n");
-        return;
-    }
-
-    // JM Note: There is a subtle but important detail of the Windows API.
-    // The third argument (0) below is the uUnique parameter.
-    // When set to 0, Windows automatically generates a unique file name
-    // using the current system time, creates the file, and returns its path.
-    // The resulting file name will have the "spr" prefix, the system time, and 
-    // then a ".tmp" extension.
-    // The temp file will be deleted later in the code.
-
-    if (!GetTempFileNameA(temp_path, "spr", 0, temp_filename)) {
-        fprintf(stderr, "[WARN] Failed to get temporary file name.\n");
-        return;
-    }
-
-    tmp_fp = fopen(temp_filename, "w");
-    if (!tmp_fp) {
-        perror("[WARN] fopen failed");
-        return;
-    }
-
-#else
-    strcpy(temp_filename, "/tmp/spruceeats_XXXXXX.js");
-    int fd = mkstemps(temp_filename, 3);
-    if (fd == -1) {
-        perror("[WARN] mkstemps failed");
-        return;
-    }
-    tmp_fp = fdopen(fd, "w");
-    if (!tmp_fp) {
-        perror("[WARN] fdopen failed");
-        close(fd);
-        unlink(temp_filename);
-        return;
-    }
-#endif
-
-    if (!spruce_js_code) {
-        fprintf(stderr, "[WARN] spruce_js_code is NULL\n");
-#ifdef _WIN32
-        fclose(tmp_fp);
-#else
-        fclose(tmp_fp);
-        unlink(temp_filename);
-#endif
-        return;
-    }
-
-    printf("Writing temporary JS script file: %s\n", temp_filename);
-    if (fputs(spruce_js_code, tmp_fp) < 0) {
-        perror("[WARN] Failed to write JS script to temporary file");
-#ifdef _WIN32
-        fclose(tmp_fp);
-#else
-        fclose(tmp_fp);
-        unlink(temp_filename);
-#endif
-        return;
-    }
-
-    fclose(tmp_fp);
-
-#ifdef _WIN32
-    snprintf(command, sizeof(command),
-             "node \"%s\" \"%s\"",
-             temp_filename, term);
-#else
-    snprintf(command, sizeof(command),
-             "NODE_PATH=\"/usr/local/lib/node_modules\" node \"%s\" \"%s\"",
-             temp_filename, term);
-#endif
-
-    printf("Running command: %s\n", command);
-
     char fallback[1024];
     snprintf(fallback, sizeof(fallback),
              "https://www.thespruceeats.com/search?q=%s", term);
     char link_text[256];
     snprintf(link_text, sizeof(link_text),
              "Click to see %s recipes on The Spruce Eats website", term);
-    add_link(out, link_text, "", fallback, link_set);
+    add_fallback_link(out, link_text, fallback, search);
     printf("Added fallback recipe link preemptively\n");
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
-        fprintf(stderr, "[WARN] Unable to run Node script via popen().\n");
-#ifdef _WIN32
-        unlink(temp_filename);
-#endif
+    // Run the embedded script in the persistent scraper worker
+    printf("Running JS script in scraper worker...\n");
+    int status = 0;
+    char *output = run_site_script(search, "spruceeats", spruce_js_code, term, &status);
+    if (!output) {
+        fprintf(stderr, "[WARN] Unable to run Node script in the scraper worker.\n");
         return;
     }
 
-    printf("Reading output from JS script...\n");
-    char buffer[8192];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, fp);
-    buffer[len] = '\0';
-
-    int status = pclose(fp);
-#ifdef _WIN32
-    unlink(temp_filename);
-#else
-    unlink(temp_filename);
-#endif
-
     if (status != 0) {
         printf("spruceeats Node script exited with status %d\n", status);
         printf("Defaulting to fallback recipe link.\n");
+        g_free(output);
         return;
     }
 
+    size_t len = strlen(output);
     printf("Bytes read: %zu\n", len);
     if (len == 0) {
         printf("[WARN] No data received from JS output.\n");
+        g_free(output);
         return;
     }
 
-    printf("Raw JS output:\n%s\n", buffer);
+    printf("Raw JS output:\n%s\n", output);
 
-    struct json_object *parsed_json = json_tokener_parse(buffer);
+    struct json_object *parsed_json = json_tokener_parse(output);
+    g_free(output);
     if (!parsed_json) {
         printf("[WARN] Could not parse JSON output.\n");
         return;
@@ -6909,7 +12573,7 @@ static void parse_spruceeats(GumboNode *unused, GList **out, GHashTable *link_se
             const char *title = json_object_get_string(title_obj);
             const char *url = json_object_get_string(url_obj);
             printf("Adding link: title=\"%s\", url=\"%s\"\n", title, url);
-            add_link(out, title, "", url, link_set);
+            add_link(out, title, "", url, search);
         } else {
             printf("[WARN] Missing title or url in item at index %zu\n", i);
         }
@@ -6925,155 +12589,21 @@ static void parse_spruceeats(GumboNode *unused, GList **out, GHashTable *link_se
 // ===============
 
 
-// Taste of Home JavaScript
-
-const char *tasteofhome_js_code =
-"const axios = require('axios');\n"
-"const cheerio = require('cheerio');\n"
-"\n"
-"async function searchTasteOfHome(term) {\n"
-"  const url = `https://www.tasteofhome.com/?s=${encodeURIComponent(term)}`;\n"
-"  try {\n"
-"    const { data } = await axios.get(url);\n"
-"    const $ = cheerio.load(data);\n"
-"    const results = [];\n"
-"\n"
-"    $('.component-river-item').each((i, elem) => {\n"
-"      const title = $(elem).find('h3 a').text().trim();\n"
-"      const url = $(elem).find('h3 a').attr('href');\n"
-"      if (title && url) {\n"
-"        const fullUrl = url.startsWith('http') ? url : `https://www.tasteofhome.com${url}`;\n"
-"        results.push({ title, url: fullUrl });\n"
-"      }\n"
-"    });\n"
-"\n"
-"    return results;\n"
-"  } catch (e) {\n"
-"    console.error('[TasteOfHome] Search failed:', e.message);\n"
-"    return [];\n"
-"  }\n"
-"}\n"
-"\n"
-"if (require.main === module) {\n"
-"  const term = process.argv[2] || '';\n"
-"  searchTasteOfHome(term).then(results => {\n"
-"    console.log(JSON.stringify(results));\n"
-"  });\n"
-"}\n";
-
-
-// --------------------------------
-
-
 // Taste of Home C function
+// Server-rendered search page, read from the prefetched Gumbo tree with the
+// selectors the old axios + cheerio script used (no Node.js job).
 
-static void parse_tasteofhome(GumboNode *unused, GList **out, GHashTable *link_set, const char *search_term) {
-    (void)unused;
-
-    char script_path[512];
-
-#ifdef _WIN32
-    char temp_path[MAX_PATH];
-    if (!GetTempPathA(MAX_PATH, temp_path)) {
-        fprintf(stderr, "Failed to get Windows temp path.\n");
-        return;
-    }
-    if (!GetTempFileNameA(temp_path, "toh", 0, script_path)) {
-        fprintf(stderr, "Failed to get temp file name for tasteofhome script.\n");
-        return;
-    }
-    FILE *fp = fopen(script_path, "w");
-    if (!fp) {
-        fprintf(stderr, "Failed to create temp JS file for tasteofhome.\n");
-        return;
-    }
-    fputs(tasteofhome_js_code, fp);
-    fclose(fp);
-    char command[1024];
-    snprintf(command, sizeof(command), "cmd /c node \"%s\" \"%s\"", script_path, search_term);
-#else
-    strcpy(script_path, "/tmp/tasteofhome_XXXXXX.js");
-    int fd = mkstemps(script_path, 3);
-    if (fd == -1) {
-        perror("mkstemps (tasteofhome)");
-        return;
-    }
-    FILE *fp = fdopen(fd, "w");
-    if (!fp) {
-        perror("fdopen (tasteofhome)");
-        close(fd);
-        return;
-    }
-    fputs(tasteofhome_js_code, fp);
-    fclose(fp);
-    char command[1024];
-    snprintf(command, sizeof(command), "node \"%s\" \"%s\"", script_path, search_term);
-#endif
-
-    FILE *pipe = popen(command, "r");
-    if (!pipe) {
-        fprintf(stderr, "[TasteOfHome] Failed to run Node.js command.\n");
-
-        char fallback_url[1024];
-        char fallback_title[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://www.tasteofhome.com/?s=%s", search_term);
-        snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Taste of Home Website", search_term);
-        add_link(out, fallback_title, "", fallback_url, link_set);
-
-#ifdef _WIN32
-        DeleteFileA(script_path);
-#else
-        unlink(script_path);
-#endif
-        return;
-    }
-
-    char buffer[32768];
-    size_t len = fread(buffer, 1, sizeof(buffer) - 1, pipe);
-    buffer[len] = '\0';
-    pclose(pipe);
-
-#ifdef _WIN32
-    DeleteFileA(script_path);
-#else
-    unlink(script_path);
-#endif
-
-    struct json_object *parsed_json = json_tokener_parse(buffer);
-    if (!parsed_json || !json_object_is_type(parsed_json, json_type_array)) {
-        fprintf(stderr, "[TasteOfHome] Invalid JSON returned.\n");
-
-        char fallback_url[1024];
-        char fallback_title[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://www.tasteofhome.com/?s=%s", search_term);
-        snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Taste of Home Website", search_term);
-        add_link(out, fallback_title, "", fallback_url, link_set);
-
-        if (parsed_json) json_object_put(parsed_json);
-        return;
-    }
-
-    size_t n = json_object_array_length(parsed_json);
-    for (size_t i = 0; i < n; ++i) {
-        struct json_object *item = json_object_array_get_idx(parsed_json, i);
-        struct json_object *title_obj, *url_obj;
-
-        if (json_object_object_get_ex(item, "title", &title_obj) &&
-            json_object_object_get_ex(item, "url", &url_obj)) {
-            const char *title = json_object_get_string(title_obj);
-            const char *url = json_object_get_string(url_obj);
-            add_link(out, title, "", url, link_set);
-        }
-    }
-
-    json_object_put(parsed_json);
+static void parse_tasteofhome(GumboNode *root, GList **out, SearchContext *search, const char *search_term) {
+    html_scrape_links(root, ".component-river-item", "h3 a", "https://www.tasteofhome.com", NULL, 1, out, search);
 
     if (*out == NULL) {
+        char *encoded = url_encode(search_term);
         char fallback_url[1024];
         char fallback_title[512];
-        snprintf(fallback_url, sizeof(fallback_url), "https://www.tasteofhome.com/?s=%s", search_term);
+        snprintf(fallback_url, sizeof(fallback_url), "https://www.tasteofhome.com/?s=%s", encoded);
         snprintf(fallback_title, sizeof(fallback_title), "Search for \"%s\" on Taste of Home Website", search_term);
-        add_link(out, fallback_title, "", fallback_url, link_set);
+        add_fallback_link(out, fallback_title, fallback_url, search);
+        g_free(encoded);
     }
 }
 
@@ -7087,48 +12617,22 @@ static void parse_tasteofhome(GumboNode *unused, GList **out, GHashTable *link_s
 // YummlyRecipes C function (JavaScript is not needed)
 // Note: This new website has some quirky food blogs.
 
-static void parse_yummlyrecipes(GumboNode *n, GList **out, GHashTable *link_set, const char *search_term) {
-    static bool added_fallback = false;
-
-    // Add a fallback link to the main Yummly Recipes search page once
-    if (!added_fallback) {
-        add_link(out, "Click to see Yummly Recipes Search Page", "", "https://www.yummlyrecipes.com/", link_set);
-        added_fallback = true;
-    }
-
-    if (n->type != GUMBO_NODE_ELEMENT)
-        return;
-
-    if (n->v.element.tag == GUMBO_TAG_A) {
-        GumboAttribute *href = gumbo_get_attribute(&n->v.element.attributes, "href");
-        if (href && strstr(href->value, "/search/label/") && strstr(href->value, "yummlyrecipes.com")) {
-            const char *url = href->value;
-
-            // Extract the slug from the URL (e.g., "CheesyChickenCasserole")
-            const char *slug = strrchr(url, '/');
-            slug = (slug && *(slug + 1)) ? slug + 1 : url;
+static void parse_yummlyrecipes(GumboNode *unused, GList **out, SearchContext *search, const char *search_term) {
+    (void)unused;
 
-            // Prefer anchor text for title, but always convert it properly
-            const char *anchor_text = extract_anchor_text(n);
-            char title[256];
+    // Add a fallback link to the main Yummly Recipes search page
+    add_fallback_link(out, "Click to see Yummly Recipes Search Page", "https://www.yummlyrecipes.com/", search);
 
-            if (anchor_text && *anchor_text) {
-                slug_to_title(anchor_text, title, sizeof(title));
-            } else {
-                slug_to_title(slug, title, sizeof(title));
-            }
+    AnchorParseContext ctx = { out, search, search_term, FALSE };
 
-            // Check if title matches the search term (case-insensitive)
-            if (!search_term || !*search_term || contains_word_case_insensitive(title, search_term)) {
-                add_link(out, title, "", url, link_set);
-            }
-        }
-    }
+    char *encoded = url_encode(search_term ? search_term : "");
+    char url[512];
+    snprintf(url, sizeof(url), "https://www.yummlyrecipes.com/?q=%s", encoded);
+    g_free(encoded);
 
-    // Perform a depth-first search (DFS) through the HTML DOM tree.
-    // Recursively visit all child nodes of the current element.
+    // Every anchor of the page is streamed to yummly_anchor_cb as it arrives.
     // For each <a> tag containing Yummly recipe links, add_link() ensures
-    // uniqueness by checking the link_set (a GHashTable).
+    // uniqueness by checking the search's link_set (canonical URLs).
     //
     // Example nested structure commonly found on recipe blogs:
     // <div class="post-preview">
@@ -7142,17 +12646,36 @@ static void parse_yummlyrecipes(GumboNode *n, GList **out, GHashTable *link_set,
     //     </section>
     //   </article>
     // </div>
+    http_stream_anchors(url, 15L, search, yummly_anchor_cb, &ctx);
+}
 
-    for (unsigned i = 0; 
-         i < n->v.element.children.length;  // Iterate through child nodes
-         ++i)  // Move to next child
-    {
-        parse_yummlyrecipes(
-            (GumboNode *)n->v.element.children.data[i],
-            out,
-            link_set,
-            search_term
-        );
+// YummlyRecipes Helper: Handle one streamed anchor
+static void yummly_anchor_cb(const AnchorLink *link, gpointer user_data) {
+    AnchorParseContext *ctx = user_data;
+    const char *search_term = ctx->search_term;
+
+    if (strstr(link->href, "/search/label/") && strstr(link->href, "yummlyrecipes.com")) {
+        const char *url = link->href;
+
+        // Extract the slug from the URL (e.g., "CheesyChickenCasserole")
+        const char *slug = strrchr(url, '/');
+        slug = (slug && *(slug + 1)) ? slug + 1 : url;
+
+        // Prefer anchor text for title, but always convert it properly
+        const char *anchor_text = link->first_text;
+        char title[256];
+
+        if (anchor_text && *anchor_text) {
+            slug_to_title(anchor_text, title, sizeof(title));
+        } else {
+            slug_to_title(slug, title, sizeof(title));
+        }
+
+        // Check if title matches the search term (case-insensitive)
+        if (!search_term || !*search_term || contains_word_case_insensitive(title, search_term)) {
+            add_link(ctx->out, title, "", url, ctx->search);
+            ctx->found_any = TRUE;
+        }
     }
 }
 